@@ -2,19 +2,144 @@
 
 #include "Blockchain/SignTransaction/TSBC_SignTransaction.h"
 
-// =============================================================================
-// These includes are needed to prevent plugin build failures.
-#include "Async/Async.h"
-// =============================================================================
-
+#include "Blockchain/SignTransaction/TSBC_SigningExecutor.h"
 #include "Crypto/Encryption/TSBC_EcdsaSecp256k1.h"
 #include "Crypto/Hash/TSBC_Keccak256.h"
 #include "Data/TSBC_Types.h"
-#include "Encoding/TSBC_RLP.h"
+#include "Encoding/TSBC_RLPWriter.h"
 #include "Module/TSBC_RuntimeLogCategories.h"
 #include "Module/TSBC_PluginUserSettings.h"
 #include "Util/TSBC_StringUtils.h"
 
+namespace
+{
+    /**
+     * @returns The big-endian number without leading zero bytes.
+     */
+    TArrayView<const uint8> TrimLeadingZeros(const uint8* Bytes, int32 NumBytes)
+    {
+        while(NumBytes > 0 && *Bytes == 0)
+        {
+            Bytes++;
+            NumBytes--;
+        }
+
+        return TArrayView<const uint8>(Bytes, NumBytes);
+    }
+
+    /**
+     * Adds an access list: [[address, [storageKey, ...]], ...]
+     */
+    void AddAccessList(CTSBC_RLPWriter& Writer, const TArray<FTSBC_EthAccessListEntryBinary>& AccessList)
+    {
+        Writer.BeginList();
+        for(const FTSBC_EthAccessListEntryBinary& Entry : AccessList)
+        {
+            Writer.BeginList();
+            Writer.AddBytes(Entry.Address);
+            Writer.BeginList();
+            for(const FTSBC_uint256& StorageKey : Entry.StorageKeys)
+            {
+                // Storage keys are always encoded as 32 byte strings
+                Writer.AddFixedUint256(StorageKey);
+            }
+            Writer.EndList();
+            Writer.EndList();
+        }
+        Writer.EndList();
+    }
+
+    /**
+     * RLP-encodes the transaction, either as message to sign (without signature) or as signed transaction.
+     * Typed transactions (EIP-2718) are prefixed with their type byte.
+     */
+    TArray<uint8> EncodeTransaction(const FTSBC_EthTransactionBinary& InTransaction, const TArray<uint8>* Signature)
+    {
+        const bool bIsLegacy = InTransaction.Type == ETSBC_EthTransactionType::Legacy;
+
+        CTSBC_RLPWriter Writer;
+        Writer.BeginList();
+
+        if(bIsLegacy)
+        {
+            Writer.AddUint256(InTransaction.Nonce);
+            Writer.AddUint256(InTransaction.GasPrice);
+        }
+        else
+        {
+            Writer.AddUint256(InTransaction.ChainId);
+            Writer.AddUint256(InTransaction.Nonce);
+            if(InTransaction.Type == ETSBC_EthTransactionType::DynamicFee)
+            {
+                Writer.AddUint256(InTransaction.MaxPriorityFeePerGas);
+                Writer.AddUint256(InTransaction.MaxFeePerGas);
+            }
+            else
+            {
+                Writer.AddUint256(InTransaction.GasPrice);
+            }
+        }
+
+        Writer.AddUint256(InTransaction.GasLimit);
+        Writer.AddBytes(InTransaction.ToAddress);
+        Writer.AddUint256(InTransaction.Value);
+        Writer.AddBytes(InTransaction.Data);
+
+        if(!bIsLegacy)
+        {
+            AddAccessList(Writer, InTransaction.AccessList);
+        }
+
+        if(Signature)
+        {
+            // Legacy transactions (EIP-155) use V = Y-Parity + Chain ID * 2 + 35, typed transactions the Y-Parity itself
+            const uint64 YParity = (*Signature)[64] & 1;
+            if(bIsLegacy)
+            {
+                Writer.AddUint256(InTransaction.ChainId * 2 + (35 + YParity));
+            }
+            else
+            {
+                Writer.AddUint64(YParity);
+            }
+
+            Writer.AddBytes(TrimLeadingZeros(Signature->GetData(), 32));
+            Writer.AddBytes(TrimLeadingZeros(Signature->GetData() + 32, 32));
+        }
+        else if(bIsLegacy)
+        {
+            // EIP-155: the chain ID followed by two empty values takes the place of the signature
+            Writer.AddUint256(InTransaction.ChainId);
+            Writer.AddBytes(TArrayView<const uint8>());
+            Writer.AddBytes(TArrayView<const uint8>());
+        }
+
+        Writer.EndList();
+
+        TArray<uint8> Result;
+        Result.Reserve((bIsLegacy ? 0 : 1) + Writer.GetEncodedSize());
+        if(!bIsLegacy)
+        {
+            Result.Add(static_cast<uint8>(InTransaction.Type));
+        }
+        Writer.AppendTo(Result);
+
+        return Result;
+    }
+
+    bool IsDebugLoggingSignedTransactionsEnabled()
+    {
+#if UE_EDITOR
+        if(const auto* Settings = UTSBC_PluginUserSettings::Get())
+        {
+            return Settings->bDebugLoggingSignedTransactionsEnabled;
+        }
+#endif
+
+        return false;
+    }
+}
+
 void CTSBC_SignTransaction::SignTransactionAsync(
     FTSBC_SignTransaction_Delegate ResponseDelegate,
     const TArray<uint8> PrivateKey,
@@ -26,9 +151,9 @@ void CTSBC_SignTransaction::SignTransactionAsync(
     const FString Data,
     const int32 ChainId)
 {
-    Async(
-        EAsyncExecution::Thread,
+    CTSBC_SigningExecutor::Get()->Submit(
         [
+            ResponseDelegate,
             PrivateKey,
             Nonce,
             GasPrice,
@@ -37,43 +162,34 @@ void CTSBC_SignTransaction::SignTransactionAsync(
             Value,
             Data,
             ChainId
-        ]() -> FFutureRetval
+        ]() -> CTSBC_SigningExecutor::FCompletion
         {
-            const FString PrivateKeyAsString = TSBC_StringUtils::BytesToHex(PrivateKey, false);
-
-            const FTSBC_EthTransaction Transaction{
-                FString::FromInt(Nonce),
-                GasPrice.ToHexString(),
-                GasLimit.ToHexString(),
-                ToAddress,
-                Value.ToHexString(),
-                Data,
-                FString::FromInt(ChainId),
-            };
-
             FFutureRetval Retval;
-            SignTransactionLowLevelSync(
+            SignTransactionSync(
                 Retval.bSuccess,
                 Retval.ErrorMessage,
                 Retval.SignedTransaction,
                 Retval.MessageHash,
                 Retval.TransactionHash,
-                PrivateKeyAsString,
-                Transaction);
-
-            return Retval;
-        }).Then(
-        [ResponseDelegate](auto RetvalPtr)
-        {
-            const FFutureRetval Retval = RetvalPtr.Get();
-
-            // ReSharper disable once CppExpressionWithoutSideEffects
-            ResponseDelegate.ExecuteIfBound(
-                Retval.bSuccess,
-                Retval.ErrorMessage,
-                Retval.SignedTransaction,
-                Retval.MessageHash,
-                Retval.TransactionHash);
+                PrivateKey,
+                Nonce,
+                GasPrice,
+                GasLimit,
+                ToAddress,
+                Value,
+                Data,
+                ChainId);
+
+            return [ResponseDelegate, Retval]()
+            {
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(
+                    Retval.bSuccess,
+                    Retval.ErrorMessage,
+                    Retval.SignedTransaction,
+                    Retval.MessageHash,
+                    Retval.TransactionHash);
+            };
         });
 }
 
@@ -92,25 +208,24 @@ void CTSBC_SignTransaction::SignTransactionSync(
     const FString Data,
     const int32 ChainId)
 {
-    const FString PrivateKeyAsString = TSBC_StringUtils::BytesToHex(PrivateKey, false);
-
-    const FTSBC_EthTransaction Transaction{
-        FString::FromInt(Nonce),
-        GasPrice.ToHexString(),
-        GasLimit.ToHexString(),
-        ToAddress,
-        Value.ToHexString(),
-        Data,
-        FString::FromInt(ChainId),
-    };
-
-    SignTransactionLowLevelSync(
+    FTSBC_EthTransactionBinary Transaction;
+    if(!MakeTransaction(Nonce, GasPrice, GasLimit, ToAddress, Value, Data, ChainId, Transaction, ErrorMessage))
+    {
+        bSuccess = false;
+        SignedTransaction = "";
+        MessageHash = "";
+        TransactionHash = "";
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return;
+    }
+
+    SignTransactionBinaryToHex(
         bSuccess,
         ErrorMessage,
         SignedTransaction,
         MessageHash,
         TransactionHash,
-        PrivateKeyAsString,
+        PrivateKey,
         Transaction);
 }
 
@@ -119,12 +234,12 @@ void CTSBC_SignTransaction::SignTransactionLowLevelAsync(
     const FString PrivateKey,
     const FTSBC_EthTransaction& Transaction)
 {
-    Async(
-        EAsyncExecution::Thread,
+    CTSBC_SigningExecutor::Get()->Submit(
         [
+            ResponseDelegate,
             PrivateKey,
             Transaction
-        ]() -> FFutureRetval
+        ]() -> CTSBC_SigningExecutor::FCompletion
         {
             FFutureRetval Retval;
             SignTransactionLowLevelSync(
@@ -136,19 +251,16 @@ void CTSBC_SignTransaction::SignTransactionLowLevelAsync(
                 PrivateKey,
                 Transaction);
 
-            return Retval;
-        }).Then(
-        [ResponseDelegate](auto RetvalPtr)
-        {
-            const FFutureRetval Retval = RetvalPtr.Get();
-
-            // ReSharper disable once CppExpressionWithoutSideEffects
-            ResponseDelegate.ExecuteIfBound(
-                Retval.bSuccess,
-                Retval.ErrorMessage,
-                Retval.SignedTransaction,
-                Retval.MessageHash,
-                Retval.TransactionHash);
+            return [ResponseDelegate, Retval]()
+            {
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(
+                    Retval.bSuccess,
+                    Retval.ErrorMessage,
+                    Retval.SignedTransaction,
+                    Retval.MessageHash,
+                    Retval.TransactionHash);
+            };
         });
 }
 
@@ -161,14 +273,6 @@ void CTSBC_SignTransaction::SignTransactionLowLevelSync(
     const FString PrivateKey,
     const FTSBC_EthTransaction& Transaction)
 {
-    bool bDebugLoggingSignedTransactionsEnabled = false;
-#if UE_EDITOR
-    if(const auto* Settings = UTSBC_PluginUserSettings::Get())
-    {
-        bDebugLoggingSignedTransactionsEnabled = Settings->bDebugLoggingSignedTransactionsEnabled;
-    }
-#endif
-
     bSuccess = false;
     ErrorMessage = "";
 
@@ -181,6 +285,44 @@ void CTSBC_SignTransaction::SignTransactionLowLevelSync(
         return;
     }
 
+    // Parse transaction data given in decimal or hex notation
+    FTSBC_EthTransactionBinary TransactionBinary;
+    if(!ParseTransaction(Transaction, TransactionBinary, ErrorMessage))
+    {
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return;
+    }
+
+    SignTransactionBinaryToHex(
+        bSuccess,
+        ErrorMessage,
+        SignedTransaction,
+        MessageHash,
+        TransactionHash,
+        PrivateKeyAsBytes,
+        TransactionBinary);
+}
+
+bool CTSBC_SignTransaction::SignTransactionBinarySync(
+    const TArray<uint8>& PrivateKey,
+    const FTSBC_EthTransactionBinary& Transaction,
+    TArray<uint8>& OutSignedTransaction,
+    TArray<uint8>& OutMessageHash,
+    TArray<uint8>& OutTransactionHash,
+    FString& OutErrorMessage)
+{
+    const bool bDebugLoggingSignedTransactionsEnabled = IsDebugLoggingSignedTransactionsEnabled();
+
+    OutErrorMessage = "";
+
+    // Validate private key to be used for signing
+    if(PrivateKey.Num() != 32)
+    {
+        OutErrorMessage = "Private Key must be 32 bytes long";
+        TSBC_LOG(Error, TEXT("%s"), *OutErrorMessage);
+        return false;
+    }
+
     // NOTE: Uncomment this code block if you want to also debug log the private key used when signing transactions.
     // NOTE: However, be aware that this MAY LEAD TO ACCIDENTAL DISCLOSURE OF YOUR PRIVATE KEY if not handled carefully!
     // #ifdef UE_EDITOR
@@ -188,260 +330,298 @@ void CTSBC_SignTransaction::SignTransactionLowLevelSync(
     //         bDebugLoggingSignedTransactionsEnabled,
     //         Warning,
     //         TEXT("Private Key used for signing Hex: %s"),
-    //         *TSBC_StringUtils::BytesToHex(PrivateKeyAsBytes));
+    //         *TSBC_StringUtils::BytesToHex(PrivateKey));
     // #endif
 
-    // Normalize transaction data (all data in hex notation)
-    FTSBC_EthTransaction TransactionNormalized;
-    if(!NormalizeTransactionData(Transaction, TransactionNormalized, ErrorMessage))
+    if(Transaction.ToAddress.Num() != 0 && Transaction.ToAddress.Num() != 20)
     {
-        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
-        return;
+        OutErrorMessage = "ToAddress must be empty or 20 bytes long";
+        TSBC_LOG(Error, TEXT("%s"), *OutErrorMessage);
+        return false;
+    }
+
+    if(Transaction.Type >= ETSBC_EthTransactionType::MAX)
+    {
+        OutErrorMessage = "Unsupported transaction type";
+        TSBC_LOG(Error, TEXT("%s"), *OutErrorMessage);
+        return false;
     }
 
-    // RLP-encode transaction parameters.
-    const TArray<FString> TransactionParams = BuildMessageTransactionParams(TransactionNormalized);
-    const TArray<uint8> RlpEncodedTransactionParamsAsBytes = UTSBC_RLP::Encode(TransactionParams);
-    const FString MessageAsHex = TSBC_StringUtils::BytesToHex(RlpEncodedTransactionParamsAsBytes);
+    for(const FTSBC_EthAccessListEntryBinary& Entry : Transaction.AccessList)
+    {
+        if(Entry.Address.Num() != 20)
+        {
+            OutErrorMessage = "Access list addresses must be 20 bytes long";
+            TSBC_LOG(Error, TEXT("%s"), *OutErrorMessage);
+            return false;
+        }
+    }
+
+    // RLP-encode transaction parameters
+    const TArray<uint8> Message = EncodeMessage(Transaction);
     TSBC_LOG_COND(
         bDebugLoggingSignedTransactionsEnabled,
         Warning,
         TEXT("Message = RLP(Message Transaction Params): %s"),
-        *MessageAsHex);
+        *TSBC_StringUtils::BytesToHex(Message));
 
     // Hash message using Keccak-256
     CTSBC_Keccak256 Hasher = CTSBC_Keccak256();
-    const TArray<uint8> MessageAsBytes = TSBC_StringUtils::HexToBytes(MessageAsHex);
-    MessageHash = Hasher.KeccakFromBytes(MessageAsBytes);
+    OutMessageHash.SetNumUninitialized(32);
+    Hasher.HashToBytes(Message, OutMessageHash.GetData());
     TSBC_LOG_COND(
         bDebugLoggingSignedTransactionsEnabled,
         Warning,
         TEXT("Message Hash = KEC(Message): %s"),
-        *MessageHash);
+        *TSBC_StringUtils::BytesToHex(OutMessageHash, false));
 
     // Sign Message Hash
     TSBC_LOG_COND(
         bDebugLoggingSignedTransactionsEnabled,
         Warning,
         TEXT("Signature = SECP256k1.Sign(Private Key, Message Hash) [Non-Deterministic]"));
-    const TArray<uint8> HashAsBytes = TSBC_StringUtils::HexToBytes(MessageHash);
     TArray<uint8> Signature;
     const bool bSignatureCalculated = CTSBC_EcdsaSecp256k1::Secp256k1_CreateSignature(
-        PrivateKeyAsBytes,
-        HashAsBytes,
+        PrivateKey,
+        OutMessageHash,
         Signature);
-    if(!bSignatureCalculated)
+    if(!bSignatureCalculated || Signature.Num() != 65)
     {
-        ErrorMessage = "Failed to calculate signature";
-        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
-        return;
+        OutErrorMessage = "Failed to calculate signature";
+        TSBC_LOG(Error, TEXT("%s"), *OutErrorMessage);
+        return false;
     }
 
     // RLP-encode signed transaction parameters. This can be sent as "params" using the "eth_sendRawTransaction" method.
-    TArray<FString> SignedTransactionParams;
-    if(!BuildSignedTransactionParams(
-        TransactionNormalized,
-        Signature,
-        SignedTransactionParams,
-        ErrorMessage))
-    {
-        return;
-    }
-
-    const TArray<uint8> SignedTransactionAsBytes = UTSBC_RLP::Encode(SignedTransactionParams);
-    SignedTransaction = TSBC_StringUtils::BytesToHex(SignedTransactionAsBytes);
+    OutSignedTransaction = EncodeSignedTransaction(Transaction, Signature);
     TSBC_LOG_COND(
         bDebugLoggingSignedTransactionsEnabled,
         Warning,
         TEXT("Signed Transaction = RLP(Signed Transaction Params): %s\n\n"),
-        *SignedTransaction);
+        *TSBC_StringUtils::BytesToHex(OutSignedTransaction));
 
-    TransactionHash = Hasher.KeccakFromBytes(SignedTransactionAsBytes);
+    OutTransactionHash.SetNumUninitialized(32);
+    Hasher.HashToBytes(OutSignedTransaction, OutTransactionHash.GetData());
     TSBC_LOG_COND(
         bDebugLoggingSignedTransactionsEnabled,
         Warning,
         TEXT("\n\nTransaction Hash = KEC(Signed Transaction): %s\n\n"),
-        *TransactionHash);
+        *TSBC_StringUtils::BytesToHex(OutTransactionHash, false));
 
-    bSuccess = true;
+    return true;
 }
 
-bool CTSBC_SignTransaction::NormalizeTransactionData(
+bool CTSBC_SignTransaction::ParseTransaction(
     const FTSBC_EthTransaction& InTransaction,
-    FTSBC_EthTransaction& OutTransactionNormalized,
+    FTSBC_EthTransactionBinary& OutTransaction,
     FString& OutErrorMessage)
 {
-    FString NonceAsString = InTransaction.Nonce.TrimStartAndEnd();
-    NonceAsString = NonceAsString.IsEmpty() || NonceAsString == "0"
-                    ? "0x"
-                    : InTransaction.Nonce;
-    FTSBC_uint256 Nonce;
-    if(!Nonce.ParseFromString(NonceAsString))
+    const FString NonceAsString = InTransaction.Nonce.TrimStartAndEnd();
+    if(NonceAsString.IsEmpty() || NonceAsString == "0")
+    {
+        OutTransaction.Nonce = 0;
+    }
+    else if(!OutTransaction.Nonce.ParseFromString(InTransaction.Nonce))
     {
         OutErrorMessage = "Could not parse Nonce as uint256";
         return false;
     }
 
-    FTSBC_uint256 GasPrice;
-    if(!GasPrice.ParseFromString(InTransaction.GasPrice))
+    OutTransaction.Type = InTransaction.Type;
+    if(OutTransaction.Type == ETSBC_EthTransactionType::DynamicFee)
+    {
+        if(!OutTransaction.MaxPriorityFeePerGas.ParseFromString(InTransaction.MaxPriorityFeePerGas))
+        {
+            OutErrorMessage = "Could not parse MaxPriorityFeePerGas as uint256";
+            return false;
+        }
+
+        if(!OutTransaction.MaxFeePerGas.ParseFromString(InTransaction.MaxFeePerGas))
+        {
+            OutErrorMessage = "Could not parse MaxFeePerGas as uint256";
+            return false;
+        }
+    }
+    else if(!OutTransaction.GasPrice.ParseFromString(InTransaction.GasPrice))
     {
         OutErrorMessage = "Could not parse GasPrice as uint256";
         return false;
     }
 
-    FTSBC_uint256 GasLimit;
-    if(!GasLimit.ParseFromString(InTransaction.GasLimit.IsEmpty() ? InTransaction.GasPrice : InTransaction.GasLimit))
+    if(!OutTransaction.GasLimit.ParseFromString(
+        InTransaction.GasLimit.IsEmpty() ? InTransaction.GasPrice : InTransaction.GasLimit))
     {
         OutErrorMessage = "Could not parse GasLimit as uint256";
         return false;
     }
 
-    FString ToAddress;
-    if(!InTransaction.ToAddress.IsEmpty())
+    const FString ToAddressAsString = InTransaction.ToAddress.TrimStartAndEnd();
+    OutTransaction.ToAddress = TSBC_StringUtils::HexToBytes(ToAddressAsString);
+    if((OutTransaction.ToAddress.Num() != 0 && OutTransaction.ToAddress.Num() != 20)
+        || (OutTransaction.ToAddress.Num() == 0 && !ToAddressAsString.IsEmpty()))
     {
-        ToAddress = InTransaction.ToAddress.StartsWith("0x") ? InTransaction.ToAddress : "0x" + InTransaction.ToAddress;
+        OutErrorMessage = "Could not parse ToAddress as 20 byte hex value";
+        return false;
     }
 
-    FString Data;
-    if(!InTransaction.Data.IsEmpty())
+    const FString DataAsString = InTransaction.Data.TrimStartAndEnd();
+    OutTransaction.Data = TSBC_StringUtils::HexToBytes(DataAsString);
+    if(OutTransaction.Data.Num() == 0 && !DataAsString.IsEmpty() && DataAsString != "0x")
     {
-        Data = InTransaction.Data.StartsWith("0x") ? InTransaction.Data : "0x" + InTransaction.Data;
+        OutErrorMessage = "Could not parse Data as hex value";
+        return false;
     }
 
-    FTSBC_uint256 Value;
-    if(!Value.ParseFromString(InTransaction.Value))
+    if(!OutTransaction.Value.ParseFromString(InTransaction.Value))
     {
         OutErrorMessage = "Could not parse Value as uint256";
         return false;
     }
-    FTSBC_uint256 ChainId;
-    if(!ChainId.ParseFromString(InTransaction.ChainId))
+
+    if(!OutTransaction.ChainId.ParseFromString(InTransaction.ChainId))
     {
         OutErrorMessage = "Could not parse ChainId as uint256";
         return false;
     }
 
-    OutTransactionNormalized = FTSBC_EthTransaction{
-        Nonce == 0 ? "" : Nonce.ToHexString(),
-        GasPrice.ToHexString(),
-        GasLimit.ToHexString(),
-        ToAddress,
-        Value == 0 ? "" : Value.ToHexString(),
-        Data,
-        ChainId.ToHexString(),
-    };
+    OutTransaction.AccessList.Reset();
+    if(OutTransaction.Type != ETSBC_EthTransactionType::Legacy)
+    {
+        for(const FTSBC_EthAccessListEntry& Entry : InTransaction.AccessList)
+        {
+            FTSBC_EthAccessListEntryBinary& EntryBinary = OutTransaction.AccessList.AddDefaulted_GetRef();
+            EntryBinary.Address = TSBC_StringUtils::HexToBytes(Entry.Address);
+            if(EntryBinary.Address.Num() != 20)
+            {
+                OutErrorMessage = "Could not parse access list address as 20 byte hex value";
+                return false;
+            }
+
+            for(const FString& StorageKey : Entry.StorageKeys)
+            {
+                const TArray<uint8> StorageKeyAsBytes = TSBC_StringUtils::HexToBytes(StorageKey);
+                if(StorageKeyAsBytes.Num() != FTSBC_uint256::NUM_BYTES
+                    || !FTSBC_uint256::ParseFromBytes(
+                        StorageKeyAsBytes.GetData(),
+                        StorageKeyAsBytes.Num(),
+                        EntryBinary.StorageKeys.AddDefaulted_GetRef()))
+                {
+                    OutErrorMessage = "Could not parse access list storage key as 32 byte hex value";
+                    return false;
+                }
+            }
+        }
+    }
 
     return true;
 }
 
-TArray<FString> CTSBC_SignTransaction::BuildMessageTransactionParams(const FTSBC_EthTransaction& InTransaction)
+void CTSBC_SignTransaction::SignTransactionBinaryToHex(
+    bool& bSuccess,
+    FString& ErrorMessage,
+    FString& SignedTransaction,
+    FString& MessageHash,
+    FString& TransactionHash,
+    const TArray<uint8>& PrivateKey,
+    const FTSBC_EthTransactionBinary& Transaction)
 {
-    const TArray<FString> TransactionParams = {
-        InTransaction.Nonce,
-        InTransaction.GasPrice,
-        InTransaction.GasLimit,
-        InTransaction.ToAddress,
-        InTransaction.Value,
-        InTransaction.Data,
-        InTransaction.ChainId,
-        "",
-        "",
-    };
-
-    bool bDebugLoggingSignedTransactionsEnabled = false;
-#if UE_EDITOR
-    if(const auto* Settings = UTSBC_PluginUserSettings::Get())
+    TArray<uint8> SignedTransactionAsBytes;
+    TArray<uint8> MessageHashAsBytes;
+    TArray<uint8> TransactionHashAsBytes;
+    bSuccess = SignTransactionBinarySync(
+        PrivateKey,
+        Transaction,
+        SignedTransactionAsBytes,
+        MessageHashAsBytes,
+        TransactionHashAsBytes,
+        ErrorMessage);
+
+    if(!bSuccess)
     {
-        bDebugLoggingSignedTransactionsEnabled = Settings->bDebugLoggingSignedTransactionsEnabled;
+        SignedTransaction = "";
+        MessageHash = "";
+        TransactionHash = "";
+        return;
     }
-#endif
 
-    TSBC_LOG_COND(
-        bDebugLoggingSignedTransactionsEnabled,
-        Warning,
-        TEXT(
-            "Message Transaction Params: Nonce<%s> GasPrice<%s> GasLimit<%s> ToAddress<%s> Value<%s> Data<%s> ChainId<%s>"
-        ),
-        *InTransaction.Nonce,
-        *InTransaction.GasPrice,
-        *InTransaction.GasLimit,
-        *InTransaction.ToAddress,
-        *InTransaction.Value,
-        *InTransaction.Data,
-        *InTransaction.ChainId);
-
-    return TransactionParams;
+    // Hashes keep the format of the Keccak-256 hex output, i.e. without "0x" prefix
+    SignedTransaction = TSBC_StringUtils::BytesToHex(SignedTransactionAsBytes);
+    MessageHash = TSBC_StringUtils::BytesToHex(MessageHashAsBytes, false);
+    TransactionHash = TSBC_StringUtils::BytesToHex(TransactionHashAsBytes, false);
 }
 
-bool CTSBC_SignTransaction::BuildSignedTransactionParams(
-    const FTSBC_EthTransaction& InTransaction,
-    const TArray<uint8> Signature,
-    TArray<FString>& OutTransactionParams,
+bool CTSBC_SignTransaction::MakeTransaction(
+    const int32 Nonce,
+    const FTSBC_uint256& GasPrice,
+    const FTSBC_uint256& GasLimit,
+    const FString& ToAddress,
+    const FTSBC_uint256& Value,
+    const FString& Data,
+    const int32 ChainId,
+    FTSBC_EthTransactionBinary& OutTransaction,
     FString& OutErrorMessage)
 {
-    const int32 ChainId = TSBC_StringUtils::HexStringToInt32(InTransaction.ChainId);
-    if(ChainId == -1)
-    {
-        OutErrorMessage = "Invalid Chain ID in transaction parameters.";
-        return false;
-    }
+    OutErrorMessage = "";
 
-    FTSBC_uint256 V;
-    if(!V.ParseFromString(CTSBC_EcdsaSecp256k1::GetFromSignatureValueV(Signature, ChainId)))
+    // Casting a negative value to uint64 would sign-extend it into a huge nonce or chain ID
+    if(Nonce < 0)
     {
-        OutErrorMessage = "Could not parse V as uint256";
+        OutErrorMessage = FString::Printf(TEXT("Nonce must not be negative, got %d"), Nonce);
         return false;
     }
 
-    FTSBC_uint256 R;
-    if(!R.ParseFromString(CTSBC_EcdsaSecp256k1::GetFromSignatureValueR(Signature)))
+    if(ChainId <= 0)
     {
-        OutErrorMessage = "Could not parse R as uint256";
+        OutErrorMessage = FString::Printf(TEXT("Chain ID must be positive, got %d"), ChainId);
         return false;
     }
 
-    FTSBC_uint256 S;
-    if(!S.ParseFromString(CTSBC_EcdsaSecp256k1::GetFromSignatureValueS(Signature)))
-    {
-        OutErrorMessage = "Could not parse S as uint256";
-        return false;
-    }
+    OutTransaction = FTSBC_EthTransactionBinary();
+    OutTransaction.Nonce = static_cast<uint64>(Nonce);
+    OutTransaction.GasPrice = GasPrice;
+    OutTransaction.GasLimit = GasLimit;
+    OutTransaction.ToAddress = TSBC_StringUtils::HexToBytes(ToAddress);
+    OutTransaction.Value = Value;
+    OutTransaction.Data = TSBC_StringUtils::HexToBytes(Data);
+    OutTransaction.ChainId = static_cast<uint64>(ChainId);
 
-    OutTransactionParams = TArray<FString>{
-        InTransaction.Nonce,
-        InTransaction.GasPrice,
-        InTransaction.GasLimit,
-        InTransaction.ToAddress,
-        InTransaction.Value,
-        InTransaction.Data,
-        V.ToHexString(),
-        R.ToHexString(),
-        S.ToHexString(),
-    };
-
-    bool bDebugLoggingSignedTransactionsEnabled = false;
-#if UE_EDITOR
-    if(const auto* Settings = UTSBC_PluginUserSettings::Get())
-    {
-        bDebugLoggingSignedTransactionsEnabled = Settings->bDebugLoggingSignedTransactionsEnabled;
-    }
-#endif
+    return true;
+}
 
+TArray<uint8> CTSBC_SignTransaction::EncodeMessage(const FTSBC_EthTransactionBinary& InTransaction)
+{
     TSBC_LOG_COND(
-        bDebugLoggingSignedTransactionsEnabled,
+        IsDebugLoggingSignedTransactionsEnabled(),
         Warning,
         TEXT(
-            "Signed Transaction Params: Nonce<%s> GasPrice<%s> GasLimit<%s> ToAddress<%s> Value<%s> Data<%s> Sig.V<%s> Sig.R<%s> Sig.S<%s>"
+            "Message Transaction Params: Type<%d> Nonce<%s> GasPrice<%s> MaxPriorityFeePerGas<%s> MaxFeePerGas<%s> GasLimit<%s> ToAddress<%s> Value<%s> Data<%s> ChainId<%s> AccessList<%d entries>"
         ),
-        *OutTransactionParams[0],
-        *OutTransactionParams[1],
-        *OutTransactionParams[2],
-        *OutTransactionParams[3],
-        *OutTransactionParams[4],
-        *OutTransactionParams[5],
-        *OutTransactionParams[6],
-        *OutTransactionParams[7],
-        *OutTransactionParams[8]);
+        static_cast<int32>(InTransaction.Type),
+        *InTransaction.Nonce.ToHexString(),
+        *InTransaction.GasPrice.ToHexString(),
+        *InTransaction.MaxPriorityFeePerGas.ToHexString(),
+        *InTransaction.MaxFeePerGas.ToHexString(),
+        *InTransaction.GasLimit.ToHexString(),
+        *TSBC_StringUtils::BytesToHex(InTransaction.ToAddress),
+        *InTransaction.Value.ToHexString(),
+        *TSBC_StringUtils::BytesToHex(InTransaction.Data),
+        *InTransaction.ChainId.ToHexString(),
+        InTransaction.AccessList.Num());
+
+    return EncodeTransaction(InTransaction, nullptr);
+}
 
-    return true;
+TArray<uint8> CTSBC_SignTransaction::EncodeSignedTransaction(
+    const FTSBC_EthTransactionBinary& InTransaction,
+    const TArray<uint8>& Signature)
+{
+    TSBC_LOG_COND(
+        IsDebugLoggingSignedTransactionsEnabled(),
+        Warning,
+        TEXT("Signed Transaction Params: Sig.YParity<%d> Sig.R<%s> Sig.S<%s>"),
+        Signature[64] & 1,
+        *CTSBC_EcdsaSecp256k1::GetFromSignatureValueR(Signature),
+        *CTSBC_EcdsaSecp256k1::GetFromSignatureValueS(Signature));
+
+    return EncodeTransaction(InTransaction, &Signature);
 }
\ No newline at end of file
@@ -0,0 +1,278 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "Blockchain/SignTransaction/TSBC_SigningExecutor.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "Async/Async.h"
+#include "HAL/RunnableThread.h"
+// =============================================================================
+
+#include "Module/TSBC_PluginUserSettings.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
+
+TSharedPtr<CTSBC_SigningExecutor, ESPMode::ThreadSafe> CTSBC_SigningExecutor::Instance;
+FCriticalSection CTSBC_SigningExecutor::InstanceLock;
+
+CTSBC_SigningExecutor::FWorker::FWorker(CTSBC_SigningExecutor& InOwner)
+    : Owner(InOwner)
+{
+}
+
+uint32 CTSBC_SigningExecutor::FWorker::Run()
+{
+    while(true)
+    {
+        // Read before dequeuing, since every job is enqueued before bStopping is set, so the queue is drained before
+        // a stopping worker exits
+        const bool bStopping = Owner.bStopping;
+
+        FJob Job;
+        if(Owner.TryDequeue(Job))
+        {
+            Owner.Execute(Job);
+            continue;
+        }
+
+        if(bStopping)
+        {
+            break;
+        }
+
+        Owner.WorkAvailableEvent->Wait();
+    }
+
+    // Pass the stop signal on to the next sleeping worker
+    Owner.WorkAvailableEvent->Trigger();
+
+    return 0;
+}
+
+TSharedRef<CTSBC_SigningExecutor, ESPMode::ThreadSafe> CTSBC_SigningExecutor::Get()
+{
+    FScopeLock Lock(&InstanceLock);
+
+    // A stopped executor stays in place, so jobs submitted during module shutdown do not start new workers
+    if(!Instance.IsValid())
+    {
+        const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+        Instance = MakeShared<CTSBC_SigningExecutor, ESPMode::ThreadSafe>(
+            Settings ? Settings->SigningWorkerCount : 0);
+    }
+
+    return Instance.ToSharedRef();
+}
+
+void CTSBC_SigningExecutor::Shutdown()
+{
+    FScopeLock Lock(&InstanceLock);
+
+    if(Instance.IsValid())
+    {
+        Instance->StopWorkers();
+    }
+    else
+    {
+        Instance = MakeShared<CTSBC_SigningExecutor, ESPMode::ThreadSafe>(0, true);
+    }
+}
+
+CTSBC_SigningExecutor::CTSBC_SigningExecutor(int32 NumWorkers, const bool bStopped)
+    : WorkAvailableEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    , NumStartedWorkers(0)
+    , bStopping(bStopped)
+    , bDrainScheduled(false)
+    , QueueDepth(0)
+    , NumActive(0)
+    , NumPendingCompletions(0)
+    , NumSubmitted(0)
+    , NumExecuted(0)
+    , TotalQueueCycles(0)
+    , TotalLatencyCycles(0)
+    , MaxLatencyCycles(0)
+{
+    if(NumWorkers < 1)
+    {
+        NumWorkers = FMath::Max(1, FPlatformMisc::NumberOfCores() - 1);
+    }
+
+    if(bStopped || !FPlatformProcess::SupportsMultithreading())
+    {
+        return;
+    }
+
+    for(int32 i = 0; i < NumWorkers; i++)
+    {
+        TUniquePtr<FWorker> Worker = MakeUnique<FWorker>(*this);
+        FRunnableThread* Thread = FRunnableThread::Create(
+            Worker.Get(),
+            *FString::Printf(TEXT("TSBC_SigningWorker_%d"), i),
+            0,
+            TPri_Normal);
+
+        if(Thread)
+        {
+            Workers.Add(MoveTemp(Worker));
+            Threads.Add(Thread);
+        }
+    }
+
+    NumStartedWorkers = Threads.Num();
+}
+
+CTSBC_SigningExecutor::~CTSBC_SigningExecutor()
+{
+    StopWorkers();
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkAvailableEvent);
+    WorkAvailableEvent = nullptr;
+}
+
+void CTSBC_SigningExecutor::Submit(FWork&& Work)
+{
+    FJob Job;
+    Job.Work = MoveTemp(Work);
+    Job.SubmitCycles = FPlatformTime::Cycles64();
+
+    {
+        FScopeLock Lock(&SubmitLock);
+
+        if(bStopping)
+        {
+            TSBC_LOG(Warning, TEXT("Signing executor is stopped, the job is discarded"));
+            return;
+        }
+
+        ++NumSubmitted;
+
+        if(NumStartedWorkers > 0)
+        {
+            ++QueueDepth;
+            Jobs.Enqueue(MoveTemp(Job));
+            WorkAvailableEvent->Trigger();
+            return;
+        }
+    }
+
+    // Without workers, e.g. on platforms without threading support, the job runs inline
+    ++NumActive;
+    Execute(Job);
+}
+
+FTSBC_SigningExecutorStats CTSBC_SigningExecutor::GetStats() const
+{
+    FTSBC_SigningExecutorStats Stats;
+    Stats.NumWorkers = bStopping ? 0 : NumStartedWorkers;
+    Stats.QueueDepth = QueueDepth;
+    Stats.NumActive = NumActive;
+    Stats.NumPendingCompletions = NumPendingCompletions;
+    Stats.NumSubmitted = NumSubmitted;
+    Stats.NumExecuted = NumExecuted;
+
+    if(Stats.NumExecuted > 0)
+    {
+        Stats.AverageQueueLatency = FPlatformTime::ToSeconds64(TotalQueueCycles) / Stats.NumExecuted;
+        Stats.AverageLatency = FPlatformTime::ToSeconds64(TotalLatencyCycles) / Stats.NumExecuted;
+        Stats.MaxLatency = FPlatformTime::ToSeconds64(MaxLatencyCycles);
+    }
+
+    return Stats;
+}
+
+void CTSBC_SigningExecutor::StopWorkers()
+{
+    {
+        FScopeLock Lock(&SubmitLock);
+
+        if(bStopping.exchange(true))
+        {
+            return;
+        }
+    }
+
+    WorkAvailableEvent->Trigger();
+
+    for(FRunnableThread* Thread : Threads)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+    }
+
+    Threads.Empty();
+    Workers.Empty();
+}
+
+bool CTSBC_SigningExecutor::TryDequeue(FJob& OutJob)
+{
+    FScopeLock Lock(&DequeueLock);
+
+    if(!Jobs.Dequeue(OutJob))
+    {
+        return false;
+    }
+
+    --QueueDepth;
+    ++NumActive;
+
+    // Auto-reset triggers that arrived together collapse into one wake-up, so hand the remainder to another worker
+    if(!Jobs.IsEmpty())
+    {
+        WorkAvailableEvent->Trigger();
+    }
+
+    return true;
+}
+
+void CTSBC_SigningExecutor::Execute(FJob& Job)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    TotalQueueCycles += StartCycles - Job.SubmitCycles;
+
+    FCompletion Completion = Job.Work();
+
+    const uint64 LatencyCycles = FPlatformTime::Cycles64() - Job.SubmitCycles;
+    TotalLatencyCycles += LatencyCycles;
+
+    uint64 PreviousMax = MaxLatencyCycles;
+    while(LatencyCycles > PreviousMax && !MaxLatencyCycles.compare_exchange_weak(PreviousMax, LatencyCycles))
+    {
+    }
+
+    ++NumExecuted;
+    --NumActive;
+
+    if(!Completion)
+    {
+        return;
+    }
+
+    ++NumPendingCompletions;
+    Completions.Enqueue(MoveTemp(Completion));
+
+    // One game thread task runs every completion queued until it executes
+    if(!bDrainScheduled.exchange(true))
+    {
+        AsyncTask(
+            ENamedThreads::GameThread,
+            [Self = AsShared()]()
+            {
+                Self->DrainCompletions();
+            });
+    }
+}
+
+void CTSBC_SigningExecutor::DrainCompletions()
+{
+    check(IsInGameThread());
+
+    // Cleared first so that completions queued while draining schedule another task
+    bDrainScheduled = false;
+
+    // Run even while stopping, since the jobs were accepted and drained by the workers before they exited
+    FCompletion Completion;
+    while(Completions.Dequeue(Completion))
+    {
+        --NumPendingCompletions;
+        Completion();
+    }
+}
\ No newline at end of file
@@ -6,8 +6,9 @@
 #include "Crypto/Hash/TSBC_Keccak256.h"
 #include "Crypto/Encryption/TSBC_EcdsaSecp256k1.h"
 #include "JsonRpc/Eth/TSBC_EthGetBalance.h"
+#include "JsonRpc/Generic/TSBC_JsonRpcCache.h"
+#include "JsonRpc/Generic/TSBC_RpcEndpointPool.h"
 #include "Util/TSBC_StringUtils.h"
-#include "Util/TSBC_ByteUtils.h"
 
 FString UTSBC_EthereumBlockchainFunctionLibrary::BlockIdentifierFromEnum(const ETSBC_EthBlockIdentifier BlockIdentifier)
 {
@@ -444,6 +445,26 @@ void UTSBC_EthereumBlockchainFunctionLibrary::GetBlockchainConfig(
     }
 }
 
+void UTSBC_EthereumBlockchainFunctionLibrary::RegisterRpcEndpoints(const FTSBC_BlockchainConfig& BlockchainConfig)
+{
+    CTSBC_RpcEndpointPool::Register(BlockchainConfig);
+}
+
+void UTSBC_EthereumBlockchainFunctionLibrary::UnregisterRpcEndpoints(const FString& RpcUrl)
+{
+    CTSBC_RpcEndpointPool::Unregister(RpcUrl);
+}
+
+void UTSBC_EthereumBlockchainFunctionLibrary::GetJsonRpcCacheStats(FTSBC_JsonRpcCacheStats& Stats)
+{
+    Stats = CTSBC_JsonRpcCache::Get().GetStats();
+}
+
+void UTSBC_EthereumBlockchainFunctionLibrary::ClearJsonRpcCache()
+{
+    CTSBC_JsonRpcCache::Get().Empty();
+}
+
 
 bool UTSBC_EthereumBlockchainFunctionLibrary::GenerateAddressFromPublicKeyAsString(
     const FString& PublicKey,
@@ -487,10 +508,14 @@ bool UTSBC_EthereumBlockchainFunctionLibrary::GenerateAddressFromPublicKeyAsStri
      */
 
     // Create hash from the public key which should be in Hex.
-    const FString KeccakHash = CTSBC_Keccak256().KeccakFromString(PublicKey, true);
+    uint8 PublicKeyAsBytes[64];
+    ::HexToBytes(PublicKeyLowercase, PublicKeyAsBytes);
+
+    uint8 KeccakHash[32];
+    CTSBC_Keccak256().HashToBytes(TArrayView<const uint8>(PublicKeyAsBytes, 64), KeccakHash);
 
     // The address is the last 20 Bytes(40 Hex) of the keccak hash.
-    const FString Last20Bytes = KeccakHash.RightChop(24);
+    const FString Last20Bytes = BytesToHex(KeccakHash + 12, 20).ToLower();
 
     // Calculate the checksum of the ethereum address and return the address with prefix 0x if successful calculated.
     FString AddressWithChecksum;
@@ -552,10 +577,11 @@ bool UTSBC_EthereumBlockchainFunctionLibrary::GenerateAddressFromPublicKeyAsByte
 
 
     // Create hash from the public key.
-    const FString KeccakHash = CTSBC_Keccak256().KeccakFromBytes(PublicKey);
+    uint8 KeccakHash[32];
+    CTSBC_Keccak256().HashToBytes(PublicKey, KeccakHash);
 
     // The address is the last 20 Bytes(40 Hex) of the keccak hash.
-    const FString Last20Bytes = KeccakHash.RightChop(24);
+    const FString Last20Bytes = BytesToHex(KeccakHash + 12, 20).ToLower();
 
     // Calculate the checksum of the ethereum address and return the address with prefix 0x if successful calculated.
     FString AddressWithChecksum;
@@ -569,6 +595,22 @@ bool UTSBC_EthereumBlockchainFunctionLibrary::GenerateAddressFromPublicKeyAsByte
     return true;
 }
 
+bool UTSBC_EthereumBlockchainFunctionLibrary::RecoverAddress(
+    const TArray<uint8>& Hash,
+    const TArray<uint8>& Signature,
+    FString& EthereumAddress,
+    FString& ErrorMessage)
+{
+    TArray<uint8> PublicKey;
+    if(!CTSBC_EcdsaSecp256k1::Secp256k1_RecoverPublicKey(Hash, Signature, PublicKey))
+    {
+        ErrorMessage = "Could not recover the public key from the signature";
+        return false;
+    }
+
+    return GenerateAddressFromPublicKeyAsBytes(PublicKey, EthereumAddress, ErrorMessage);
+}
+
 bool UTSBC_EthereumBlockchainFunctionLibrary::IsValidEthereumAddress(const FString& Address)
 {
     return TSBC_StringUtils::RegexMatch(Address, "^0x[a-fA-F0-9]{40}$");
@@ -579,20 +621,8 @@ FString UTSBC_EthereumBlockchainFunctionLibrary::GenerateSignatureJSONMessage(
     const FString& PrivateKey,
     const FString& JSONMessage)
 {
-    //bytes of prefix '\x19Ethereum Signed Message:\n'
-    TArray<uint8> PrefixAsBytes = {
-        25,  69, 116, 104, 101, 114, 101,
-        117, 109,  32,  83, 105, 103, 110,
-        101, 100,  32,  77, 101, 115, 115,
-        97, 103, 101,  58,  10
-    };
-    TArray<uint8> JSONMessageAsBytes = TSBC_StringUtils::StringToBytesUtf8(JSONMessage);
-    TArray<uint8> MsgLenAsBytes = TSBC_StringUtils::StringToBytesUtf8(FString::FromInt(JSONMessage.Len()));
-    TArray<uint8> MergePrefixAndLenAsBytes = TSBC_ByteUtils::MergeBytes(PrefixAsBytes,MsgLenAsBytes);
-    TArray<uint8> MessageToHashAsBytes = TSBC_ByteUtils::MergeBytes(MergePrefixAndLenAsBytes,JSONMessageAsBytes);
     TArray<uint8> PrivateKeyAsBytes = TSBC_StringUtils::HexToBytes(PrivateKey);
-    FString KeccakHash = CTSBC_Keccak256().KeccakFromBytes(MessageToHashAsBytes);
-    TArray<uint8> HashAsBytes = TSBC_StringUtils::HexToBytes(KeccakHash);
+    TArray<uint8> HashAsBytes = HashPersonalMessage(JSONMessage);
     // Sign Message Hash
     TArray<uint8> Signature;
     bool bSignatureCalculated = false;
@@ -611,12 +641,61 @@ bool UTSBC_EthereumBlockchainFunctionLibrary::VerifySignatureJSONMessage(
     const FString& JSONMessage,
     const FString& Signature)
 {
-    FString KeccakHash = CTSBC_Keccak256().KeccakFromString(JSONMessage,false);
-    TArray<uint8> HashAsBytes = TSBC_StringUtils::HexToBytes(KeccakHash);
+    CTSBC_Keccak256 Hasher;
+    Hasher.UpdateAnsi(JSONMessage);
+
+    TArray<uint8> HashAsBytes;
+    HashAsBytes.SetNumUninitialized(32);
+    Hasher.Final(HashAsBytes.GetData());
+
     TArray<uint8> PublicKeyAsBytes = TSBC_StringUtils::HexToBytes(PublicKey);
     TArray<uint8> SignatureAsBytes = TSBC_StringUtils::HexToBytes(Signature);
     return CTSBC_EcdsaSecp256k1::Secp256k1_VerifySignature(
         PublicKeyAsBytes,
         HashAsBytes,
         SignatureAsBytes);
-}
\ No newline at end of file
+}
+
+FString UTSBC_EthereumBlockchainFunctionLibrary::RecoverAddressJSONMessage(
+    const FString& JSONMessage,
+    const FString& Signature)
+{
+    FString EthereumAddress;
+    FString ErrorMessage;
+    if(!RecoverAddress(
+        HashPersonalMessage(JSONMessage),
+        TSBC_StringUtils::HexToBytes(Signature),
+        EthereumAddress,
+        ErrorMessage))
+    {
+        return "";
+    }
+
+    return EthereumAddress;
+}
+
+TArray<uint8> UTSBC_EthereumBlockchainFunctionLibrary::HashPersonalMessage(const FString& Message)
+{
+    //bytes of prefix '\x19Ethereum Signed Message:\n'
+    static const TArray<uint8> PrefixAsBytes = {
+        25,  69, 116, 104, 101, 114, 101,
+        117, 109,  32,  83, 105, 103, 110,
+        101, 100,  32,  77, 101, 115, 115,
+        97, 103, 101,  58,  10
+    };
+    // The length is the number of UTF-8 bytes of the message, not its number of characters.
+    const TArray<uint8> MessageAsBytes = TSBC_StringUtils::StringToBytesUtf8(Message);
+    const TArray<uint8> MsgLenAsBytes = TSBC_StringUtils::StringToBytesUtf8(FString::FromInt(MessageAsBytes.Num()));
+
+    // Hash prefix, length and message as one piece of data without merging them first
+    CTSBC_Keccak256 Hasher;
+    Hasher.Update(PrefixAsBytes);
+    Hasher.Update(MsgLenAsBytes);
+    Hasher.Update(MessageAsBytes);
+
+    TArray<uint8> Hash;
+    Hash.SetNumUninitialized(32);
+    Hasher.Final(Hash.GetData());
+
+    return Hash;
+}
@@ -7,6 +7,8 @@
 #include "Crypto/Hash/TSBC_Sha512.h"
 #include "Crypto/Random/TSBC_SecureRandom.h"
 #include "Util/TSBC_StringUtils.h"
+#include "Async/ParallelFor.h"
+#include "Math/TSBC_Uint256Limbs.h"
 
 // @formatter:off
 const CTSBC_EcdsaSecp256k1::uECC_Curve CTSBC_EcdsaSecp256k1::curve_secp256k1 = {
@@ -22,8 +24,8 @@ const CTSBC_EcdsaSecp256k1::uECC_Curve CTSBC_EcdsaSecp256k1::curve_secp256k1 = {
         0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
     },
     {
-        0x7FFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
-        0x5D576E73, 0x57A4501D, 0xDFE92F46, 0x681B20A0
+        0x681B20A0, 0xDFE92F46, 0x57A4501D, 0x5D576E73,
+        0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x7FFFFFFF
     },
     {
         0x16F81798, 0x59F2815B, 0x2DCE28D9, 0x029BFCDB,
@@ -38,7 +40,35 @@ const CTSBC_EcdsaSecp256k1::uECC_Curve CTSBC_EcdsaSecp256k1::curve_secp256k1 = {
     &CTSBC_EcdsaSecp256k1::double_jacobian_secp256k1,
     &CTSBC_EcdsaSecp256k1::mod_sqrt_default,
     &CTSBC_EcdsaSecp256k1::x_side_secp256k1,
-    &CTSBC_EcdsaSecp256k1::vli_mmod_fast_secp256k1
+    &CTSBC_EcdsaSecp256k1::vli_mmod_fast_secp256k1,
+    &CTSBC_EcdsaSecp256k1::vli_mmod_fast_n_secp256k1
+};
+
+const CTSBC_EcdsaSecp256k1::uECC_Endomorphism CTSBC_EcdsaSecp256k1::endomorphism_secp256k1 = {
+    {
+        0x719501EE, 0xC1396C28, 0x12F58995, 0x9CF04975,
+        0xAC3434E9, 0x6E64479E, 0x657C0710, 0x7AE96A2B
+    },
+    {
+        0x1B23BD72, 0xDF02967C, 0x20816678, 0x122E22EA,
+        0x8812645A, 0xA5261C02, 0xC05C30E0, 0x5363AD4C
+    },
+    {
+        0x0ABFE4C3, 0x6F547FA9, 0x010E8828, 0xE4437ED6,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000
+    },
+    {
+        0x3DB1562C, 0xD765CDA8, 0x0774346D, 0x8A280AC5,
+        0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
+    },
+    {
+        0x45DBB031, 0xE893209A, 0x71E8CA7F, 0x3DAA8A14,
+        0x9284EB15, 0xE86C90E4, 0xA7D46BCD, 0x3086D221
+    },
+    {
+        0x8AC47F71, 0x1571B4AE, 0x9DF506C6, 0x221208AC,
+        0x0ABFE4C4, 0x6F547FA9, 0x010E8828, 0xE4437ED6
+    }
 };
 // @formatter:on
 
@@ -164,6 +194,49 @@ void CTSBC_EcdsaSecp256k1::omega_mult_secp256k1(uint32* result, const uint32* ri
     result[1 + 8] = uECC_vli_add(result + 1, result + 1, right, 8) ? 1 : 0;
 }
 
+void CTSBC_EcdsaSecp256k1::vli_mmod_fast_n_secp256k1(uint32* result, uint32* product)
+{
+    // n = 2^256 - c with c < 2^129, so H * 2^256 + L == H * c + L (mod n). Every fold shrinks the high part by
+    // about 127 bits until the value fits in 256 bits.
+    static const uint32 c[5] = {0x2FC9BEBF, 0x402DA173, 0x50B75FC4, 0x45512319, 0x00000001};
+    uint32 folded[2 * 8];
+    uint32 next[2 * 8];
+
+    uECC_vli_set(folded, product, 2 * 8);
+    int32 num_high = vli_numDigits(folded + 8, 8);
+    while(num_high > 0)
+    {
+        uECC_vli_clear(next + 8, 8);
+        uECC_vli_set(next, folded, 8);
+        for(int32 i = 0; i < num_high; ++i)
+        {
+            uint64 carry = 0;
+            int32 j;
+            for(j = 0; j < 5; ++j)
+            {
+                const uint64 t = static_cast<uint64>(folded[8 + i]) * c[j] + next[i + j] + carry;
+                next[i + j] = static_cast<uint32>(t);
+                carry = t >> 32;
+            }
+            for(j = i + 5; carry != 0 && j < 2 * 8; ++j)
+            {
+                const uint64 t = static_cast<uint64>(next[j]) + carry;
+                next[j] = static_cast<uint32>(t);
+                carry = t >> 32;
+            }
+        }
+
+        uECC_vli_set(folded, next, 2 * 8);
+        num_high = vli_numDigits(folded + 8, 8);
+    }
+
+    while(uECC_vli_cmp_unsafe(folded, curve_secp256k1.n, 8) >= 0)
+    {
+        uECC_vli_sub(folded, folded, curve_secp256k1.n, 8);
+    }
+    uECC_vli_set(result, folded, 8);
+}
+
 int32 CTSBC_EcdsaSecp256k1::uECC_curve_private_key_size(const uECC_Curve* curve)
 {
     return BITS_TO_BYTES(curve->num_n_bits);
@@ -348,6 +421,14 @@ void CTSBC_EcdsaSecp256k1::uECC_vli_mult(
     const uint32* right,
     const int32 num_words)
 {
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(num_words == 8)
+    {
+        TSBC_Uint256Limbs::Multiply(result, left, right);
+        return;
+    }
+#endif
+
     uint32 r0 = 0;
     uint32 r1 = 0;
     uint32 r2 = 0;
@@ -493,6 +574,17 @@ void CTSBC_EcdsaSecp256k1::uECC_vli_modSquare_fast(
     uECC_vli_modMult_fast(result, left, left, curve);
 }
 
+void CTSBC_EcdsaSecp256k1::uECC_vli_modMult_n(
+    uint32* result,
+    const uint32* left,
+    const uint32* right,
+    const uECC_Curve* curve)
+{
+    uint32 product[2 * 8];
+    uECC_vli_mult(product, left, right, curve->num_words);
+    curve->mmod_fast_n(result, product);
+}
+
 void CTSBC_EcdsaSecp256k1::vli_modInv_update(uint32* uv, const uint32* mod, const int32 num_words)
 {
     bool carry = false;
@@ -568,6 +660,73 @@ void CTSBC_EcdsaSecp256k1::uECC_vli_modInv(
     uECC_vli_set(result, u, num_words);
 }
 
+void CTSBC_EcdsaSecp256k1::uECC_vli_modInv_batch(
+    uint32* values,
+    const int32 count,
+    const uint32* mod,
+    const uECC_Curve* curve)
+{
+    // Montgomery's trick: a single inversion of the product of all values, zero values are left untouched.
+    const int32 num_words = curve->num_words;
+    const bool bFieldModulus = mod == curve->p;
+    const bool bOrderModulus = mod == curve->n;
+    TArray<uint32> prefix;
+    prefix.SetNumUninitialized(count * 8);
+    uint32 acc[8] = {1};
+    uint32 tmp[8];
+
+    for(int32 i = 0; i < count; ++i)
+    {
+        uint32* value = values + i * 8;
+        uECC_vli_set(&prefix[i * 8], acc, num_words);
+        if(uECC_vli_isZero(value, num_words))
+        {
+            continue;
+        }
+
+        if(bFieldModulus)
+        {
+            uECC_vli_modMult_fast(acc, acc, value, curve);
+        }
+        else if(bOrderModulus)
+        {
+            uECC_vli_modMult_n(acc, acc, value, curve);
+        }
+        else
+        {
+            uECC_vli_modMult(acc, acc, value, mod, num_words);
+        }
+    }
+
+    uECC_vli_modInv(acc, acc, mod, num_words);
+
+    for(int32 i = count - 1; i >= 0; --i)
+    {
+        uint32* value = values + i * 8;
+        if(uECC_vli_isZero(value, num_words))
+        {
+            continue;
+        }
+
+        if(bFieldModulus)
+        {
+            uECC_vli_modMult_fast(tmp, acc, &prefix[i * 8], curve);
+            uECC_vli_modMult_fast(acc, acc, value, curve);
+        }
+        else if(bOrderModulus)
+        {
+            uECC_vli_modMult_n(tmp, acc, &prefix[i * 8], curve);
+            uECC_vli_modMult_n(acc, acc, value, curve);
+        }
+        else
+        {
+            uECC_vli_modMult(tmp, acc, &prefix[i * 8], mod, num_words);
+            uECC_vli_modMult(acc, acc, value, mod, num_words);
+        }
+        uECC_vli_set(value, tmp, num_words);
+    }
+}
+
 bool CTSBC_EcdsaSecp256k1::EccPoint_isZero(const uint32* point, const uECC_Curve* curve)
 {
     return uECC_vli_isZero((point), (curve)->num_words * 2);
@@ -681,6 +840,65 @@ void CTSBC_EcdsaSecp256k1::XYcZ_addC(
     uECC_vli_set(X1, t7, num_words);
 }
 
+void CTSBC_EcdsaSecp256k1::EccPoint_add_mixed(
+    uint32* X1,
+    uint32* Y1,
+    uint32* Z1,
+    const uint32* point,
+    const uECC_Curve* curve)
+{
+    // Adds the affine point to the Jacobian point (X1, Y1, Z1), a zero Z1 is the point at infinity.
+    uint32 t1[8];
+    uint32 t2[8];
+    uint32 t3[8];
+    uint32 t4[8];
+    const int32 num_words = curve->num_words;
+
+    if(uECC_vli_isZero(Z1, num_words))
+    {
+        uECC_vli_set(X1, point, num_words);
+        uECC_vli_set(Y1, point + num_words, num_words);
+        uECC_vli_clear(Z1, num_words);
+        Z1[0] = 1;
+        return;
+    }
+
+    uECC_vli_modSquare_fast(t1, Z1, curve);
+    uECC_vli_modMult_fast(t2, point, t1, curve);
+    uECC_vli_modMult_fast(t1, t1, Z1, curve);
+    uECC_vli_modMult_fast(t1, t1, point + num_words, curve);
+    uECC_vli_modSub(t2, t2, X1, curve->p, num_words);
+    uECC_vli_modSub(t1, t1, Y1, curve->p, num_words);
+
+    if(uECC_vli_isZero(t2, num_words))
+    {
+        if(uECC_vli_isZero(t1, num_words))
+        {
+            curve->double_jacobian(X1, Y1, Z1, curve);
+        }
+        else
+        {
+            uECC_vli_clear(Z1, num_words);
+        }
+        return;
+    }
+
+    uECC_vli_modMult_fast(Z1, Z1, t2, curve);
+    uECC_vli_modSquare_fast(t3, t2, curve);
+    uECC_vli_modMult_fast(t4, t3, t2, curve);
+    uECC_vli_modMult_fast(t3, t3, X1, curve);
+
+    uECC_vli_modSquare_fast(X1, t1, curve);
+    uECC_vli_modSub(X1, X1, t4, curve->p, num_words);
+    uECC_vli_modSub(X1, X1, t3, curve->p, num_words);
+    uECC_vli_modSub(X1, X1, t3, curve->p, num_words);
+
+    uECC_vli_modSub(t3, t3, X1, curve->p, num_words);
+    uECC_vli_modMult_fast(t3, t3, t1, curve);
+    uECC_vli_modMult_fast(t4, t4, Y1, curve);
+    uECC_vli_modSub(Y1, t3, t4, curve->p, num_words);
+}
+
 int32 CTSBC_EcdsaSecp256k1::EccPoint_mult(
     uint32* result,
     const uint32* point,
@@ -740,23 +958,397 @@ bool CTSBC_EcdsaSecp256k1::regularize_k(
     return carry;
 }
 
+void CTSBC_EcdsaSecp256k1::uECC_build_base_table(uECC_BaseTable& table, const uECC_Curve* curve)
+{
+    // Arbitrary offset scalar (the leading fractional digits of pi), the offset point keeps every table entry
+    // and every partial sum in EccPoint_mult_base away from the point at infinity.
+    static const uint32 offset_scalar[8] = {
+        0xEC4E6C89, 0x082EFA98, 0x299F31D0, 0xA4093822,
+        0x03707344, 0x13198A2E, 0x85A308D3, 0x243F6A88
+    };
+
+    constexpr int32 num_entries = uECC_BASE_NUM_WINDOWS * uECC_BASE_WINDOW_SIZE;
+    const int32 num_words = curve->num_words;
+    uint32 k0[8];
+    uint32 k1[8];
+    uint32 offset[8 * 2];
+    uint32 last_offset[8 * 2];
+    uint32 base[8 * 2];
+
+    // offset = c * G, last_offset = -(NUM_WINDOWS - 1) * c * G
+    bool carry = regularize_k(offset_scalar, k0, k1, curve);
+    EccPoint_mult(offset, curve->G, carry ? k0 : k1, 0, curve->num_n_bits + 1, curve);
+
+    uint32 scale[8] = {uECC_BASE_NUM_WINDOWS - 1};
+    uECC_vli_modMult_n(scale, scale, offset_scalar, curve);
+    carry = regularize_k(scale, k0, k1, curve);
+    EccPoint_mult(last_offset, curve->G, carry ? k0 : k1, 0, curve->num_n_bits + 1, curve);
+    uECC_vli_sub(last_offset + num_words, curve->p, last_offset + num_words, num_words);
+
+    TArray<uint32> X;
+    TArray<uint32> Y;
+    TArray<uint32> Z;
+    X.SetNumUninitialized(num_entries * 8);
+    Y.SetNumUninitialized(num_entries * 8);
+    Z.SetNumUninitialized(num_entries * 8);
+
+    uECC_vli_set(base, curve->G, num_words * 2);
+    for(int32 i = 0; i < uECC_BASE_NUM_WINDOWS; ++i)
+    {
+        const uint32* start = i == uECC_BASE_NUM_WINDOWS - 1 ? last_offset : offset;
+        uint32 x[8];
+        uint32 y[8];
+        uint32 z[8] = {1};
+        uECC_vli_set(x, start, num_words);
+        uECC_vli_set(y, start + num_words, num_words);
+
+        for(int32 j = 0; j < uECC_BASE_WINDOW_SIZE; ++j)
+        {
+            const int32 index = (i * uECC_BASE_WINDOW_SIZE + j) * 8;
+            uECC_vli_set(&X[index], x, num_words);
+            uECC_vli_set(&Y[index], y, num_words);
+            uECC_vli_set(&Z[index], z, num_words);
+            EccPoint_add_mixed(x, y, z, base, curve);
+        }
+
+        // base = 16 * base
+        uint32 bz[8] = {1};
+        for(int32 b = 0; b < uECC_BASE_WINDOW_BITS; ++b)
+        {
+            curve->double_jacobian(base, base + num_words, bz, curve);
+        }
+        uECC_vli_modInv(bz, bz, curve->p, num_words);
+        apply_z(base, base + num_words, bz, curve);
+    }
+
+    uECC_vli_modInv_batch(Z.GetData(), num_entries, curve->p, curve);
+    for(int32 i = 0; i < uECC_BASE_NUM_WINDOWS; ++i)
+    {
+        for(int32 j = 0; j < uECC_BASE_WINDOW_SIZE; ++j)
+        {
+            const int32 index = (i * uECC_BASE_WINDOW_SIZE + j) * 8;
+            apply_z(&X[index], &Y[index], &Z[index], curve);
+            uECC_vli_set(table.points[i][j], &X[index], num_words);
+            uECC_vli_set(table.points[i][j] + num_words, &Y[index], num_words);
+        }
+    }
+}
+
+const CTSBC_EcdsaSecp256k1::uECC_BaseTable& CTSBC_EcdsaSecp256k1::uECC_base_table()
+{
+    // Built on first use, the initialization of function-local statics is thread-safe.
+    static uECC_BaseTable Table;
+    static const bool bInitialized = (uECC_build_base_table(Table, uECC_secp256k1()), true);
+    (void)bInitialized;
+
+    return Table;
+}
+
+int32 CTSBC_EcdsaSecp256k1::EccPoint_mult_base(uint32* result, const uint32* scalar, const uECC_Curve* curve)
+{
+    const uECC_BaseTable& table = uECC_base_table();
+    uint32 X[8];
+    uint32 Y[8];
+    uint32 Z[8] = {1};
+    uint32 entry[8 * 2];
+    const int32 num_words = curve->num_words;
+
+    for(int32 i = 0; i < uECC_BASE_NUM_WINDOWS; ++i)
+    {
+        const uint32 digit = (scalar[i / 8] >> ((i % 8) * uECC_BASE_WINDOW_BITS)) & (uECC_BASE_WINDOW_SIZE - 1);
+
+        // Reads every entry of the window so the memory access pattern doesn't depend on the scalar.
+        uECC_vli_clear(entry, num_words * 2);
+        for(int32 j = 0; j < uECC_BASE_WINDOW_SIZE; ++j)
+        {
+            const uint32 mask = 0 - static_cast<uint32>(static_cast<uint32>(j) == digit);
+            for(int32 w = 0; w < num_words * 2; ++w)
+            {
+                entry[w] |= table.points[i][j][w] & mask;
+            }
+        }
+
+        if(i == 0)
+        {
+            uECC_vli_set(X, entry, num_words);
+            uECC_vli_set(Y, entry + num_words, num_words);
+        }
+        else
+        {
+            EccPoint_add_mixed(X, Y, Z, entry, curve);
+        }
+    }
+
+    if(uECC_vli_isZero(Z, num_words))
+    {
+        uECC_vli_clear(result, num_words * 2);
+        return 0;
+    }
+
+    uECC_vli_modInv(Z, Z, curve->p, num_words);
+    apply_z(X, Y, Z, curve);
+
+    uECC_vli_set(result, X, num_words);
+    uECC_vli_set(result + num_words, Y, num_words);
+
+    return GetYParity(Y);
+}
+
+void CTSBC_EcdsaSecp256k1::scalar_mul_shift_384(uint32* result, const uint32* left, const uint32* right)
+{
+    uint32 product[2 * 8];
+    uECC_vli_mult(product, left, right, 8);
+
+    uECC_vli_clear(result, 8);
+    for(int32 i = 0; i < 4; ++i)
+    {
+        result[i] = product[12 + i];
+    }
+
+    // Round to nearest with bit 383.
+    if(product[11] >> 31)
+    {
+        for(int32 i = 0; i < 8 && ++result[i] == 0; ++i)
+        {
+        }
+    }
+}
+
+void CTSBC_EcdsaSecp256k1::scalar_split_lambda(
+    uint32* k1,
+    uint32* k2,
+    const uint32* k,
+    const uECC_Curve* curve)
+{
+    const uECC_Endomorphism* endomorphism = &endomorphism_secp256k1;
+    uint32 c1[8];
+    uint32 c2[8];
+    const int32 num_words = curve->num_words;
+
+    scalar_mul_shift_384(c1, k, endomorphism->g1);
+    scalar_mul_shift_384(c2, k, endomorphism->g2);
+    uECC_vli_modMult_n(c1, c1, endomorphism->minus_b1, curve);
+    uECC_vli_modMult_n(c2, c2, endomorphism->minus_b2, curve);
+    uECC_vli_modAdd(k2, c1, c2, curve->n, num_words);
+    uECC_vli_modMult_n(k1, k2, endomorphism->lambda, curve);
+    uECC_vli_modSub(k1, k, k1, curve->n, num_words);
+}
+
+int32 CTSBC_EcdsaSecp256k1::wnaf_encode(int32* wnaf, const uint32* scalar, const int32 window_bits)
+{
+    // One spare word for the carries of negative digits.
+    uint32 k[8 + 1];
+    const int32 window_size = 1 << window_bits;
+    int32 num_digits = 0;
+
+    uECC_vli_set(k, scalar, 8);
+    k[8] = 0;
+
+    while(!uECC_vli_isZero(k, 8 + 1))
+    {
+        int32 digit = 0;
+        if(k[0] & 1)
+        {
+            digit = static_cast<int32>(k[0] & (window_size - 1));
+            if(digit >= window_size / 2)
+            {
+                digit -= window_size;
+            }
+
+            if(digit > 0)
+            {
+                k[0] -= digit;
+            }
+            else
+            {
+                k[0] += -digit;
+                if(k[0] < static_cast<uint32>(-digit))
+                {
+                    for(int32 i = 1; i < 8 + 1 && ++k[i] == 0; ++i)
+                    {
+                    }
+                }
+            }
+        }
+
+        wnaf[num_digits++] = digit;
+        uECC_vli_rshift1(k, 8 + 1);
+    }
+
+    return num_digits;
+}
+
+void CTSBC_EcdsaSecp256k1::EccPoint_odd_multiples_co_z(
+    uint32* table,
+    uint32* z_values,
+    const uint32* point,
+    const int32 count,
+    const uECC_Curve* curve)
+{
+    // Consecutive co-Z additions of 2P, every step rescales to a new Z which is written to z_values.
+    uint32 X2[8];
+    uint32 Y2[8];
+    uint32 z[8] = {1};
+    uint32 t[8];
+    const int32 num_words = curve->num_words;
+
+    uECC_vli_set(X2, point, num_words);
+    uECC_vli_set(Y2, point + num_words, num_words);
+    curve->double_jacobian(X2, Y2, z, curve);
+
+    uECC_vli_set(table, point, num_words * 2);
+    apply_z(table, table + num_words, z, curve);
+    uECC_vli_set(z_values, z, num_words);
+
+    for(int32 i = 1; i < count; ++i)
+    {
+        uint32* entry = table + i * num_words * 2;
+        uECC_vli_set(entry, entry - num_words * 2, num_words * 2);
+        uECC_vli_modSub(t, entry, X2, curve->p, num_words);
+        uECC_vli_modMult_fast(z, z, t, curve);
+        XYcZ_add(X2, Y2, entry, entry + num_words, curve);
+        uECC_vli_set(z_values + i * 8, z, num_words);
+    }
+}
+
+void CTSBC_EcdsaSecp256k1::EccPoint_odd_multiples(
+    uint32* table,
+    const uint32* point,
+    const int32 count,
+    const uECC_Curve* curve)
+{
+    TArray<uint32> Z;
+    Z.SetNumUninitialized(count * 8);
+    EccPoint_odd_multiples_co_z(table, Z.GetData(), point, count, curve);
+
+    uECC_vli_modInv_batch(Z.GetData(), count, curve->p, curve);
+    for(int32 i = 0; i < count; ++i)
+    {
+        uint32* entry = table + i * curve->num_words * 2;
+        apply_z(entry, entry + curve->num_words, &Z[i * 8], curve);
+    }
+}
+
+void CTSBC_EcdsaSecp256k1::EccPoint_apply_endomorphism(
+    uint32* result,
+    const uint32* point,
+    const uECC_Curve* curve)
+{
+    uECC_vli_modMult_fast(result, point, endomorphism_secp256k1.beta, curve);
+    uECC_vli_set(result + curve->num_words, point + curve->num_words, curve->num_words);
+}
+
+const CTSBC_EcdsaSecp256k1::uECC_WnafTable& CTSBC_EcdsaSecp256k1::uECC_wnaf_table()
+{
+    // Built on first use, the initialization of function-local statics is thread-safe.
+    static uECC_WnafTable Table;
+    static const bool bInitialized = []()
+    {
+        const uECC_Curve* curve = uECC_secp256k1();
+        EccPoint_odd_multiples(Table.points[0], curve->G, uECC_WNAF_G_TABLE_SIZE, curve);
+        for(int32 i = 0; i < uECC_WNAF_G_TABLE_SIZE; ++i)
+        {
+            EccPoint_apply_endomorphism(Table.points_lambda[i], Table.points[i], curve);
+        }
+        return true;
+    }();
+    (void)bInitialized;
+
+    return Table;
+}
+
+void CTSBC_EcdsaSecp256k1::EccPoint_mult_add_glv(
+    uint32* X,
+    uint32* Y,
+    uint32* Z,
+    const uint32* u1,
+    const uint32* u2,
+    const uint32* point_table,
+    const uECC_Curve* curve)
+{
+    // Computes u1 * G + u2 * P in Jacobian coordinates, point_table holds the affine odd multiples of P. Both
+    // scalars are split into halves of ~128 bits for the base and its endomorphism image, which halves the number
+    // of doublings, and the four halves are added in wNAF form.
+    const uECC_WnafTable& g_table = uECC_wnaf_table();
+    uint32 point_table_lambda[uECC_WNAF_POINT_TABLE_SIZE][8 * 2];
+    uint32 scalars[4][8];
+    int32 wnaf[4][uECC_WNAF_MAX_DIGITS];
+    int32 num_digits[4];
+    bool negate[4];
+    uint32 entry[8 * 2];
+    const int32 num_words = curve->num_words;
+
+    for(int32 i = 0; i < uECC_WNAF_POINT_TABLE_SIZE; ++i)
+    {
+        EccPoint_apply_endomorphism(point_table_lambda[i], point_table + i * num_words * 2, curve);
+    }
+
+    const uint32* tables[4] = {g_table.points[0], g_table.points_lambda[0], point_table, point_table_lambda[0]};
+    const int32 window_bits[4] = {
+        uECC_WNAF_G_WINDOW_BITS,
+        uECC_WNAF_G_WINDOW_BITS,
+        uECC_WNAF_POINT_WINDOW_BITS,
+        uECC_WNAF_POINT_WINDOW_BITS
+    };
+
+    scalar_split_lambda(scalars[0], scalars[1], u1, curve);
+    scalar_split_lambda(scalars[2], scalars[3], u2, curve);
+
+    int32 max_digits = 0;
+    for(int32 i = 0; i < 4; ++i)
+    {
+        // Halves above n / 2 are small negative values, encode their absolute value and negate the points.
+        negate[i] = uECC_vli_cmp_unsafe(scalars[i], curve->nhalf, num_words) > 0;
+        if(negate[i])
+        {
+            uECC_vli_sub(scalars[i], curve->n, scalars[i], num_words);
+        }
+
+        num_digits[i] = wnaf_encode(wnaf[i], scalars[i], window_bits[i]);
+        if(num_digits[i] > max_digits)
+        {
+            max_digits = num_digits[i];
+        }
+    }
+
+    uECC_vli_clear(X, num_words);
+    uECC_vli_clear(Y, num_words);
+    uECC_vli_clear(Z, num_words);
+
+    for(int32 bit = max_digits - 1; bit >= 0; --bit)
+    {
+        curve->double_jacobian(X, Y, Z, curve);
+
+        for(int32 i = 0; i < 4; ++i)
+        {
+            if(bit >= num_digits[i] || wnaf[i][bit] == 0)
+            {
+                continue;
+            }
+
+            const int32 digit = wnaf[i][bit];
+            const uint32* source = tables[i] + ((digit < 0 ? -digit : digit) - 1) / 2 * num_words * 2;
+            uECC_vli_set(entry, source, num_words);
+            if((digit < 0) != negate[i])
+            {
+                uECC_vli_sub(entry + num_words, curve->p, source + num_words, num_words);
+            }
+            else
+            {
+                uECC_vli_set(entry + num_words, source + num_words, num_words);
+            }
+
+            EccPoint_add_mixed(X, Y, Z, entry, curve);
+        }
+    }
+}
+
 bool CTSBC_EcdsaSecp256k1::EccPoint_compute_public_key(
     uint32* result,
     const uint32* private_key,
     const uECC_Curve* curve)
 {
-    uint32 tmp1[8];
-    uint32 tmp2[8];
-    uint32* p2[2] = {tmp1, tmp2};
-
-    const bool carry = regularize_k(private_key, tmp1, tmp2, curve);
-    EccPoint_mult(
-        result,
-        curve->G,
-        p2[carry ? 0 : 1],
-        0,
-        curve->num_n_bits + 1,
-        curve);
+    EccPoint_mult_base(result, private_key, curve);
 
     if(EccPoint_isZero(result, curve))
     {
@@ -1020,25 +1612,16 @@ bool CTSBC_EcdsaSecp256k1::uECC_sign_with_k(
 {
     uint32 tmp[8];
     uint32 s[8];
-    uint32* k2[2] = {tmp, s};
     uint32 p[8 * 2];
     const int32 num_words = curve->num_words;
     const int32 num_n_words = BITS_TO_WORDS(curve->num_n_bits);
-    const int32 num_n_bits = curve->num_n_bits;
 
     if(uECC_vli_isZero(k, num_words) || uECC_vli_cmp(curve->n, k, num_n_words) != 1)
     {
         return false;
     }
 
-    const bool carry = regularize_k(k, tmp, s, curve);
-    const int32 YParity = EccPoint_mult(
-        p,
-        curve->G,
-        k2[carry ? 0 : 1],
-        0,
-        num_n_bits + 1,
-        curve);
+    int32 YParity = EccPoint_mult_base(p, k, curve);
     if(uECC_vli_isZero(p, num_words))
     {
         return false;
@@ -1049,18 +1632,18 @@ bool CTSBC_EcdsaSecp256k1::uECC_sign_with_k(
         return false;
     }
 
-    uECC_vli_modMult(k, k, tmp, curve->n, num_n_words);
+    uECC_vli_modMult_n(k, k, tmp, curve);
     uECC_vli_modInv(k, k, curve->n, num_n_words);
-    uECC_vli_modMult(k, k, tmp, curve->n, num_n_words);
+    uECC_vli_modMult_n(k, k, tmp, curve);
     uECC_vli_nativeToBytes(signature, curve->num_bytes, p);
 
     uECC_vli_bytesToNative(tmp, private_key, BITS_TO_BYTES(curve->num_n_bits));
     s[num_n_words - 1] = 0;
     uECC_vli_set(s, p, num_words);
-    uECC_vli_modMult(s, tmp, s, curve->n, num_n_words);
+    uECC_vli_modMult_n(s, tmp, s, curve);
     bits2int(tmp, message_hash, hash_size, curve);
     uECC_vli_modAdd(s, tmp, s, curve->n, num_n_words);
-    uECC_vli_modMult(s, s, k, curve->n, num_n_words);
+    uECC_vli_modMult_n(s, s, k, curve);
     if(uECC_vli_numBits(s, num_n_words) > curve->num_bytes * 8)
     {
         return false;
@@ -1068,8 +1651,9 @@ bool CTSBC_EcdsaSecp256k1::uECC_sign_with_k(
 
     if(uECC_vli_cmp(s, curve->nhalf, num_n_words) > 0)
     {
-        // EIP-2
-        return false;
+        // EIP-2: (r, n - s) is the low-s form of the same signature, it belongs to -R so the parity flips.
+        uECC_vli_sub(s, curve->n, s, num_n_words);
+        YParity ^= 1;
     }
 
     uECC_vli_nativeToBytes(signature + curve->num_bytes, curve->num_bytes, s);
@@ -1251,21 +1835,13 @@ bool CTSBC_EcdsaSecp256k1::uECC_verify(
 {
     uint32 u1[8], u2[8];
     uint32 z[8];
-    uint32 sum[8 * 2];
-    uint32 rx[8];
-    uint32 ry[8];
-
-    uint32 tx[8];
-    uint32 ty[8];
-    uint32 tz[8];
-
-    const uint32* points[4];
+    uint32 X[8], Y[8], Z[8];
+    uint32 point_table[uECC_WNAF_POINT_TABLE_SIZE][8 * 2];
     uint32 _public[8 * 2];
     uint32 r[8], s[8];
     const int32 num_words = curve->num_words;
     const int32 num_n_words = BITS_TO_WORDS(curve->num_n_bits);
 
-    rx[num_n_words - 1] = 0;
     r[num_n_words - 1] = 0;
     s[num_n_words - 1] = 0;
 
@@ -1287,60 +1863,227 @@ bool CTSBC_EcdsaSecp256k1::uECC_verify(
     uECC_vli_modInv(z, s, curve->n, num_n_words);
     u1[num_n_words - 1] = 0;
     bits2int(u1, message_hash, hash_size, curve);
-    uECC_vli_modMult(u1, u1, z, curve->n, num_n_words);
-    uECC_vli_modMult(u2, r, z, curve->n, num_n_words);
-
-    uECC_vli_set(sum, _public, num_words);
-    uECC_vli_set(sum + num_words, _public + num_words, num_words);
-    uECC_vli_set(tx, curve->G, num_words);
-    uECC_vli_set(ty, curve->G + num_words, num_words);
-    uECC_vli_modSub(z, sum, tx, curve->p, num_words);
-    XYcZ_add(tx, ty, sum, sum + num_words, curve);
-    uECC_vli_modInv(z, z, curve->p, num_words);
-    apply_z(sum, sum + num_words, z, curve);
-
-    points[0] = 0;
-    points[1] = curve->G;
-    points[2] = _public;
-    points[3] = sum;
-    const int32 num_bits_a = uECC_vli_numBits(u1, num_n_words);
-    const int32 num_bits_b = uECC_vli_numBits(u2, num_n_words);
-    const int32 num_bits = (num_bits_a > num_bits_b) ? num_bits_a : num_bits_b;
-
-    const uint32* point = points[(uECC_vli_testBit(u1, num_bits - 1) ? 1 : 0) | ((uECC_vli_testBit(u2, num_bits - 1)
-                                     ? 1
-                                     : 0) << 1)];
-    uECC_vli_set(rx, point, num_words);
-    uECC_vli_set(ry, point + num_words, num_words);
-    uECC_vli_clear(z, num_words);
-    z[0] = 1;
-
-    for(int32 i = num_bits - 2; i >= 0; --i)
-    {
-        curve->double_jacobian(rx, ry, z, curve);
-
-        const uint32 index = (uECC_vli_testBit(u1, i) ? 1 : 0) | ((uECC_vli_testBit(u2, i) ? 1 : 0) << 1);
-        point = points[index];
-        if(point)
+    uECC_vli_modMult_n(u1, u1, z, curve);
+    uECC_vli_modMult_n(u2, r, z, curve);
+
+    EccPoint_odd_multiples(point_table[0], _public, uECC_WNAF_POINT_TABLE_SIZE, curve);
+    EccPoint_mult_add_glv(X, Y, Z, u1, u2, point_table[0], curve);
+
+    return uECC_verify_x(X, Z, r, curve);
+}
+
+bool CTSBC_EcdsaSecp256k1::uECC_verify_x(
+    const uint32* X,
+    const uint32* Z,
+    const uint32* r,
+    const uECC_Curve* curve)
+{
+    // Checks r == X / Z^2 (mod n) without an inversion: X == r * Z^2 or, when r + n < p, X == (r + n) * Z^2.
+    uint32 zz[8];
+    uint32 t[8];
+    uint32 rn[8];
+    const int32 num_words = curve->num_words;
+
+    if(uECC_vli_isZero(Z, num_words))
+    {
+        return false;
+    }
+
+    uECC_vli_modSquare_fast(zz, Z, curve);
+    uECC_vli_modMult_fast(t, r, zz, curve);
+    if(uECC_vli_equal(t, X, num_words))
+    {
+        return true;
+    }
+
+    if(uECC_vli_add(rn, r, curve->n, num_words) || uECC_vli_cmp_unsafe(curve->p, rn, num_words) != 1)
+    {
+        return false;
+    }
+
+    uECC_vli_modMult_fast(t, rn, zz, curve);
+
+    return uECC_vli_equal(t, X, num_words);
+}
+
+void CTSBC_EcdsaSecp256k1::uECC_verify_batch(
+    const FTSBC_Secp256k1SignatureToVerify* items,
+    const int32 count,
+    uint8* results,
+    const uECC_Curve* curve)
+{
+    // Verifies the items like uECC_verify, but inverts all s values (mod n) and all Z values of the odd multiples
+    // tables (mod p) together, so the whole batch costs two inversions.
+    constexpr int32 table_words = uECC_WNAF_POINT_TABLE_SIZE * 8 * 2;
+    const int32 num_words = curve->num_words;
+    TArray<uint32> r;
+    TArray<uint32> s_inv;
+    TArray<uint32> tables;
+    TArray<uint32> z_values;
+    r.SetNumZeroed(count * 8);
+    s_inv.SetNumZeroed(count * 8);
+    tables.SetNumZeroed(count * table_words);
+    z_values.SetNumZeroed(count * uECC_WNAF_POINT_TABLE_SIZE * 8);
+
+    for(int32 i = 0; i < count; ++i)
+    {
+        const FTSBC_Secp256k1SignatureToVerify& item = items[i];
+        uint32 _public[8 * 2];
+        uint32 s[8];
+        results[i] = 0;
+
+        if(item.PublicKey.Num() != uECC_curve_public_key_size(curve) || item.Signature.Num() < curve->num_bytes * 2)
         {
-            uECC_vli_set(tx, point, num_words);
-            uECC_vli_set(ty, point + num_words, num_words);
-            apply_z(tx, ty, z, curve);
-            uECC_vli_modSub(tz, rx, tx, curve->p, num_words);
-            XYcZ_add(tx, ty, rx, ry, curve);
-            uECC_vli_modMult_fast(z, z, tz, curve);
+            continue;
         }
+
+        uECC_vli_bytesToNative(_public, item.PublicKey.GetData(), curve->num_bytes);
+        uECC_vli_bytesToNative(_public + num_words, item.PublicKey.GetData() + curve->num_bytes, curve->num_bytes);
+        uECC_vli_bytesToNative(&r[i * 8], item.Signature.GetData(), curve->num_bytes);
+        uECC_vli_bytesToNative(s, item.Signature.GetData() + curve->num_bytes, curve->num_bytes);
+
+        if(!uECC_valid_point(_public, curve))
+        {
+            continue;
+        }
+
+        if(uECC_vli_isZero(&r[i * 8], num_words) || uECC_vli_isZero(s, num_words))
+        {
+            continue;
+        }
+
+        if(uECC_vli_cmp_unsafe(curve->n, &r[i * 8], num_words) != 1 || uECC_vli_cmp_unsafe(curve->n, s, num_words) != 1)
+        {
+            continue;
+        }
+
+        // Items that failed a check keep zero s and Z values, the batch inversions skip them.
+        uECC_vli_set(&s_inv[i * 8], s, num_words);
+        EccPoint_odd_multiples_co_z(
+            &tables[i * table_words],
+            &z_values[i * uECC_WNAF_POINT_TABLE_SIZE * 8],
+            _public,
+            uECC_WNAF_POINT_TABLE_SIZE,
+            curve);
+        results[i] = 1;
     }
 
-    uECC_vli_modInv(z, z, curve->p, num_words);
-    apply_z(rx, ry, z, curve);
+    uECC_vli_modInv_batch(s_inv.GetData(), count, curve->n, curve);
+    uECC_vli_modInv_batch(z_values.GetData(), count * uECC_WNAF_POINT_TABLE_SIZE, curve->p, curve);
+
+    for(int32 i = 0; i < count; ++i)
+    {
+        if(!results[i])
+        {
+            continue;
+        }
+
+        const FTSBC_Secp256k1SignatureToVerify& item = items[i];
+        uint32* table = &tables[i * table_words];
+        uint32 u1[8], u2[8];
+        uint32 X[8], Y[8], Z[8];
+
+        for(int32 j = 0; j < uECC_WNAF_POINT_TABLE_SIZE; ++j)
+        {
+            uint32* entry = table + j * num_words * 2;
+            apply_z(entry, entry + num_words, &z_values[(i * uECC_WNAF_POINT_TABLE_SIZE + j) * 8], curve);
+        }
+
+        bits2int(u1, item.Hash.GetData(), item.Hash.Num(), curve);
+        uECC_vli_modMult_n(u1, u1, &s_inv[i * 8], curve);
+        uECC_vli_modMult_n(u2, &r[i * 8], &s_inv[i * 8], curve);
+
+        EccPoint_mult_add_glv(X, Y, Z, u1, u2, table, curve);
+        results[i] = uECC_verify_x(X, Z, &r[i * 8], curve) ? 1 : 0;
+    }
+}
+
+bool CTSBC_EcdsaSecp256k1::uECC_recover(
+    const uint8* message_hash,
+    const uint32 hash_size,
+    const uint8* signature,
+    uint8* public_key,
+    const uECC_Curve* curve)
+{
+    uint32 u1[8], u2[8];
+    uint32 z[8];
+    uint32 X[8], Y[8], Z[8];
+    uint32 point[8 * 2];
+    uint32 point_table[uECC_WNAF_POINT_TABLE_SIZE][8 * 2];
+    uint32 r[8], s[8];
+    uint32* y = point + curve->num_words;
+    const int32 num_words = curve->num_words;
+    const int32 num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+    const uint8 v = signature[curve->num_bytes * 2];
+    const uint8 recovery_id = v >= 27 ? v - 27 : v;
+    if(recovery_id > 3)
+    {
+        return false;
+    }
+
+    uECC_vli_bytesToNative(r, signature, curve->num_bytes);
+    uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
+
+    if(uECC_vli_isZero(r, num_words) || uECC_vli_isZero(s, num_words))
+    {
+        return false;
+    }
+
+    if(uECC_vli_cmp_unsafe(curve->n, r, num_n_words) != 1 || uECC_vli_cmp_unsafe(curve->n, s, num_n_words) != 1)
+    {
+        return false;
+    }
 
-    if(uECC_vli_cmp_unsafe(curve->n, rx, num_n_words) != 1)
+    // R.x is r, or r + n if the x-coordinate of k * G was reduced when signing.
+    uECC_vli_set(point, r, num_words);
+    if(recovery_id & 0x02)
     {
-        uECC_vli_sub(rx, rx, curve->n, num_n_words);
+        if(uECC_vli_add(point, r, curve->n, num_words) || uECC_vli_cmp_unsafe(curve->p, point, num_words) != 1)
+        {
+            return false;
+        }
     }
 
-    return uECC_vli_equal(rx, r, num_words);
+    curve->x_side(z, point, curve);
+    uECC_vli_set(y, z, num_words);
+    curve->mod_sqrt(y, curve);
+    uECC_vli_modSquare_fast(u1, y, curve);
+    if(!uECC_vli_equal(u1, z, num_words))
+    {
+        // R.x is not the x-coordinate of a point on the curve.
+        return false;
+    }
+
+    if((y[0] & 0x01) != (recovery_id & 0x01))
+    {
+        uECC_vli_sub(y, curve->p, y, num_words);
+    }
+
+    // Q = r^-1 * (s * R - e * G)
+    uECC_vli_modInv(z, r, curve->n, num_n_words);
+    bits2int(u1, message_hash, hash_size, curve);
+    uECC_vli_modMult_n(u1, u1, z, curve);
+    if(!uECC_vli_isZero(u1, num_n_words))
+    {
+        uECC_vli_sub(u1, curve->n, u1, num_n_words);
+    }
+    uECC_vli_modMult_n(u2, s, z, curve);
+
+    EccPoint_odd_multiples(point_table[0], point, uECC_WNAF_POINT_TABLE_SIZE, curve);
+    EccPoint_mult_add_glv(X, Y, Z, u1, u2, point_table[0], curve);
+    if(uECC_vli_isZero(Z, num_words))
+    {
+        return false;
+    }
+
+    uECC_vli_modInv(Z, Z, curve->p, num_words);
+    apply_z(X, Y, Z, curve);
+
+    uECC_vli_nativeToBytes(public_key, curve->num_bytes, X);
+    uECC_vli_nativeToBytes(public_key + curve->num_bytes, curve->num_bytes, Y);
+
+    return true;
 }
 
 CTSBC_EcdsaSecp256k1::uECC_HashContext CTSBC_EcdsaSecp256k1::GetHashContextSha256(
@@ -1528,6 +2271,72 @@ bool CTSBC_EcdsaSecp256k1::Secp256k1_VerifySignature(
     return true;
 }
 
+bool CTSBC_EcdsaSecp256k1::Secp256k1_RecoverPublicKey(
+    const TArray<uint8>& Hash,
+    const TArray<uint8>& Signature,
+    TArray<uint8>& PublicKey)
+{
+    const uECC_Curve* curve = uECC_secp256k1();
+    if(Signature.Num() != curve->num_bytes * 2 + 1)
+    {
+        PublicKey.Empty();
+        return false;
+    }
+
+    PublicKey.SetNum(uECC_curve_public_key_size(curve));
+    if(!uECC_recover(Hash.GetData(), Hash.Num(), Signature.GetData(), PublicKey.GetData(), curve))
+    {
+        PublicKey.Empty();
+        return false;
+    }
+
+    if(!IsPublicKeyValid(PublicKey, curve))
+    {
+        PublicKey.Empty();
+        return false;
+    }
+
+    return true;
+}
+
+bool CTSBC_EcdsaSecp256k1::Secp256k1_VerifySignatureBatch(
+    const TArrayView<const FTSBC_Secp256k1SignatureToVerify> Signatures,
+    TBitArray<>& Results)
+{
+    const uECC_Curve* curve = uECC_secp256k1();
+    const int32 NumSignatures = Signatures.Num();
+    Results.Init(false, NumSignatures);
+    if(NumSignatures == 0)
+    {
+        return true;
+    }
+
+    // Every chunk shares its inversions and runs as one task on the task graph workers.
+    TArray<uint8> bIsValid;
+    bIsValid.SetNumZeroed(NumSignatures);
+    const int32 NumChunks = (NumSignatures + uECC_VERIFY_BATCH_CHUNK_SIZE - 1) / uECC_VERIFY_BATCH_CHUNK_SIZE;
+    ParallelFor(
+        NumChunks,
+        [&Signatures, &bIsValid, NumSignatures, curve](const int32 ChunkIndex)
+        {
+            const int32 First = ChunkIndex * uECC_VERIFY_BATCH_CHUNK_SIZE;
+            const int32 Count = FMath::Min(uECC_VERIFY_BATCH_CHUNK_SIZE, NumSignatures - First);
+            uECC_verify_batch(Signatures.GetData() + First, Count, bIsValid.GetData() + First, curve);
+        });
+
+    int32 NumValid = 0;
+    for(int32 i = 0; i < NumSignatures; ++i)
+    {
+        if(bIsValid[i])
+        {
+            Results[i] = true;
+            ++NumValid;
+        }
+    }
+
+    return NumValid == NumSignatures;
+}
+
 bool CTSBC_EcdsaSecp256k1::Secp256k1_CompressPublicKey(
     const TArray<uint8>& PublicKey,
     TArray<uint8>& CompressedPublicKey)
@@ -61,6 +61,17 @@ bool UTSBC_EncryptionFunctionLibrary::Secp256k1_VerifySignature(
         Signature);
 }
 
+bool UTSBC_EncryptionFunctionLibrary::Secp256k1_RecoverPublicKey(
+    const TArray<uint8>& Hash,
+    const TArray<uint8>& Signature,
+    TArray<uint8>& PublicKey)
+{
+    return CTSBC_EcdsaSecp256k1::Secp256k1_RecoverPublicKey(
+        Hash,
+        Signature,
+        PublicKey);
+}
+
 bool UTSBC_EncryptionFunctionLibrary::Secp256k1_CompressPublicKey(
     const TArray<uint8>& PublicKey,
     TArray<uint8>& CompressedPublicKey)
@@ -47,7 +47,10 @@ bool UTSBC_HashFunctionLibrary::ChecksumFromKeccak256(
     const FString KeccakHashLowercase = KeccakHash.ToLower();
 
     // Apply keccak256 algorithm on the ethereum address(without 0x prefix).
-    const FString ChecksumReference = Keccak256FromString(KeccakHashLowercase, false);
+    uint8 ChecksumReference[32];
+    CTSBC_Keccak256 Hasher;
+    Hasher.UpdateAnsi(KeccakHashLowercase);
+    Hasher.Final(ChecksumReference);
 
     // Check if the KeccakHashLowercase doesn't contain any non hex character.
     FString CalculatedChecksum = "";
@@ -65,10 +68,11 @@ bool UTSBC_HashFunctionLibrary::ChecksumFromKeccak256(
         if(CharSetHex.FindChar(CurrentCharacter, CharFoundAtIndex))
         {
             /**
-             * If the current ChecksumReference character is not in the CharSetChecksum
+             * If the current ChecksumReference nibble is 8 or higher (hex digit not in CharSetChecksumDigits)
              * make the character in CalculatedChecksum uppercased.
              */
-            if(!CharSetChecksumDigits.FindChar(ChecksumReference[i], CharFoundAtIndex))
+            const uint8 ReferenceNibble = i % 2 == 0 ? ChecksumReference[i / 2] >> 4 : ChecksumReference[i / 2] & 15;
+            if(ReferenceNibble >= 8)
             {
                 CalculatedChecksum.AppendChar(toupper(CurrentCharacter));
             }
@@ -289,6 +289,32 @@ FString CTSBC_Keccak256::GetHash()
     return Result;
 }
 
+void CTSBC_Keccak256::GetHash(uint8* OutHash)
+{
+    // Save hash state
+    uint64_t OldHash[StateSize];
+    for(unsigned int i = 0; i < StateSize; i++)
+    {
+        OldHash[i] = _Hash[i];
+    }
+
+    // Process remaining bytes
+    ProcessBuffer();
+
+    // The state words are stored little endian, Keccak224's last word provides only 32 bits
+    const unsigned int NumHashBytes = static_cast<uint32>(_Bits) / 8;
+    for(unsigned int i = 0; i < NumHashBytes; i++)
+    {
+        OutHash[i] = static_cast<uint8>(_Hash[i / 8] >> (8 * (i % 8)));
+    }
+
+    // Restore state
+    for(unsigned int i = 0; i < StateSize; i++)
+    {
+        _Hash[i] = OldHash[i];
+    }
+}
+
 FString CTSBC_Keccak256::KeccakFromString(const FString& Text, const bool& bIsHex)
 {
     Reset();
@@ -316,4 +342,29 @@ FString CTSBC_Keccak256::KeccakFromBytes(const TArray<uint8>& Bytes)
     Add(Bytes.GetData(), Bytes.Num());
 
     return GetHash();
+}
+
+void CTSBC_Keccak256::HashToBytes(const TArrayView<const uint8> Bytes, uint8* OutHash)
+{
+    Reset();
+    Add(Bytes.GetData(), Bytes.Num());
+
+    GetHash(OutHash);
+}
+
+void CTSBC_Keccak256::Update(const TArrayView<const uint8> Bytes)
+{
+    Add(Bytes.GetData(), Bytes.Num());
+}
+
+void CTSBC_Keccak256::UpdateAnsi(const FString& Text)
+{
+    const FTCHARToANSI Converter(*Text);
+    Add(Converter.Get(), Converter.Length());
+}
+
+void CTSBC_Keccak256::Final(uint8* OutHash)
+{
+    GetHash(OutHash);
+    Reset();
 }
\ No newline at end of file
@@ -0,0 +1,462 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "Crypto/Hash/TSBC_Keccak256Batch.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "HAL/IConsoleManager.h"
+#include "Misc/ByteSwap.h"
+// =============================================================================
+
+#include "Crypto/Hash/TSBC_Keccak256.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr int32 NumRounds = 24;
+
+    /**
+     * 1088 bits of each 1600 bit block carry message data for KECCAK-256.
+     */
+    constexpr int32 RateBytes = 136;
+
+    constexpr int32 NumStateWords = 25;
+
+    /**
+     * Limits of the benchmark arguments. The message buffer stays below 1 GiB, so sizes and offsets fit into int32.
+     */
+    constexpr int32 MaxBenchmarkMessages = 10000000;
+
+    constexpr int32 MaxBenchmarkMessageSize = 1024 * 1024;
+
+    constexpr int32 MaxBenchmarkDataBytes = 1024 * 1024 * 1024;
+
+    // @formatter:off
+    constexpr uint64 RoundConstants[NumRounds] =
+    {
+        0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+        0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+        0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+        0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+        0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+        0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+        0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+        0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+    };
+    // @formatter:on
+
+    /**
+     * One message at a time in 64 bit registers.
+     */
+    struct FScalarLanes
+    {
+        using FVector = uint64;
+        static constexpr int32 NumLanes = 1;
+        static constexpr const TCHAR* Name = TEXT("Scalar");
+
+        static FORCEINLINE FVector Load(const uint64* Words) { return *Words; }
+        static FORCEINLINE void Store(uint64* Words, const FVector V) { *Words = V; }
+        static FORCEINLINE FVector Splat(const uint64 Value) { return Value; }
+        static FORCEINLINE FVector Xor(const FVector A, const FVector B) { return A ^ B; }
+        static FORCEINLINE FVector AndNot(const FVector A, const FVector B) { return ~A & B; }
+        static FORCEINLINE FVector RotateLeft(const FVector A, const int32 N) { return (A << N) | (A >> (64 - N)); }
+    };
+
+#if defined(__AVX512F__)
+    struct FAvx512Lanes
+    {
+        using FVector = __m512i;
+        static constexpr int32 NumLanes = 8;
+        static constexpr const TCHAR* Name = TEXT("AVX-512");
+
+        static FORCEINLINE FVector Load(const uint64* Words) { return _mm512_load_si512(Words); }
+        static FORCEINLINE void Store(uint64* Words, const FVector V) { _mm512_store_si512(Words, V); }
+        static FORCEINLINE FVector Splat(const uint64 Value) { return _mm512_set1_epi64(static_cast<int64>(Value)); }
+        static FORCEINLINE FVector Xor(const FVector A, const FVector B) { return _mm512_xor_si512(A, B); }
+        static FORCEINLINE FVector AndNot(const FVector A, const FVector B) { return _mm512_andnot_si512(A, B); }
+        static FORCEINLINE FVector RotateLeft(const FVector A, const int32 N) { return _mm512_rolv_epi64(A, _mm512_set1_epi64(N)); }
+    };
+
+    using FBatchLanes = FAvx512Lanes;
+#elif defined(__AVX2__)
+    struct FAvx2Lanes
+    {
+        using FVector = __m256i;
+        static constexpr int32 NumLanes = 4;
+        static constexpr const TCHAR* Name = TEXT("AVX2");
+
+        static FORCEINLINE FVector Load(const uint64* Words) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(Words)); }
+        static FORCEINLINE void Store(uint64* Words, const FVector V) { _mm256_store_si256(reinterpret_cast<__m256i*>(Words), V); }
+        static FORCEINLINE FVector Splat(const uint64 Value) { return _mm256_set1_epi64x(static_cast<int64>(Value)); }
+        static FORCEINLINE FVector Xor(const FVector A, const FVector B) { return _mm256_xor_si256(A, B); }
+        static FORCEINLINE FVector AndNot(const FVector A, const FVector B) { return _mm256_andnot_si256(A, B); }
+
+        static FORCEINLINE FVector RotateLeft(const FVector A, const int32 N)
+        {
+            return _mm256_or_si256(_mm256_slli_epi64(A, N), _mm256_srli_epi64(A, 64 - N));
+        }
+    };
+
+    using FBatchLanes = FAvx2Lanes;
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+    struct FNeonLanes
+    {
+        using FVector = uint64x2_t;
+        static constexpr int32 NumLanes = 2;
+        static constexpr const TCHAR* Name = TEXT("NEON");
+
+        static FORCEINLINE FVector Load(const uint64* Words) { return vld1q_u64(Words); }
+        static FORCEINLINE void Store(uint64* Words, const FVector V) { vst1q_u64(Words, V); }
+        static FORCEINLINE FVector Splat(const uint64 Value) { return vdupq_n_u64(Value); }
+        static FORCEINLINE FVector Xor(const FVector A, const FVector B) { return veorq_u64(A, B); }
+        static FORCEINLINE FVector AndNot(const FVector A, const FVector B) { return vbicq_u64(B, A); }
+
+        static FORCEINLINE FVector RotateLeft(const FVector A, const int32 N)
+        {
+            // Negative counts shift right
+            return vorrq_u64(vshlq_u64(A, vdupq_n_s64(N)), vshlq_u64(A, vdupq_n_s64(N - 64)));
+        }
+    };
+
+    using FBatchLanes = FNeonLanes;
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+    struct FSse2Lanes
+    {
+        using FVector = __m128i;
+        static constexpr int32 NumLanes = 2;
+        static constexpr const TCHAR* Name = TEXT("SSE2");
+
+        static FORCEINLINE FVector Load(const uint64* Words) { return _mm_load_si128(reinterpret_cast<const __m128i*>(Words)); }
+        static FORCEINLINE void Store(uint64* Words, const FVector V) { _mm_store_si128(reinterpret_cast<__m128i*>(Words), V); }
+        static FORCEINLINE FVector Splat(const uint64 Value) { return _mm_set1_epi64x(static_cast<int64>(Value)); }
+        static FORCEINLINE FVector Xor(const FVector A, const FVector B) { return _mm_xor_si128(A, B); }
+        static FORCEINLINE FVector AndNot(const FVector A, const FVector B) { return _mm_andnot_si128(A, B); }
+
+        static FORCEINLINE FVector RotateLeft(const FVector A, const int32 N)
+        {
+            return _mm_or_si128(_mm_slli_epi64(A, N), _mm_srli_epi64(A, 64 - N));
+        }
+    };
+
+    using FBatchLanes = FSse2Lanes;
+#else
+    using FBatchLanes = FScalarLanes;
+#endif
+
+    /**
+     * XOR of the five words of a column.
+     */
+    template<typename TLanes>
+    FORCEINLINE typename TLanes::FVector XorColumn(const typename TLanes::FVector* A, const int32 x)
+    {
+        return TLanes::Xor(TLanes::Xor(TLanes::Xor(A[x], A[x + 5]), TLanes::Xor(A[x + 10], A[x + 15])), A[x + 20]);
+    }
+
+    /**
+     * Chi step on the row starting at word y.
+     */
+    template<typename TLanes>
+    FORCEINLINE void ChiRow(typename TLanes::FVector* A, const typename TLanes::FVector* B, const int32 y)
+    {
+        A[y + 0] = TLanes::Xor(B[y + 0], TLanes::AndNot(B[y + 1], B[y + 2]));
+        A[y + 1] = TLanes::Xor(B[y + 1], TLanes::AndNot(B[y + 2], B[y + 3]));
+        A[y + 2] = TLanes::Xor(B[y + 2], TLanes::AndNot(B[y + 3], B[y + 4]));
+        A[y + 3] = TLanes::Xor(B[y + 3], TLanes::AndNot(B[y + 4], B[y + 0]));
+        A[y + 4] = TLanes::Xor(B[y + 4], TLanes::AndNot(B[y + 0], B[y + 1]));
+    }
+
+    /**
+     * Runs Keccak-f[1600] on all lanes. State word i of lane j is stored at State[i * NumLanes + j].
+     * The steps are written out, so that every rotation has a constant count.
+     */
+    template<typename TLanes>
+    void Permute(uint64* State)
+    {
+        using FVector = typename TLanes::FVector;
+
+        FVector A[NumStateWords];
+        for(int32 i = 0; i < NumStateWords; i++)
+        {
+            A[i] = TLanes::Load(State + i * TLanes::NumLanes);
+        }
+
+        for(int32 Round = 0; Round < NumRounds; Round++)
+        {
+            // Theta
+            const FVector C0 = XorColumn<TLanes>(A, 0);
+            const FVector C1 = XorColumn<TLanes>(A, 1);
+            const FVector C2 = XorColumn<TLanes>(A, 2);
+            const FVector C3 = XorColumn<TLanes>(A, 3);
+            const FVector C4 = XorColumn<TLanes>(A, 4);
+
+            const FVector D0 = TLanes::Xor(C4, TLanes::RotateLeft(C1, 1));
+            const FVector D1 = TLanes::Xor(C0, TLanes::RotateLeft(C2, 1));
+            const FVector D2 = TLanes::Xor(C1, TLanes::RotateLeft(C3, 1));
+            const FVector D3 = TLanes::Xor(C2, TLanes::RotateLeft(C4, 1));
+            const FVector D4 = TLanes::Xor(C3, TLanes::RotateLeft(C0, 1));
+
+            // Rho Pi: word x + 5 * y is rotated and moves to y + 5 * ((2 * x + 3 * y) % 5)
+            // @formatter:off
+            FVector B[NumStateWords];
+            B[ 0] =                    TLanes::Xor(A[ 0], D0);
+            B[10] = TLanes::RotateLeft(TLanes::Xor(A[ 1], D1),  1);
+            B[20] = TLanes::RotateLeft(TLanes::Xor(A[ 2], D2), 62);
+            B[ 5] = TLanes::RotateLeft(TLanes::Xor(A[ 3], D3), 28);
+            B[15] = TLanes::RotateLeft(TLanes::Xor(A[ 4], D4), 27);
+            B[16] = TLanes::RotateLeft(TLanes::Xor(A[ 5], D0), 36);
+            B[ 1] = TLanes::RotateLeft(TLanes::Xor(A[ 6], D1), 44);
+            B[11] = TLanes::RotateLeft(TLanes::Xor(A[ 7], D2),  6);
+            B[21] = TLanes::RotateLeft(TLanes::Xor(A[ 8], D3), 55);
+            B[ 6] = TLanes::RotateLeft(TLanes::Xor(A[ 9], D4), 20);
+            B[ 7] = TLanes::RotateLeft(TLanes::Xor(A[10], D0),  3);
+            B[17] = TLanes::RotateLeft(TLanes::Xor(A[11], D1), 10);
+            B[ 2] = TLanes::RotateLeft(TLanes::Xor(A[12], D2), 43);
+            B[12] = TLanes::RotateLeft(TLanes::Xor(A[13], D3), 25);
+            B[22] = TLanes::RotateLeft(TLanes::Xor(A[14], D4), 39);
+            B[23] = TLanes::RotateLeft(TLanes::Xor(A[15], D0), 41);
+            B[ 8] = TLanes::RotateLeft(TLanes::Xor(A[16], D1), 45);
+            B[18] = TLanes::RotateLeft(TLanes::Xor(A[17], D2), 15);
+            B[ 3] = TLanes::RotateLeft(TLanes::Xor(A[18], D3), 21);
+            B[13] = TLanes::RotateLeft(TLanes::Xor(A[19], D4),  8);
+            B[14] = TLanes::RotateLeft(TLanes::Xor(A[20], D0), 18);
+            B[24] = TLanes::RotateLeft(TLanes::Xor(A[21], D1),  2);
+            B[ 9] = TLanes::RotateLeft(TLanes::Xor(A[22], D2), 61);
+            B[19] = TLanes::RotateLeft(TLanes::Xor(A[23], D3), 56);
+            B[ 4] = TLanes::RotateLeft(TLanes::Xor(A[24], D4), 14);
+            // @formatter:on
+
+            // Chi
+            ChiRow<TLanes>(A, B, 0);
+            ChiRow<TLanes>(A, B, 5);
+            ChiRow<TLanes>(A, B, 10);
+            ChiRow<TLanes>(A, B, 15);
+            ChiRow<TLanes>(A, B, 20);
+
+            // Iota
+            A[0] = TLanes::Xor(A[0], TLanes::Splat(RoundConstants[Round]));
+        }
+
+        for(int32 i = 0; i < NumStateWords; i++)
+        {
+            TLanes::Store(State + i * TLanes::NumLanes, A[i]);
+        }
+    }
+
+    /**
+     * Hashes all messages, each lane taking the next message as soon as its current one is finished.
+     */
+    template<typename TLanes>
+    void HashLanes(const TArrayView<const TArrayView<const uint8>> Messages, uint8* OutHashes)
+    {
+        constexpr int32 NumLanes = TLanes::NumLanes;
+
+        alignas(64) uint64 State[NumStateWords * NumLanes];
+
+        // Message and read offset per lane, INDEX_NONE once there are no messages left
+        int32 LaneMessages[NumLanes];
+        int32 LaneOffsets[NumLanes];
+
+        int32 NextMessage = 0;
+        int32 NumActiveLanes = 0;
+
+        const auto AssignNextMessage = [&](const int32 Lane)
+        {
+            LaneMessages[Lane] = NextMessage < Messages.Num() ? NextMessage++ : INDEX_NONE;
+            LaneOffsets[Lane] = 0;
+            NumActiveLanes += LaneMessages[Lane] != INDEX_NONE ? 1 : 0;
+
+            for(int32 i = 0; i < NumStateWords; i++)
+            {
+                State[i * NumLanes + Lane] = 0;
+            }
+        };
+
+        for(int32 Lane = 0; Lane < NumLanes; Lane++)
+        {
+            AssignNextMessage(Lane);
+        }
+
+        while(NumActiveLanes > 0)
+        {
+            bool bIsFinalBlock[NumLanes];
+
+            // Absorb the next block of every lane
+            for(int32 Lane = 0; Lane < NumLanes; Lane++)
+            {
+                bIsFinalBlock[Lane] = false;
+                if(LaneMessages[Lane] == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const TArrayView<const uint8>& Message = Messages[LaneMessages[Lane]];
+                const int32 NumRemainingBytes = Message.Num() - LaneOffsets[Lane];
+
+                uint8 PaddedBlock[RateBytes];
+                const uint8* Block = Message.GetData() + LaneOffsets[Lane];
+
+                if(NumRemainingBytes < RateBytes)
+                {
+                    // The last block is padded with 0x01 ... 0x80, even if it holds no message bytes at all
+                    FMemory::Memzero(PaddedBlock, RateBytes);
+                    if(NumRemainingBytes > 0)
+                    {
+                        FMemory::Memcpy(PaddedBlock, Block, NumRemainingBytes);
+                    }
+                    PaddedBlock[NumRemainingBytes] ^= 0x01;
+                    PaddedBlock[RateBytes - 1] ^= 0x80;
+
+                    Block = PaddedBlock;
+                    bIsFinalBlock[Lane] = true;
+                }
+
+                LaneOffsets[Lane] += RateBytes;
+
+                for(int32 i = 0; i < RateBytes / 8; i++)
+                {
+                    uint64 Word;
+                    FMemory::Memcpy(&Word, Block + 8 * i, 8);
+                    State[i * NumLanes + Lane] ^= INTEL_ORDER64(Word);
+                }
+            }
+
+            Permute<TLanes>(State);
+
+            // Squeeze finished lanes and refill them
+            for(int32 Lane = 0; Lane < NumLanes; Lane++)
+            {
+                if(!bIsFinalBlock[Lane])
+                {
+                    continue;
+                }
+
+                uint8* Hash = OutHashes + LaneMessages[Lane] * CTSBC_Keccak256Batch::HashSize;
+                for(int32 i = 0; i < CTSBC_Keccak256Batch::HashSize / 8; i++)
+                {
+                    const uint64 Word = INTEL_ORDER64(State[i * NumLanes + Lane]);
+                    FMemory::Memcpy(Hash + 8 * i, &Word, 8);
+                }
+
+                NumActiveLanes--;
+                AssignNextMessage(Lane);
+            }
+        }
+    }
+
+    void RunBenchmarkCommand(const TArray<FString>& Args)
+    {
+        const int32 NumMessages = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+        const int32 MessageSize = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 64;
+
+        const FTSBC_Keccak256BenchmarkResult Result = CTSBC_Keccak256Batch::Benchmark(NumMessages, MessageSize);
+
+        TSBC_LOG(
+            Display,
+            TEXT("KECCAK-256 %d x %d bytes: %s (%d lanes) %.1f MB/s, %.0f hashes/s; scalar %.1f MB/s, %.0f hashes/s"),
+            Result.NumMessages,
+            Result.MessageSize,
+            Result.InstructionSet,
+            Result.NumLanes,
+            Result.BatchMegabytesPerSecond,
+            Result.BatchHashesPerSecond,
+            Result.ScalarMegabytesPerSecond,
+            Result.ScalarHashesPerSecond);
+
+        TSBC_LOG_COND(!Result.bHashesMatch, Error, TEXT("KECCAK-256 batch and scalar hashes differ"));
+    }
+
+    FAutoConsoleCommand Keccak256BenchmarkCommand(
+        TEXT("TSBC.Keccak256Benchmark"),
+        TEXT("Measures batch KECCAK-256 throughput. Arguments: [NumMessages] [MessageSize]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmarkCommand));
+}
+
+void CTSBC_Keccak256Batch::Hash(const TArrayView<const TArrayView<const uint8>> Messages, uint8* OutHashes)
+{
+    // A single message gains nothing from idle lanes
+    if(Messages.Num() < 2)
+    {
+        HashLanes<FScalarLanes>(Messages, OutHashes);
+        return;
+    }
+
+    HashLanes<FBatchLanes>(Messages, OutHashes);
+}
+
+int32 CTSBC_Keccak256Batch::GetNumLanes()
+{
+    return FBatchLanes::NumLanes;
+}
+
+const TCHAR* CTSBC_Keccak256Batch::GetInstructionSet()
+{
+    return FBatchLanes::Name;
+}
+
+FTSBC_Keccak256BenchmarkResult CTSBC_Keccak256Batch::Benchmark(const int32 NumMessages, const int32 MessageSize)
+{
+    FTSBC_Keccak256BenchmarkResult Result;
+    Result.InstructionSet = GetInstructionSet();
+    Result.NumLanes = GetNumLanes();
+    Result.NumMessages = FMath::Clamp(NumMessages, 1, MaxBenchmarkMessages);
+    Result.MessageSize = FMath::Clamp(MessageSize, 0, MaxBenchmarkMessageSize);
+
+    // Computed in 64 bits, since both clamped arguments together may still exceed the buffer limit
+    if(static_cast<int64>(Result.NumMessages) * Result.MessageSize > MaxBenchmarkDataBytes)
+    {
+        Result.NumMessages = MaxBenchmarkDataBytes / Result.MessageSize;
+    }
+
+    // All messages live in one buffer filled with pseudo-random bytes
+    TArray<uint8> Data;
+    Data.SetNumUninitialized(Result.NumMessages * Result.MessageSize);
+
+    FRandomStream Random(Result.NumMessages ^ Result.MessageSize);
+    for(uint8& Byte : Data)
+    {
+        Byte = static_cast<uint8>(Random.RandHelper(256));
+    }
+
+    TArray<TArrayView<const uint8>> Messages;
+    Messages.Reserve(Result.NumMessages);
+    for(int32 i = 0; i < Result.NumMessages; i++)
+    {
+        Messages.Add(TArrayView<const uint8>(Data.GetData() + i * Result.MessageSize, Result.MessageSize));
+    }
+
+    TArray<uint8> BatchHashes;
+    BatchHashes.SetNumUninitialized(Result.NumMessages * HashSize);
+    TArray<uint8> ScalarHashes;
+    ScalarHashes.SetNumUninitialized(Result.NumMessages * HashSize);
+
+    const double BatchStart = FPlatformTime::Seconds();
+    Hash(Messages, BatchHashes.GetData());
+    const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+    const double ScalarStart = FPlatformTime::Seconds();
+    CTSBC_Keccak256 Hasher;
+    for(int32 i = 0; i < Result.NumMessages; i++)
+    {
+        Hasher.HashToBytes(Messages[i], ScalarHashes.GetData() + i * HashSize);
+    }
+    const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+    const double NumMegabytes = static_cast<double>(Data.Num()) / (1024.0 * 1024.0);
+    const double MinSeconds = 1e-9;
+
+    Result.BatchMegabytesPerSecond = NumMegabytes / FMath::Max(BatchSeconds, MinSeconds);
+    Result.BatchHashesPerSecond = Result.NumMessages / FMath::Max(BatchSeconds, MinSeconds);
+    Result.ScalarMegabytesPerSecond = NumMegabytes / FMath::Max(ScalarSeconds, MinSeconds);
+    Result.ScalarHashesPerSecond = Result.NumMessages / FMath::Max(ScalarSeconds, MinSeconds);
+    Result.bHashesMatch = BatchHashes == ScalarHashes;
+
+    return Result;
+}
\ No newline at end of file
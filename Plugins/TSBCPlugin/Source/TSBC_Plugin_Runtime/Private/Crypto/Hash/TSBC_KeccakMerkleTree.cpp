@@ -0,0 +1,342 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "Crypto/Hash/TSBC_KeccakMerkleTree.h"
+
+#include "Crypto/Hash/TSBC_Keccak256Batch.h"
+
+// These includes are needed to prevent plugin build failures.
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    /**
+     * Number of hashes per task when hashing leaves or building a level.
+     */
+    constexpr int32 MerkleChunkSize = 2048;
+
+    /**
+     * File header: magic, version, number of leaves.
+     */
+    constexpr uint32 MerkleFileMagic = 0x544D5354; // "TSMT"
+    constexpr uint32 MerkleFileVersion = 1;
+    constexpr int32 MerkleFileHeaderSize = 12;
+
+    void AppendUint32(TArray<uint8>& Data, const uint32 Value)
+    {
+        for(int32 i = 0; i < 4; i++)
+        {
+            Data.Add(static_cast<uint8>(Value >> (8 * i)));
+        }
+    }
+
+    uint32 ReadUint32(const uint8* Data)
+    {
+        return Data[0] | Data[1] << 8 | Data[2] << 16 | static_cast<uint32>(Data[3]) << 24;
+    }
+
+    int32 ToNibble(const TCHAR Character)
+    {
+        if(Character >= '0' && Character <= '9')
+        {
+            return Character - '0';
+        }
+
+        if(Character >= 'a' && Character <= 'f')
+        {
+            return Character - 'a' + 10;
+        }
+
+        if(Character >= 'A' && Character <= 'F')
+        {
+            return Character - 'A' + 10;
+        }
+
+        return -1;
+    }
+
+    /**
+     * Runs Function(First, Count) for consecutive chunks of NumItems, in parallel if there is more than one chunk.
+     */
+    template <typename FunctionType>
+    void ForEachChunk(const int32 NumItems, const FunctionType& Function)
+    {
+        const int32 NumChunks = (NumItems + MerkleChunkSize - 1) / MerkleChunkSize;
+        ParallelFor(
+            NumChunks,
+            [NumItems, &Function](const int32 ChunkIndex)
+            {
+                const int32 First = ChunkIndex * MerkleChunkSize;
+                Function(First, FMath::Min(MerkleChunkSize, NumItems - First));
+            },
+            NumChunks < 2);
+    }
+}
+
+FString FTSBC_Keccak256Hash::ToHexString() const
+{
+    return TEXT("0x") + BytesToHex(Bytes, sizeof(Bytes)).ToLower();
+}
+
+bool FTSBC_Keccak256Hash::FromHexString(const FString& HexString, FTSBC_Keccak256Hash& OutHash)
+{
+    constexpr int32 NumBytes = sizeof(Bytes);
+    const int32 Start = HexString.StartsWith(TEXT("0x")) ? 2 : 0;
+    if(HexString.Len() - Start != 2 * NumBytes)
+    {
+        return false;
+    }
+
+    for(int32 i = 0; i < NumBytes; i++)
+    {
+        const int32 High = ToNibble(HexString[Start + 2 * i]);
+        const int32 Low = ToNibble(HexString[Start + 2 * i + 1]);
+        if(High < 0 || Low < 0)
+        {
+            return false;
+        }
+
+        OutHash.Bytes[i] = static_cast<uint8>(High << 4 | Low);
+    }
+
+    return true;
+}
+
+void CTSBC_KeccakMerkleTree::BuildFromLeaves(const TArrayView<const FTSBC_Keccak256Hash> Leaves)
+{
+    Nodes.Reset();
+    Nodes.Append(Leaves.GetData(), Leaves.Num());
+    BuildLevels(Leaves.Num());
+}
+
+void CTSBC_KeccakMerkleTree::BuildFromLeafData(const TArrayView<const TArrayView<const uint8>> LeafData)
+{
+    const int32 NumLeaves = LeafData.Num();
+    Nodes.SetNumUninitialized(NumLeaves);
+
+    FTSBC_Keccak256Hash* Leaves = Nodes.GetData();
+    ForEachChunk(
+        NumLeaves,
+        [&LeafData, Leaves](const int32 First, const int32 Count)
+        {
+            CTSBC_Keccak256Batch::Hash(LeafData.Slice(First, Count), Leaves[First].Bytes);
+        });
+
+    BuildLevels(NumLeaves);
+}
+
+void CTSBC_KeccakMerkleTree::Reset()
+{
+    Nodes.Empty();
+    LevelOffsets.Empty();
+}
+
+int32 CTSBC_KeccakMerkleTree::GetNumLeaves() const
+{
+    return LevelOffsets.Num() > 0 ? LevelOffsets[1] : 0;
+}
+
+const FTSBC_Keccak256Hash& CTSBC_KeccakMerkleTree::GetLeaf(const int32 LeafIndex) const
+{
+    check(LeafIndex >= 0 && LeafIndex < GetNumLeaves());
+    return Nodes[LeafIndex];
+}
+
+FTSBC_Keccak256Hash CTSBC_KeccakMerkleTree::GetRoot() const
+{
+    return Nodes.Num() > 0 ? Nodes.Last() : FTSBC_Keccak256Hash();
+}
+
+bool CTSBC_KeccakMerkleTree::GetProof(const int32 LeafIndex, TArray<FTSBC_Keccak256Hash>& OutProof) const
+{
+    OutProof.Reset();
+    if(LeafIndex < 0 || LeafIndex >= GetNumLeaves())
+    {
+        return false;
+    }
+
+    int32 Index = LeafIndex;
+    for(int32 Level = 0; Level < LevelOffsets.Num() - 2; Level++)
+    {
+        const int32 LevelSize = LevelOffsets[Level + 1] - LevelOffsets[Level];
+        const int32 SiblingIndex = Index ^ 1;
+
+        // The last node of an odd level has no sibling and moves up unchanged
+        if(SiblingIndex < LevelSize)
+        {
+            OutProof.Add(Nodes[LevelOffsets[Level] + SiblingIndex]);
+        }
+
+        Index /= 2;
+    }
+
+    return true;
+}
+
+bool CTSBC_KeccakMerkleTree::GetProofAsHex(const int32 LeafIndex, TArray<FString>& OutProof) const
+{
+    OutProof.Reset();
+
+    TArray<FTSBC_Keccak256Hash> Proof;
+    if(!GetProof(LeafIndex, Proof))
+    {
+        return false;
+    }
+
+    for(const FTSBC_Keccak256Hash& Hash : Proof)
+    {
+        OutProof.Add(Hash.ToHexString());
+    }
+
+    return true;
+}
+
+bool CTSBC_KeccakMerkleTree::VerifyProof(
+    const TArrayView<const FTSBC_Keccak256Hash> Proof,
+    const FTSBC_Keccak256Hash& Root,
+    const FTSBC_Keccak256Hash& Leaf)
+{
+    FTSBC_Keccak256Hash Hash = Leaf;
+    for(const FTSBC_Keccak256Hash& Sibling : Proof)
+    {
+        Hash = HashPair(Hash, Sibling);
+    }
+
+    return Hash == Root;
+}
+
+FTSBC_Keccak256Hash CTSBC_KeccakMerkleTree::HashPair(const FTSBC_Keccak256Hash& A, const FTSBC_Keccak256Hash& B)
+{
+    const bool bInOrder = FMemory::Memcmp(A.Bytes, B.Bytes, sizeof(A.Bytes)) <= 0;
+
+    uint8 Pair[64];
+    FMemory::Memcpy(Pair, bInOrder ? A.Bytes : B.Bytes, 32);
+    FMemory::Memcpy(Pair + 32, bInOrder ? B.Bytes : A.Bytes, 32);
+
+    FTSBC_Keccak256Hash Hash;
+    const TArrayView<const uint8> Message(Pair, sizeof(Pair));
+    CTSBC_Keccak256Batch::Hash(TArrayView<const TArrayView<const uint8>>(&Message, 1), Hash.Bytes);
+
+    return Hash;
+}
+
+bool CTSBC_KeccakMerkleTree::SaveToFile(const FString& Filename) const
+{
+    const int32 NumLeaves = GetNumLeaves();
+
+    TArray<uint8> Data;
+    Data.Reserve(MerkleFileHeaderSize + (NumLeaves + 1) * sizeof(FTSBC_Keccak256Hash));
+    AppendUint32(Data, MerkleFileMagic);
+    AppendUint32(Data, MerkleFileVersion);
+    AppendUint32(Data, static_cast<uint32>(NumLeaves));
+    Data.Append(GetRoot().Bytes, sizeof(FTSBC_Keccak256Hash));
+    Data.Append(reinterpret_cast<const uint8*>(Nodes.GetData()), NumLeaves * sizeof(FTSBC_Keccak256Hash));
+
+    return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool CTSBC_KeccakMerkleTree::LoadFromFile(const FString& Filename, FString& OutErrorMessage)
+{
+    Reset();
+
+    TArray<uint8> Data;
+    if(!FFileHelper::LoadFileToArray(Data, *Filename))
+    {
+        OutErrorMessage = FString::Printf(TEXT("Could not read %s"), *Filename);
+        return false;
+    }
+
+    if(Data.Num() < MerkleFileHeaderSize
+        || ReadUint32(Data.GetData()) != MerkleFileMagic
+        || ReadUint32(Data.GetData() + 4) != MerkleFileVersion)
+    {
+        OutErrorMessage = FString::Printf(TEXT("%s is not a Merkle tree file of version %d"), *Filename, MerkleFileVersion);
+        return false;
+    }
+
+    const int64 NumLeaves = ReadUint32(Data.GetData() + 8);
+    if(Data.Num() != MerkleFileHeaderSize + (NumLeaves + 1) * static_cast<int64>(sizeof(FTSBC_Keccak256Hash)))
+    {
+        OutErrorMessage = FString::Printf(TEXT("%s does not have the expected size"), *Filename);
+        return false;
+    }
+
+    FTSBC_Keccak256Hash StoredRoot;
+    FMemory::Memcpy(StoredRoot.Bytes, Data.GetData() + MerkleFileHeaderSize, sizeof(StoredRoot.Bytes));
+
+    const FTSBC_Keccak256Hash* Leaves = reinterpret_cast<const FTSBC_Keccak256Hash*>(
+        Data.GetData() + MerkleFileHeaderSize + sizeof(FTSBC_Keccak256Hash));
+    BuildFromLeaves(TArrayView<const FTSBC_Keccak256Hash>(Leaves, static_cast<int32>(NumLeaves)));
+
+    if(GetRoot() != StoredRoot)
+    {
+        Reset();
+        OutErrorMessage = FString::Printf(TEXT("%s is corrupted, the root does not match the leaves"), *Filename);
+        return false;
+    }
+
+    return true;
+}
+
+void CTSBC_KeccakMerkleTree::BuildLevels(const int32 NumLeaves)
+{
+    LevelOffsets.Reset();
+    if(NumLeaves == 0)
+    {
+        Nodes.Reset();
+        return;
+    }
+
+    // Every level has half as many nodes as the one below, rounded up
+    int32 NumNodes = 0;
+    for(int32 LevelSize = NumLeaves; ; LevelSize = (LevelSize + 1) / 2)
+    {
+        LevelOffsets.Add(NumNodes);
+        NumNodes += LevelSize;
+        if(LevelSize == 1)
+        {
+            break;
+        }
+    }
+    LevelOffsets.Add(NumNodes);
+
+    Nodes.SetNumUninitialized(NumNodes);
+
+    for(int32 Level = 0; Level < LevelOffsets.Num() - 2; Level++)
+    {
+        const FTSBC_Keccak256Hash* Children = Nodes.GetData() + LevelOffsets[Level];
+        FTSBC_Keccak256Hash* Parents = Nodes.GetData() + LevelOffsets[Level + 1];
+        const int32 NumChildren = LevelOffsets[Level + 1] - LevelOffsets[Level];
+        const int32 NumPairs = NumChildren / 2;
+
+        ForEachChunk(
+            NumPairs,
+            [Children, Parents](const int32 First, const int32 Count)
+            {
+                // Sorted pairs, laid out one after another so they can be hashed as a batch
+                TArray<uint8> Pairs;
+                Pairs.SetNumUninitialized(Count * 64);
+                TArray<TArrayView<const uint8>> Messages;
+                Messages.SetNumUninitialized(Count);
+
+                for(int32 i = 0; i < Count; i++)
+                {
+                    const FTSBC_Keccak256Hash& A = Children[2 * (First + i)];
+                    const FTSBC_Keccak256Hash& B = Children[2 * (First + i) + 1];
+                    const bool bInOrder = FMemory::Memcmp(A.Bytes, B.Bytes, sizeof(A.Bytes)) <= 0;
+
+                    uint8* Pair = Pairs.GetData() + 64 * i;
+                    FMemory::Memcpy(Pair, bInOrder ? A.Bytes : B.Bytes, 32);
+                    FMemory::Memcpy(Pair + 32, bInOrder ? B.Bytes : A.Bytes, 32);
+                    Messages[i] = TArrayView<const uint8>(Pair, 64);
+                }
+
+                CTSBC_Keccak256Batch::Hash(Messages, Parents[First].Bytes);
+            });
+
+        if(NumChildren % 2 != 0)
+        {
+            Parents[NumPairs] = Children[NumChildren - 1];
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,1345 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "Encoding/TSBC_CompiledContractAbi.h"
+
+#include "Crypto/Hash/TSBC_Keccak256.h"
+#include "Encoding/TSBC_ContractAbiHelper.h"
+#include "Math/TSBC_uint256.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
+
+namespace
+{
+    /**
+     * @returns The size of a type like "uint256" or "bytes32", or 0 if the digits are empty or not a number.
+     */
+    int32 ParseCompiledAbiTypeSize(const FString& Digits)
+    {
+        if(Digits.IsEmpty() || Digits.Len() > 3)
+        {
+            return 0;
+        }
+
+        for(const TCHAR Char : Digits)
+        {
+            if(!FChar::IsDigit(Char))
+            {
+                return 0;
+            }
+        }
+
+        return FCString::Atoi(*Digits);
+    }
+
+    /**
+     * @returns The selector as big-endian uint32.
+     */
+    uint32 MakeCompiledAbiSelectorKey(const uint8* Selector)
+    {
+        return static_cast<uint32>(Selector[0]) << 24 | static_cast<uint32>(Selector[1]) << 16 |
+            static_cast<uint32>(Selector[2]) << 8 | static_cast<uint32>(Selector[3]);
+    }
+
+    /**
+     * Reads an offset or a length.
+     *
+     * @param Data The encoded data.
+     * @param Position Index of the word's first byte.
+     * @param OutValue The value of the word.
+     * @returns False if the word is out of bounds or its value does not fit into int32.
+     */
+    bool ReadCompiledAbiLength(const TArrayView<const uint8> Data, const int32 Position, int32& OutValue)
+    {
+        if(Position < 0 || Position > Data.Num() - AbiSegmentBytesLength)
+        {
+            return false;
+        }
+
+        const uint8* Word = Data.GetData() + Position;
+        for(int32 i = 0; i < AbiSegmentBytesLength - 4; i++)
+        {
+            if(Word[i] != 0)
+            {
+                return false;
+            }
+        }
+
+        const uint32 Value = static_cast<uint32>(Word[AbiSegmentBytesLength - 4]) << 24 |
+            static_cast<uint32>(Word[AbiSegmentBytesLength - 3]) << 16 |
+            static_cast<uint32>(Word[AbiSegmentBytesLength - 2]) << 8 |
+            static_cast<uint32>(Word[AbiSegmentBytesLength - 1]);
+        if(Value > static_cast<uint32>(MAX_int32))
+        {
+            return false;
+        }
+
+        OutValue = static_cast<int32>(Value);
+        return true;
+    }
+
+    /**
+     * Reads an offset and resolves it to a position in the data.
+     *
+     * @param Base Index of the byte the offset is relative to.
+     * @returns False if the offset cannot be read or points beyond the data.
+     */
+    bool ReadCompiledAbiOffset(
+        const TArrayView<const uint8> Data,
+        const int32 Position,
+        const int32 Base,
+        int32& OutPosition)
+    {
+        int32 Offset;
+        if(!ReadCompiledAbiLength(Data, Position, Offset) || static_cast<int64>(Base) + Offset > Data.Num())
+        {
+            return false;
+        }
+
+        OutPosition = Base + Offset;
+        return true;
+    }
+
+    /**
+     * Writes an offset or a length into the low bytes of a zeroed word.
+     */
+    void WriteCompiledAbiLength(const int32 Value, uint8* Word)
+    {
+        Word[AbiSegmentBytesLength - 4] = static_cast<uint8>(Value >> 24);
+        Word[AbiSegmentBytesLength - 3] = static_cast<uint8>(Value >> 16);
+        Word[AbiSegmentBytesLength - 2] = static_cast<uint8>(Value >> 8);
+        Word[AbiSegmentBytesLength - 1] = static_cast<uint8>(Value);
+    }
+
+    /**
+     * @returns Number of bytes of whole words taking the given number of bytes.
+     */
+    int32 GetCompiledAbiPaddedLength(const int32 NumBytes)
+    {
+        return FMath::DivideAndRoundUp(NumBytes, AbiSegmentBytesLength) * AbiSegmentBytesLength;
+    }
+
+    /**
+     * @returns The hex digits of a value, without surrounding whitespace and "0x" prefix.
+     */
+    FStringView GetCompiledAbiHexDigits(const FString& Value)
+    {
+        FStringView Digits = FStringView(Value).TrimStartAndEnd();
+        if(Digits.StartsWith(TEXT("0x")))
+        {
+            Digits.RightChopInline(2);
+        }
+
+        return Digits;
+    }
+
+    /**
+     * Converts an even number of hex digits to bytes.
+     *
+     * @returns False if a character is not a hex digit.
+     */
+    bool ParseCompiledAbiHexDigits(const FStringView Digits, uint8* Bytes)
+    {
+        for(int32 i = 0; i + 1 < Digits.Len(); i += 2)
+        {
+            if(!FChar::IsHexDigit(Digits[i]) || !FChar::IsHexDigit(Digits[i + 1]))
+            {
+                return false;
+            }
+
+            Bytes[i / 2] = static_cast<uint8>(FParse::HexDigit(Digits[i]) << 4 | FParse::HexDigit(Digits[i + 1]));
+        }
+
+        return true;
+    }
+
+    /**
+     * @returns The bytes in hex, prefixed with "0x".
+     */
+    FString MakeCompiledAbiHex(const TArrayView<const uint8> Bytes)
+    {
+        static const TCHAR* HexDigits = TEXT("0123456789abcdef");
+
+        FString Hex;
+        TArray<TCHAR>& Chars = Hex.GetCharArray();
+        Chars.SetNumUninitialized(2 + Bytes.Num() * 2 + 1);
+        Chars[0] = TEXT('0');
+        Chars[1] = TEXT('x');
+        for(int32 i = 0; i < Bytes.Num(); i++)
+        {
+            Chars[2 + i * 2] = HexDigits[Bytes[i] >> 4];
+            Chars[3 + i * 2] = HexDigits[Bytes[i] & 0x0f];
+        }
+        Chars.Last() = TEXT('\0');
+
+        return Hex;
+    }
+
+    /**
+     * @returns Number of bytes the encoding of a value which is not a tuple or an array takes.
+     */
+    int32 MeasureCompiledAbiElement(const FTSBC_AbiTypePlan& Plan, const FString& Value)
+    {
+        switch(Plan.Kind)
+        {
+        case ETSBC_AbiTypeKind::Bytes:
+            return AbiSegmentBytesLength + GetCompiledAbiPaddedLength(GetCompiledAbiHexDigits(Value).Len() / 2);
+        case ETSBC_AbiTypeKind::String:
+            return AbiSegmentBytesLength + GetCompiledAbiPaddedLength(
+                FPlatformString::ConvertedLength<UTF8CHAR>(*Value, Value.Len()));
+        default:
+            return AbiSegmentBytesLength;
+        }
+    }
+
+    /**
+     * Computes the number of bytes the encoding of an array takes, and checks the number of elements.
+     */
+    bool MeasureCompiledAbiArray(
+        FString& ErrorMessage,
+        const FTSBC_AbiTypePlan& Plan,
+        const TArray<FString>& Values,
+        int32& NumBytes)
+    {
+        if(Plan.ArrayLength > 0 && Values.Num() != Plan.ArrayLength)
+        {
+            ErrorMessage = FString::Printf(
+                TEXT("Expecting %d array elements but found %d"),
+                Plan.ArrayLength,
+                Values.Num());
+            return false;
+        }
+
+        NumBytes = Plan.ArrayLength == 0 ? AbiSegmentBytesLength : 0;
+        if(!Plan.IsElementDynamic())
+        {
+            NumBytes += Values.Num() * AbiSegmentBytesLength;
+            return true;
+        }
+
+        // An offset per element, followed by the elements
+        for(const FString& Value : Values)
+        {
+            NumBytes += AbiSegmentBytesLength + MeasureCompiledAbiElement(Plan, Value);
+        }
+
+        return true;
+    }
+
+    /**
+     * Writes the encoding of a value which is not a tuple or an array.
+     *
+     * @param Destination Zeroed memory of the size returned by MeasureCompiledAbiElement.
+     * @param NumBytes Number of bytes written.
+     */
+    bool WriteCompiledAbiElement(
+        FString& ErrorMessage,
+        const FTSBC_AbiTypePlan& Plan,
+        const FString& Value,
+        uint8* Destination,
+        int32& NumBytes)
+    {
+        NumBytes = AbiSegmentBytesLength;
+
+        switch(Plan.Kind)
+        {
+        case ETSBC_AbiTypeKind::Address:
+            {
+                const FStringView Digits = GetCompiledAbiHexDigits(Value);
+                if(Digits.Len() != EthereumAddressCharLength ||
+                    !ParseCompiledAbiHexDigits(Digits, Destination + AbiSegmentBytesLength - Digits.Len() / 2))
+                {
+                    ErrorMessage = FString::Printf(TEXT("Invalid address \"%s\""), *Value);
+                    return false;
+                }
+                return true;
+            }
+        case ETSBC_AbiTypeKind::Uint:
+            {
+                const FStringView Trimmed = FStringView(Value).TrimStartAndEnd();
+                FTSBC_uint256 Uint;
+                // Decimal parsing accepts no digits as 0, which would silently encode an unset value
+                const TCHAR* Chars = Trimmed.GetData();
+                const bool bParsed = !Trimmed.IsEmpty()
+                                     && (Trimmed.StartsWith(TEXT("0x"))
+                                             ? FTSBC_uint256::ParseFromHexChars(Chars, Trimmed.Len(), Uint)
+                                             : FTSBC_uint256::ParseFromDecChars(Chars, Trimmed.Len(), Uint));
+                if(!bParsed)
+                {
+                    ErrorMessage = FString::Printf(TEXT("Invalid uint \"%s\""), *Value);
+                    return false;
+                }
+
+                Uint.ToBytes(Destination);
+                return true;
+            }
+        case ETSBC_AbiTypeKind::Bool:
+            {
+                const FStringView Trimmed = FStringView(Value).TrimStartAndEnd();
+                const bool bValue = Trimmed.Len() == Value.Len() ? FCString::ToBool(*Value) : FString(Trimmed).ToBool();
+                Destination[AbiSegmentBytesLength - 1] = bValue ? 1 : 0;
+                return true;
+            }
+        case ETSBC_AbiTypeKind::FixedBytes:
+            {
+                const FStringView Digits = GetCompiledAbiHexDigits(Value);
+                if(Digits.Len() % 2 != 0 || Digits.Len() > Plan.FixedBytesLength * 2 ||
+                    !ParseCompiledAbiHexDigits(Digits, Destination))
+                {
+                    ErrorMessage = FString::Printf(
+                        TEXT("Invalid bytes%d \"%s\""),
+                        Plan.FixedBytesLength,
+                        *Value);
+                    return false;
+                }
+                return true;
+            }
+        case ETSBC_AbiTypeKind::Bytes:
+            {
+                const FStringView Digits = GetCompiledAbiHexDigits(Value);
+                if(Digits.Len() % 2 != 0 || !ParseCompiledAbiHexDigits(Digits, Destination + AbiSegmentBytesLength))
+                {
+                    ErrorMessage = FString::Printf(TEXT("Invalid bytes \"%s\""), *Value);
+                    return false;
+                }
+
+                WriteCompiledAbiLength(Digits.Len() / 2, Destination);
+                NumBytes += GetCompiledAbiPaddedLength(Digits.Len() / 2);
+                return true;
+            }
+        case ETSBC_AbiTypeKind::String:
+            {
+                // Converted right into the buffer, the measured length leaves room for it
+                const int32 Length = FPlatformString::ConvertedLength<UTF8CHAR>(*Value, Value.Len());
+                FPlatformString::Convert(
+                    reinterpret_cast<UTF8CHAR*>(Destination + AbiSegmentBytesLength),
+                    Length,
+                    *Value,
+                    Value.Len());
+
+                WriteCompiledAbiLength(Length, Destination);
+                NumBytes += GetCompiledAbiPaddedLength(Length);
+                return true;
+            }
+        default:
+            ErrorMessage = FString("Unexpected tuple");
+            return false;
+        }
+    }
+
+    /**
+     * Writes the encoding of an array whose number of elements has been checked by MeasureCompiledAbiArray.
+     *
+     * @param Destination Zeroed memory of the size returned by MeasureCompiledAbiArray.
+     * @param NumBytes Number of bytes written.
+     */
+    bool WriteCompiledAbiArray(
+        FString& ErrorMessage,
+        const FTSBC_AbiTypePlan& Plan,
+        const TArray<FString>& Values,
+        uint8* Destination,
+        int32& NumBytes)
+    {
+        uint8* Elements = Destination;
+        if(Plan.ArrayLength == 0)
+        {
+            WriteCompiledAbiLength(Values.Num(), Destination);
+            Elements += AbiSegmentBytesLength;
+        }
+
+        // Offsets of dynamic elements are relative to the first element
+        int32 ElementsBytes = Values.Num() * AbiSegmentBytesLength;
+        for(int32 i = 0; i < Values.Num(); i++)
+        {
+            uint8* Head = Elements + i * AbiSegmentBytesLength;
+            int32 ElementBytes;
+
+            if(!Plan.IsElementDynamic())
+            {
+                if(!WriteCompiledAbiElement(ErrorMessage, Plan, Values[i], Head, ElementBytes))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            WriteCompiledAbiLength(ElementsBytes, Head);
+            if(!WriteCompiledAbiElement(ErrorMessage, Plan, Values[i], Elements + ElementsBytes, ElementBytes))
+            {
+                return false;
+            }
+            ElementsBytes += ElementBytes;
+        }
+
+        NumBytes = static_cast<int32>(Elements - Destination) + ElementsBytes;
+        return true;
+    }
+
+    /**
+     * Decodes a value which is not a tuple or an array.
+     *
+     * @param Position Index of the value's word, or of the length word of "bytes" and "string".
+     */
+    bool DecodeCompiledAbiElement(
+        FString& ErrorMessage,
+        const FTSBC_AbiTypePlan& Plan,
+        const TArrayView<const uint8> Data,
+        const int32 Position,
+        FTSBC_AbiValueView& Value)
+    {
+        if(Position < 0 || Position > Data.Num() - AbiSegmentBytesLength)
+        {
+            ErrorMessage = FString::Printf(TEXT("Value at %d is out of bounds"), Position);
+            return false;
+        }
+
+        const uint8* Word = Data.GetData() + Position;
+        Value.Kind = Plan.Kind;
+
+        switch(Plan.Kind)
+        {
+        case ETSBC_AbiTypeKind::Address:
+            Value.Bytes = MakeArrayView(
+                Word + AbiSegmentBytesLength - EthereumAddressCharLength / 2,
+                EthereumAddressCharLength / 2);
+            return true;
+        case ETSBC_AbiTypeKind::Uint:
+        case ETSBC_AbiTypeKind::Bool:
+            Value.Bytes = MakeArrayView(Word, AbiSegmentBytesLength);
+            return true;
+        case ETSBC_AbiTypeKind::FixedBytes:
+            Value.Bytes = MakeArrayView(Word, Plan.FixedBytesLength);
+            return true;
+        case ETSBC_AbiTypeKind::Bytes:
+        case ETSBC_AbiTypeKind::String:
+            {
+                int32 Length;
+                if(!ReadCompiledAbiLength(Data, Position, Length) ||
+                    Length > Data.Num() - Position - AbiSegmentBytesLength)
+                {
+                    ErrorMessage = FString::Printf(TEXT("Invalid length at %d"), Position);
+                    return false;
+                }
+
+                Value.Bytes = MakeArrayView(Word + AbiSegmentBytesLength, Length);
+                return true;
+            }
+        default:
+            ErrorMessage = FString("Unexpected tuple");
+            return false;
+        }
+    }
+
+    /**
+     * Decodes the elements of an array.
+     *
+     * @param Start Index of the array's first byte, i.e. of its length word if it is dynamic.
+     */
+    bool DecodeCompiledAbiArray(
+        FString& ErrorMessage,
+        const FTSBC_AbiTypePlan& Plan,
+        const TArrayView<const uint8> Data,
+        const int32 Start,
+        TArray<FTSBC_AbiValueView>& Values)
+    {
+        int32 Length = Plan.ArrayLength;
+        int32 ElementsStart = Start;
+        if(Length == 0)
+        {
+            if(!ReadCompiledAbiLength(Data, Start, Length))
+            {
+                ErrorMessage = FString::Printf(TEXT("Invalid array length at %d"), Start);
+                return false;
+            }
+            ElementsStart += AbiSegmentBytesLength;
+        }
+
+        // Every element takes at least one word, which rules out lengths that do not fit the data
+        if(static_cast<int64>(ElementsStart) + static_cast<int64>(Length) * AbiSegmentBytesLength > Data.Num())
+        {
+            ErrorMessage = FString::Printf(TEXT("Array length %d at %d exceeds the data"), Length, Start);
+            return false;
+        }
+
+        Values.SetNum(Length);
+        for(int32 i = 0; i < Length; i++)
+        {
+            int32 Position = ElementsStart + i * AbiSegmentBytesLength;
+
+            // Offsets of dynamic elements are relative to the first element
+            if(Plan.IsElementDynamic() && !ReadCompiledAbiOffset(Data, Position, ElementsStart, Position))
+            {
+                ErrorMessage = FString::Printf(TEXT("Invalid offset at %d"), Position);
+                return false;
+            }
+
+            if(!DecodeCompiledAbiElement(ErrorMessage, Plan, Data, Position, Values[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Adds the values in the notation of CTSBC_ContractAbiDecoding.
+     */
+    void MakeCompiledAbiValueLists(
+        const TArray<TArray<FTSBC_AbiValueView>>& ValueViews,
+        TArray<FTSBC_SolidityValueList>& ValueLists)
+    {
+        ValueLists.Reserve(ValueLists.Num() + ValueViews.Num());
+        for(const TArray<FTSBC_AbiValueView>& ValueList : ValueViews)
+        {
+            TArray<FString>& Values = ValueLists.AddDefaulted_GetRef().Values;
+            Values.Reserve(ValueList.Num());
+            for(const FTSBC_AbiValueView& Value : ValueList)
+            {
+                Values.Add(Value.ToString());
+            }
+        }
+    }
+}
+
+FTSBC_uint256 FTSBC_AbiValueView::GetUint() const
+{
+    FTSBC_uint256 Uint;
+    FTSBC_uint256::ParseFromBytes(Bytes.GetData(), Bytes.Num(), Uint);
+    return Uint;
+}
+
+bool FTSBC_AbiValueView::GetBool() const
+{
+    // Like CTSBC_ContractAbiDecoding, only 1 is true
+    for(int32 i = 0; i + 1 < Bytes.Num(); i++)
+    {
+        if(Bytes[i] != 0)
+        {
+            return false;
+        }
+    }
+
+    return Bytes.Num() > 0 && Bytes.Last() == 1;
+}
+
+FString FTSBC_AbiValueView::ToString() const
+{
+    switch(Kind)
+    {
+    case ETSBC_AbiTypeKind::Uint:
+        return GetUint().ToDecString();
+    case ETSBC_AbiTypeKind::Bool:
+        return GetBool() ? "True" : "False";
+    case ETSBC_AbiTypeKind::String:
+        {
+            FString String;
+            const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+            String.AppendChars(Converter.Get(), Converter.Length());
+            return String;
+        }
+    default:
+        return MakeCompiledAbiHex(Bytes);
+    }
+}
+
+TSharedRef<const CTSBC_CompiledContractAbi> CTSBC_CompiledContractAbi::Compile(const FTSBC_ContractAbi& ContractAbi)
+{
+    const TSharedRef<CTSBC_CompiledContractAbi> CompiledAbi = MakeShared<CTSBC_CompiledContractAbi>();
+    CompiledAbi->Functions.Reserve(ContractAbi.ContractAbiFunctions.Num());
+
+    CTSBC_Keccak256 Hasher;
+    for(const FTSBC_ContractAbiFunction& AbiFunction : ContractAbi.ContractAbiFunctions)
+    {
+        FTSBC_CompiledAbiFunction Function;
+        Function.Name = AbiFunction.Name;
+
+        FString InputTypes;
+        Function.FirstInput = CompiledAbi->CompileParameters(
+            AbiFunction.Inputs,
+            InputTypes,
+            Function.NumInputValueLists,
+            Function.UnsupportedReason);
+        Function.NumInputs = AbiFunction.Inputs.Num();
+
+        FString OutputTypes;
+        Function.FirstOutput = CompiledAbi->CompileParameters(
+            AbiFunction.Outputs,
+            OutputTypes,
+            Function.NumOutputValueLists,
+            Function.UnsupportedReason);
+        Function.NumOutputs = AbiFunction.Outputs.Num();
+
+        Function.Signature = FString::Printf(TEXT("%s(%s)"), *Function.Name, *InputTypes);
+
+        uint8 FunctionHash[32];
+        Hasher.UpdateAnsi(Function.Signature);
+        Hasher.Final(FunctionHash);
+        FMemory::Memcpy(Function.Selector, FunctionHash, sizeof(Function.Selector));
+        Function.SelectorHex = MakeCompiledAbiHex(MakeArrayView(Function.Selector));
+
+        if(!Function.UnsupportedReason.IsEmpty())
+        {
+            TSBC_LOG(
+                Verbose,
+                TEXT("Function \"%s\" cannot be encoded: %s"),
+                *Function.Signature,
+                *Function.UnsupportedReason);
+        }
+
+        const uint32 SelectorKey = MakeCompiledAbiSelectorKey(Function.Selector);
+
+        const int32 FunctionIndex = CompiledAbi->Functions.Add(MoveTemp(Function));
+        if(!CompiledAbi->FunctionsByName.Contains(AbiFunction.Name))
+        {
+            CompiledAbi->FunctionsByName.Add(AbiFunction.Name, FunctionIndex);
+        }
+        CompiledAbi->FunctionsBySelector.Add(SelectorKey, FunctionIndex);
+    }
+
+    CompiledAbi->Events.Reserve(ContractAbi.ContractAbiEvents.Num());
+    for(const FTSBC_ContractAbiEvent& AbiEvent : ContractAbi.ContractAbiEvents)
+    {
+        CompiledAbi->CompileEvent(AbiEvent, Hasher);
+    }
+
+    return CompiledAbi;
+}
+
+const FTSBC_CompiledAbiFunction* CTSBC_CompiledContractAbi::FindFunction(const FString& FunctionName) const
+{
+    const int32* FunctionIndex = FunctionsByName.Find(FunctionName);
+    return FunctionIndex ? &Functions[*FunctionIndex] : nullptr;
+}
+
+const FTSBC_CompiledAbiFunction* CTSBC_CompiledContractAbi::FindFunctionBySelector(const uint8* Selector) const
+{
+    const int32* FunctionIndex = FunctionsBySelector.Find(MakeCompiledAbiSelectorKey(Selector));
+    return FunctionIndex ? &Functions[*FunctionIndex] : nullptr;
+}
+
+const FTSBC_CompiledAbiEvent* CTSBC_CompiledContractAbi::FindEvent(const FString& EventName) const
+{
+    const int32* EventIndex = EventsByName.Find(EventName);
+    return EventIndex ? &Events[*EventIndex] : nullptr;
+}
+
+const FTSBC_CompiledAbiEvent* CTSBC_CompiledContractAbi::FindEventByTopic(const FString& Topic0) const
+{
+    const int32* EventIndex = EventsByTopic.Find(Topic0);
+    return EventIndex ? &Events[*EventIndex] : nullptr;
+}
+
+bool CTSBC_CompiledContractAbi::EncodeFunctionCall(
+    FString& ErrorMessage,
+    const FTSBC_CompiledAbiFunction& Function,
+    const TArray<FTSBC_SolidityValueList>& Arguments,
+    FString& FunctionSelectorAndEncodedArguments) const
+{
+    TArray<uint8> CallData;
+    if(!EncodeFunctionCall(ErrorMessage, Function, Arguments, CallData))
+    {
+        return false;
+    }
+
+    FunctionSelectorAndEncodedArguments = MakeCompiledAbiHex(CallData);
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::EncodeFunctionCall(
+    FString& ErrorMessage,
+    const FTSBC_CompiledAbiFunction& Function,
+    const TArray<FTSBC_SolidityValueList>& Arguments,
+    TArray<uint8>& CallData) const
+{
+    ErrorMessage = "";
+
+    if(!Function.UnsupportedReason.IsEmpty())
+    {
+        ErrorMessage = FString::Printf(
+            TEXT("Encoding function \"%s\" is not possible: %s"),
+            *Function.Name,
+            *Function.UnsupportedReason);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    if(Arguments.Num() != Function.NumInputValueLists)
+    {
+        ErrorMessage = FString::Printf(
+            TEXT("Error passing arguments, Expecting %d but found %d"),
+            Function.NumInputValueLists,
+            Arguments.Num());
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    // Sized up front, so the words are written in place and padding is already zero
+    int32 ArgumentIndex = 0;
+    int32 NumBytes;
+    bool bSuccess = MeasureTuple(
+        ErrorMessage,
+        Function.FirstInput,
+        Function.NumInputs,
+        Arguments,
+        ArgumentIndex,
+        NumBytes);
+    if(bSuccess)
+    {
+        CallData.Reset(sizeof(Function.Selector) + NumBytes);
+        CallData.SetNumZeroed(sizeof(Function.Selector) + NumBytes);
+        FMemory::Memcpy(CallData.GetData(), Function.Selector, sizeof(Function.Selector));
+
+        ArgumentIndex = 0;
+        bSuccess = WriteTuple(
+            ErrorMessage,
+            Function.FirstInput,
+            Function.NumInputs,
+            Arguments,
+            ArgumentIndex,
+            CallData.GetData() + sizeof(Function.Selector),
+            NumBytes);
+    }
+
+    if(!bSuccess)
+    {
+        ErrorMessage = FString::Printf(TEXT("Error encoding arguments of \"%s\": %s"), *Function.Name, *ErrorMessage);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        CallData.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::DecodeFunctionResult(
+    FString& ErrorMessage,
+    const FTSBC_CompiledAbiFunction& Function,
+    const FString& DataToDecode,
+    TArray<FTSBC_SolidityValueList>& DecodedValues) const
+{
+    DecodedValues.Reset();
+
+    // Converted once, the values are decoded from the bytes
+    const FStringView Digits = GetCompiledAbiHexDigits(DataToDecode);
+    TArray<uint8> Data;
+    Data.SetNumUninitialized(Digits.Len() / 2);
+    if(Digits.Len() % 2 != 0 || !ParseCompiledAbiHexDigits(Digits, Data.GetData()))
+    {
+        ErrorMessage = FString("ResultToDecode variable is not correct");
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    TArray<TArray<FTSBC_AbiValueView>> ValueViews;
+    if(!DecodeFunctionResult(ErrorMessage, Function, Data, ValueViews))
+    {
+        return false;
+    }
+
+    MakeCompiledAbiValueLists(ValueViews, DecodedValues);
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::DecodeFunctionResult(
+    FString& ErrorMessage,
+    const FTSBC_CompiledAbiFunction& Function,
+    const TArrayView<const uint8> Data,
+    TArray<TArray<FTSBC_AbiValueView>>& DecodedValues) const
+{
+    ErrorMessage = "";
+    DecodedValues.Reset(Function.NumOutputValueLists);
+
+    if(!Function.UnsupportedReason.IsEmpty())
+    {
+        ErrorMessage = FString::Printf(
+            TEXT("Decoding function \"%s\" is not possible: %s"),
+            *Function.Name,
+            *Function.UnsupportedReason);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    if(!DecodeTuple(ErrorMessage, Function.FirstOutput, Function.NumOutputs, Data, 0, DecodedValues))
+    {
+        ErrorMessage = FString::Printf(TEXT("Error decoding result of \"%s\": %s"), *Function.Name, *ErrorMessage);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        DecodedValues.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::DecodeEventLog(
+    FString& ErrorMessage,
+    const FTSBC_CompiledAbiEvent& Event,
+    const FTSBC_EthLog& Log,
+    TArray<FTSBC_SolidityValueList>& DecodedValues) const
+{
+    DecodedValues.Reset();
+
+    TArray<uint8> Buffer;
+    TArray<TArray<FTSBC_AbiValueView>> ValueViews;
+    if(!DecodeEventLog(ErrorMessage, Event, Log, Buffer, ValueViews))
+    {
+        return false;
+    }
+
+    MakeCompiledAbiValueLists(ValueViews, DecodedValues);
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::DecodeEventLog(
+    FString& ErrorMessage,
+    const FTSBC_EthLog& Log,
+    const FTSBC_CompiledAbiEvent*& Event,
+    TArray<FTSBC_SolidityValueList>& DecodedValues) const
+{
+    Event = Log.Topics.Num() > 0 ? FindEventByTopic(Log.Topics[0]) : nullptr;
+    if(!Event)
+    {
+        ErrorMessage = FString("Event not found");
+        DecodedValues.Reset();
+        return false;
+    }
+
+    return DecodeEventLog(ErrorMessage, *Event, Log, DecodedValues);
+}
+
+bool CTSBC_CompiledContractAbi::DecodeEventLog(
+    FString& ErrorMessage,
+    const FTSBC_CompiledAbiEvent& Event,
+    const FTSBC_EthLog& Log,
+    TArray<uint8>& Buffer,
+    TArray<TArray<FTSBC_AbiValueView>>& DecodedValues) const
+{
+    ErrorMessage = "";
+    DecodedValues.Reset(Event.NumValueLists);
+
+    if(!Event.UnsupportedReason.IsEmpty())
+    {
+        ErrorMessage = FString::Printf(
+            TEXT("Decoding event \"%s\" is not possible: %s"),
+            *Event.Name,
+            *Event.UnsupportedReason);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    // Topic 0 of non-anonymous events is the hash of the signature
+    const int32 FirstTopic = Event.bAnonymous ? 0 : 1;
+    if(Log.Topics.Num() != FirstTopic + Event.NumIndexedInputs)
+    {
+        ErrorMessage = FString::Printf(
+            TEXT("Error decoding event \"%s\": Expecting %d topics but found %d"),
+            *Event.Name,
+            FirstTopic + Event.NumIndexedInputs,
+            Log.Topics.Num());
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    if(!Event.bAnonymous && !Log.Topics[0].Equals(Event.Topic0, ESearchCase::IgnoreCase))
+    {
+        ErrorMessage = FString::Printf(TEXT("Error decoding event \"%s\": Topic 0 does not match"), *Event.Name);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    // The indexed topics are followed by the data, so both are converted into one buffer
+    const int32 TopicsBytes = Event.NumIndexedInputs * AbiSegmentBytesLength;
+    const FStringView DataDigits = GetCompiledAbiHexDigits(Log.Data);
+    Buffer.SetNumUninitialized(TopicsBytes + DataDigits.Len() / 2, false);
+
+    bool bValidHex = DataDigits.Len() % 2 == 0 && ParseCompiledAbiHexDigits(DataDigits, Buffer.GetData() + TopicsBytes);
+    for(int32 i = 0; i < Event.NumIndexedInputs && bValidHex; i++)
+    {
+        const FStringView TopicDigits = GetCompiledAbiHexDigits(Log.Topics[FirstTopic + i]);
+        bValidHex = TopicDigits.Len() == AbiSegmentBytesLength * 2 &&
+            ParseCompiledAbiHexDigits(TopicDigits, Buffer.GetData() + i * AbiSegmentBytesLength);
+    }
+
+    if(!bValidHex)
+    {
+        ErrorMessage = FString::Printf(TEXT("Error decoding event \"%s\": Invalid topics or data"), *Event.Name);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        return false;
+    }
+
+    // Offsets in the data are relative to its start, not to the buffer's
+    const TArrayView<const uint8> Topics = MakeArrayView(Buffer.GetData(), TopicsBytes);
+    const TArrayView<const uint8> Data = MakeArrayView(Buffer.GetData() + TopicsBytes, Buffer.Num() - TopicsBytes);
+    if(!DecodeTuple(ErrorMessage, Event.FirstDataInput, Event.NumDataInputs, Data, 0, DecodedValues))
+    {
+        ErrorMessage = FString::Printf(TEXT("Error decoding event \"%s\": %s"), *Event.Name, *ErrorMessage);
+        TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+        DecodedValues.Reset();
+        return false;
+    }
+
+    // Inserts the indexed parameters between the ones from the data, in declaration order
+    int32 ValueListIndex = 0;
+    int32 TopicIndex = 0;
+    for(int32 i = 0; i < Event.NumInputs; i++)
+    {
+        const FTSBC_AbiTypePlan& Plan = Plans[Event.FirstInput + i];
+        if(!Event.IndexedInputs[i])
+        {
+            ValueListIndex += Plan.Kind == ETSBC_AbiTypeKind::Tuple ? Plan.NumComponents : 1;
+            continue;
+        }
+
+        FTSBC_AbiValueView& Value = DecodedValues.InsertDefaulted_GetRef(ValueListIndex++).AddDefaulted_GetRef();
+        const int32 Position = TopicIndex++ * AbiSegmentBytesLength;
+
+        // Indexed parameters stored as a hash were compiled as "bytes32"
+        if(!DecodeCompiledAbiElement(ErrorMessage, Plan, Topics, Position, Value))
+        {
+            ErrorMessage = FString::Printf(TEXT("Error decoding event \"%s\": %s"), *Event.Name, *ErrorMessage);
+            TSBC_LOG(Error, TEXT("%s"), *ErrorMessage);
+            DecodedValues.Reset();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CTSBC_CompiledContractAbi::CompileEvent(const FTSBC_ContractAbiEvent& AbiEvent, CTSBC_Keccak256& Hasher)
+{
+    FTSBC_CompiledAbiEvent Event;
+    Event.Name = AbiEvent.Name;
+    Event.bAnonymous = AbiEvent.Anonymous;
+
+    // Compiling all parameters yields the signature; whether they are supported is decided for the data alone below
+    int32 NumValueLists;
+    FString InputTypes;
+    FString InputsUnsupportedReason;
+    Event.FirstInput = CompileParameters(AbiEvent.Inputs, InputTypes, NumValueLists, InputsUnsupportedReason);
+    Event.NumInputs = AbiEvent.Inputs.Num();
+
+    // The parameters in the data are encoded like a tuple of their own
+    TArray<FTSBC_SolidityFunctionSignature> DataInputs;
+    Event.IndexedInputs.Reserve(Event.NumInputs);
+    for(int32 i = 0; i < Event.NumInputs; i++)
+    {
+        const FTSBC_SolidityFunctionSignature& Input = AbiEvent.Inputs[i];
+        const int32 PlanIndex = Event.FirstInput + i;
+        Event.IndexedInputs.Add(Input.Indexed);
+
+        if(Input.Indexed)
+        {
+            // Only value types are stored in a topic as they are, all others as the hash of their encoding
+            const bool bCompiled = CompileType(Input.Variable.Type, PlanIndex);
+            const FTSBC_AbiTypePlan& Plan = Plans[PlanIndex];
+            if(!bCompiled || Plan.Kind == ETSBC_AbiTypeKind::Tuple || Plan.ArrayLength != INDEX_NONE || Plan.bDynamic)
+            {
+                FTSBC_AbiTypePlan TopicPlan;
+                TopicPlan.Kind = ETSBC_AbiTypeKind::FixedBytes;
+                TopicPlan.FixedBytesLength = AbiSegmentBytesLength;
+                Plans[PlanIndex] = TopicPlan;
+            }
+
+            Event.NumIndexedInputs++;
+            Event.NumValueLists++;
+        }
+        else
+        {
+            const FTSBC_AbiTypePlan& Plan = Plans[PlanIndex];
+            DataInputs.Add(Input);
+            Event.NumValueLists += Plan.Kind == ETSBC_AbiTypeKind::Tuple ? Plan.NumComponents : 1;
+        }
+    }
+
+    FString DataInputTypes;
+    int32 NumDataValueLists;
+    Event.FirstDataInput = CompileParameters(DataInputs, DataInputTypes, NumDataValueLists, Event.UnsupportedReason);
+    Event.NumDataInputs = DataInputs.Num();
+
+    Event.Signature = FString::Printf(TEXT("%s(%s)"), *Event.Name, *InputTypes);
+
+    uint8 EventHash[32];
+    Hasher.UpdateAnsi(Event.Signature);
+    Hasher.Final(EventHash);
+    Event.Topic0 = MakeCompiledAbiHex(MakeArrayView(EventHash));
+
+    if(!Event.UnsupportedReason.IsEmpty())
+    {
+        TSBC_LOG(
+            Verbose,
+            TEXT("Event \"%s\" cannot be decoded: %s"),
+            *Event.Signature,
+            *Event.UnsupportedReason);
+    }
+
+    const FString Topic0 = Event.Topic0;
+    const int32 EventIndex = Events.Add(MoveTemp(Event));
+    if(!EventsByName.Contains(AbiEvent.Name))
+    {
+        EventsByName.Add(AbiEvent.Name, EventIndex);
+    }
+    if(!AbiEvent.Anonymous)
+    {
+        EventsByTopic.Add(Topic0, EventIndex);
+    }
+}
+
+int32 CTSBC_CompiledContractAbi::CompileParameters(
+    const TArray<FTSBC_SolidityFunctionSignature>& Parameters,
+    FString& CanonicalTypes,
+    int32& NumValueLists,
+    FString& UnsupportedReason)
+{
+    // Components are added after all parameters, so the parameters stay one range
+    const int32 FirstPlan = Plans.Num();
+    Plans.AddDefaulted(Parameters.Num());
+    NumValueLists = 0;
+
+    for(int32 i = 0; i < Parameters.Num(); i++)
+    {
+        const FTSBC_SolidityFunctionSignature& Parameter = Parameters[i];
+        const int32 PlanIndex = FirstPlan + i;
+
+        if(i > 0)
+        {
+            CanonicalTypes += ",";
+        }
+
+        if(!CompileType(Parameter.Variable.Type, PlanIndex))
+        {
+            if(UnsupportedReason.IsEmpty())
+            {
+                UnsupportedReason = FString::Printf(TEXT("Type \"%s\" is not supported"), *Parameter.Variable.Type);
+            }
+
+            CanonicalTypes += Parameter.Variable.Type;
+            NumValueLists++;
+            continue;
+        }
+
+        if(Plans[PlanIndex].Kind != ETSBC_AbiTypeKind::Tuple)
+        {
+            CanonicalTypes += Parameter.Variable.Type;
+            NumValueLists++;
+            continue;
+        }
+
+        const int32 NumComponents = Parameter.TupleVariables.Num();
+        const int32 FirstComponent = Plans.Num();
+        Plans.AddDefaulted(NumComponents);
+
+        bool bDynamic = false;
+        int32 HeadWords = 0;
+        CanonicalTypes += "(";
+        for(int32 j = 0; j < NumComponents; j++)
+        {
+            const FTSBC_SolidityVariable& Component = Parameter.TupleVariables[j];
+
+            if(j > 0)
+            {
+                CanonicalTypes += ",";
+            }
+            CanonicalTypes += Component.Type;
+
+            // Components of nested tuples are not part of the parsed ABI
+            if(!CompileType(Component.Type, FirstComponent + j) ||
+                Plans[FirstComponent + j].Kind == ETSBC_AbiTypeKind::Tuple)
+            {
+                if(UnsupportedReason.IsEmpty())
+                {
+                    UnsupportedReason = FString::Printf(
+                        TEXT("Type \"%s\" of tuple component \"%s\" is not supported"),
+                        *Component.Type,
+                        *Component.Name);
+                }
+                continue;
+            }
+
+            bDynamic |= Plans[FirstComponent + j].bDynamic;
+            HeadWords += Plans[FirstComponent + j].HeadWords;
+        }
+        // Keeps the array dimension of e.g. "tuple[]"
+        CanonicalTypes += ")";
+        CanonicalTypes += Parameter.Variable.Type.Mid(AbiType_Tuple.Len());
+
+        FTSBC_AbiTypePlan& Plan = Plans[PlanIndex];
+        Plan.FirstComponent = FirstComponent;
+        Plan.NumComponents = NumComponents;
+        Plan.bDynamic = bDynamic;
+        Plan.HeadWords = bDynamic ? 1 : HeadWords;
+        NumValueLists += NumComponents;
+
+        // Elements of a tuple array cannot be told apart in flattened value lists
+        if(Plan.ArrayLength != INDEX_NONE && UnsupportedReason.IsEmpty())
+        {
+            UnsupportedReason = FString::Printf(TEXT("Type \"%s\" is not supported"), *Parameter.Variable.Type);
+        }
+    }
+
+    return FirstPlan;
+}
+
+bool CTSBC_CompiledContractAbi::CompileType(const FString& Type, const int32 PlanIndex)
+{
+    FTSBC_AbiTypePlan Plan;
+
+    FString BaseType = Type;
+    int32 Bracket;
+    if(Type.FindChar(TEXT('['), Bracket))
+    {
+        BaseType = Type.Left(Bracket);
+
+        // Only one dimension is supported, so "[2][3]" is rejected as length "2][3"
+        const FString Dimension = Type.Mid(Bracket);
+        if(Dimension == "[]")
+        {
+            Plan.ArrayLength = 0;
+        }
+        else if(Dimension.EndsWith("]"))
+        {
+            Plan.ArrayLength = ParseCompiledAbiTypeSize(Dimension.Mid(1, Dimension.Len() - 2));
+            if(Plan.ArrayLength <= 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if(BaseType == AbiType_Address)
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::Address;
+    }
+    else if(BaseType == AbiType_Bool)
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::Bool;
+    }
+    else if(BaseType == AbiType_String)
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::String;
+    }
+    else if(BaseType == AbiType_Tuple)
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::Tuple;
+    }
+    else if(BaseType == AbiType_Bytes)
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::Bytes;
+    }
+    else if(BaseType.StartsWith(AbiType_Bytes))
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::FixedBytes;
+        Plan.FixedBytesLength = ParseCompiledAbiTypeSize(BaseType.Mid(AbiType_Bytes.Len()));
+        if(Plan.FixedBytesLength < 1 || Plan.FixedBytesLength > AbiSegmentBytesLength)
+        {
+            return false;
+        }
+    }
+    else if(BaseType.StartsWith(AbiType_Uint))
+    {
+        Plan.Kind = ETSBC_AbiTypeKind::Uint;
+        if(BaseType.Len() > AbiType_Uint.Len())
+        {
+            const int32 Bits = ParseCompiledAbiTypeSize(BaseType.Mid(AbiType_Uint.Len()));
+            if(Bits < 8 || Bits > 256 || Bits % 8 != 0)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        // Includes "int", which CTSBC_ContractAbiEncoding does not support either
+        return false;
+    }
+
+    // Tuples are completed by CompileParameters once their components are known
+    Plan.bDynamic = Plan.ArrayLength == 0 || Plan.IsElementDynamic();
+    Plan.HeadWords = Plan.bDynamic ? 1 : FMath::Max(1, Plan.ArrayLength);
+
+    Plans[PlanIndex] = Plan;
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::MeasureTuple(
+    FString& ErrorMessage,
+    const int32 FirstPlan,
+    const int32 NumPlans,
+    const TArray<FTSBC_SolidityValueList>& Arguments,
+    int32& ArgumentIndex,
+    int32& NumBytes) const
+{
+    NumBytes = 0;
+    for(int32 i = 0; i < NumPlans; i++)
+    {
+        const FTSBC_AbiTypePlan& Plan = Plans[FirstPlan + i];
+        NumBytes += Plan.HeadWords * AbiSegmentBytesLength;
+
+        int32 ValueBytes = 0;
+        if(Plan.Kind == ETSBC_AbiTypeKind::Tuple)
+        {
+            if(!MeasureTuple(
+                ErrorMessage,
+                Plan.FirstComponent,
+                Plan.NumComponents,
+                Arguments,
+                ArgumentIndex,
+                ValueBytes))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const TArray<FString>& Values = Arguments[ArgumentIndex++].Values;
+            if(Plan.ArrayLength != INDEX_NONE)
+            {
+                if(!MeasureCompiledAbiArray(ErrorMessage, Plan, Values, ValueBytes))
+                {
+                    return false;
+                }
+            }
+            else if(Values.Num() != 1)
+            {
+                ErrorMessage = FString::Printf(
+                    TEXT("Expecting 1 value for argument %d but found %d"),
+                    ArgumentIndex - 1,
+                    Values.Num());
+                return false;
+            }
+            else
+            {
+                ValueBytes = MeasureCompiledAbiElement(Plan, Values[0]);
+            }
+        }
+
+        // Static values take their head words only
+        if(Plan.bDynamic)
+        {
+            NumBytes += ValueBytes;
+        }
+    }
+
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::WriteTuple(
+    FString& ErrorMessage,
+    const int32 FirstPlan,
+    const int32 NumPlans,
+    const TArray<FTSBC_SolidityValueList>& Arguments,
+    int32& ArgumentIndex,
+    uint8* Destination,
+    int32& NumBytes) const
+{
+    // The head holds static values in place and the offsets of dynamic values, which follow in the tail
+    NumBytes = 0;
+    for(int32 i = 0; i < NumPlans; i++)
+    {
+        NumBytes += Plans[FirstPlan + i].HeadWords * AbiSegmentBytesLength;
+    }
+
+    uint8* Head = Destination;
+    for(int32 i = 0; i < NumPlans; i++)
+    {
+        const FTSBC_AbiTypePlan& Plan = Plans[FirstPlan + i];
+
+        uint8* ValueDestination = Head;
+        if(Plan.bDynamic)
+        {
+            WriteCompiledAbiLength(NumBytes, Head);
+            ValueDestination = Destination + NumBytes;
+        }
+        Head += Plan.HeadWords * AbiSegmentBytesLength;
+
+        int32 ValueBytes;
+        if(Plan.Kind == ETSBC_AbiTypeKind::Tuple)
+        {
+            if(!WriteTuple(
+                ErrorMessage,
+                Plan.FirstComponent,
+                Plan.NumComponents,
+                Arguments,
+                ArgumentIndex,
+                ValueDestination,
+                ValueBytes))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const TArray<FString>& Values = Arguments[ArgumentIndex++].Values;
+            const bool bWritten = Plan.ArrayLength != INDEX_NONE
+                                      ? WriteCompiledAbiArray(ErrorMessage, Plan, Values, ValueDestination, ValueBytes)
+                                      : WriteCompiledAbiElement(
+                                          ErrorMessage,
+                                          Plan,
+                                          Values[0],
+                                          ValueDestination,
+                                          ValueBytes);
+            if(!bWritten)
+            {
+                return false;
+            }
+        }
+
+        if(Plan.bDynamic)
+        {
+            NumBytes += ValueBytes;
+        }
+    }
+
+    return true;
+}
+
+bool CTSBC_CompiledContractAbi::DecodeTuple(
+    FString& ErrorMessage,
+    const int32 FirstPlan,
+    const int32 NumPlans,
+    const TArrayView<const uint8> Data,
+    const int32 Start,
+    TArray<TArray<FTSBC_AbiValueView>>& DecodedValues) const
+{
+    int32 HeadPosition = Start;
+    for(int32 i = 0; i < NumPlans; i++)
+    {
+        const FTSBC_AbiTypePlan& Plan = Plans[FirstPlan + i];
+
+        int32 Position = HeadPosition;
+        HeadPosition += Plan.HeadWords * AbiSegmentBytesLength;
+
+        // Offsets are relative to the start of the enclosing tuple
+        if(Plan.bDynamic && !ReadCompiledAbiOffset(Data, Position, Start, Position))
+        {
+            ErrorMessage = FString::Printf(TEXT("Invalid offset at %d"), Position);
+            return false;
+        }
+
+        if(Plan.Kind == ETSBC_AbiTypeKind::Tuple)
+        {
+            if(!DecodeTuple(ErrorMessage, Plan.FirstComponent, Plan.NumComponents, Data, Position, DecodedValues))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        TArray<FTSBC_AbiValueView>& Values = DecodedValues.AddDefaulted_GetRef();
+        if(Plan.ArrayLength != INDEX_NONE)
+        {
+            if(!DecodeCompiledAbiArray(ErrorMessage, Plan, Data, Position, Values))
+            {
+                return false;
+            }
+        }
+        else if(!DecodeCompiledAbiElement(ErrorMessage, Plan, Data, Position, Values.AddDefaulted_GetRef()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -6,7 +6,7 @@
 // These includes are needed to prevent plugin build failures.
 #include "UObject/Package.h"
 // =============================================================================
-#include "Crypto/Hash/TSBC_HashFunctionLibrary.h"
+#include "Crypto/Hash/TSBC_Keccak256.h"
 #include "Encoding/TSBC_ContractAbiHelper.h"
 #include "Math/TSBC_BaseConverter.h"
 #include "Module/TSBC_RuntimeLogCategories.h"
@@ -78,9 +78,12 @@ void CTSBC_ContractAbiEncoding::EncodeAbi(
         *InputsRef);
 
     // Create the function Hash
-    const FString FunctionHash = UTSBC_HashFunctionLibrary::Keccak256FromString(Signature, false);
+    uint8 FunctionHash[32];
+    CTSBC_Keccak256 Hasher;
+    Hasher.UpdateAnsi(Signature);
+    Hasher.Final(FunctionHash);
     // Function selector is the first 4 bytes of the function hash
-    FString FunctionSelector = FunctionHash.Mid(0, 8);
+    FString FunctionSelector = BytesToHex(FunctionHash, 4).ToLower();
     FunctionSelectorAndEncodedArguments = FString("0x").Append(FunctionSelector);
 
     TArray<ETSBC_SolidityDataType> SolidityDataTypes;
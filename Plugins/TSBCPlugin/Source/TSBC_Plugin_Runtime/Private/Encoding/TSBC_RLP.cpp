@@ -5,111 +5,114 @@
 
 TArray<uint8> UTSBC_RLP::Encode(const FString& InHex)
 {
-    TArray<uint8> Result;
-
     const TArray<uint8> DataAsBytes = TSBC_StringUtils::HexToBytes(InHex);
-    const int32 NumDataBytesToEncode = DataAsBytes.Num();
-
-    // Encode 1 byte of data
-    if(NumDataBytesToEncode == 1)
-    {
-        const uint8 Value = DataAsBytes[0];
-        if(Value >= 0x80)
-        {
-            // This byte describes the length of encoded data
-            Result.Add(NumDataBytesToEncode + 0x80);
-        }
 
-        // Append original byte of the data to encode
-        Result.Add(Value);
+    TArray<uint8> Result;
+    Result.SetNumUninitialized(GetEncodedItemSize(DataAsBytes));
+    WriteItem(Result.GetData(), DataAsBytes);
 
-        return Result;
-    }
+    return Result;
+}
 
-    // Encode 0 or between 1 and up to 55 bytes of data
-    if(NumDataBytesToEncode == 0 || NumDataBytesToEncode <= 55)
-    {
-        // This byte describes the length of encoded data
-        Result.Add(NumDataBytesToEncode + 0x80);
+TArray<uint8> UTSBC_RLP::Encode(const TArray<FString>& InHexArray)
+{
+    // Decode all elements first, so that the list header can be written ahead of them instead of being inserted
+    TArray<TArray<uint8>> DecodedItems;
+    DecodedItems.Reserve(InHexArray.Num());
 
-        // Append original bytes of the data to encode
-        for(int8 i = 0; i < NumDataBytesToEncode; i++)
-        {
-            Result.Add(DataAsBytes[i]);
-        }
+    TArray<TArrayView<const uint8>, TInlineAllocator<16>> Items;
+    Items.Reserve(InHexArray.Num());
 
-        return Result;
+    for(const FString& InHex : InHexArray)
+    {
+        Items.Add(DecodedItems.Add_GetRef(TSBC_StringUtils::HexToBytes(InHex)));
     }
 
-    // Encode more than 55 bytes of data
-
-    // This byte describes how many bytes make up the length value for the encoded data
-    const uint8 NumBytesForLength = BytesNeeded(NumDataBytesToEncode);
-    Result.Add(NumBytesForLength + 0xB7);
+    return EncodeList(Items);
+}
 
-    // These bytes describe the length of the encoded data
-    const uint8* NumDataBytesToEncodeAsUInt8Ptr = reinterpret_cast<uint8*>(const_cast<int32*>(&NumDataBytesToEncode));
-    for(int32 i = NumBytesForLength - 1; i >= 0; i--)
+TArray<uint8> UTSBC_RLP::EncodeList(const TArrayView<const TArrayView<const uint8>> Items)
+{
+    // First pass: size the payload
+    int32 NumPayloadBytes = 0;
+    for(const TArrayView<const uint8>& Item : Items)
     {
-        const uint8 Byte = NumDataBytesToEncodeAsUInt8Ptr[i];
-        Result.Add(Byte);
+        NumPayloadBytes += GetEncodedItemSize(Item);
     }
 
-    // Append original bytes of the data to encode
-    for(int32 i = 0; i < NumDataBytesToEncode; i++)
+    // Second pass: write header and items into the final buffer
+    TArray<uint8> Result;
+    Result.SetNumUninitialized(GetHeaderSize(NumPayloadBytes) + NumPayloadBytes);
+
+    uint8* Dest = WriteHeader(Result.GetData(), NumPayloadBytes, 0xC0);
+    for(const TArrayView<const uint8>& Item : Items)
     {
-        Result.Add(DataAsBytes[i]);
+        Dest = WriteItem(Dest, Item);
     }
 
     return Result;
 }
 
-TArray<uint8> UTSBC_RLP::Encode(const TArray<FString>& InHexArray)
+uint32 UTSBC_RLP::BytesNeeded(int32 Number)
 {
-    TArray<uint8> Result;
-
-    // Encode all elements in hex array
-    for(const FString& InHex : InHexArray)
+    uint8 ByteCount = 0;
+    while(Number > 0)
     {
-        Result.Append(Encode(InHex));
+        Number >>= 8;
+        ByteCount++;
     }
 
-    const int32 NumDataBytesToEncode = Result.Num();
+    return ByteCount;
+}
+
+int32 UTSBC_RLP::GetHeaderSize(const int32 NumBytes)
+{
+    return NumBytes <= 55 ? 1 : 1 + BytesNeeded(NumBytes);
+}
 
-    // Encode between 0 and up to 55 bytes of data
-    if(NumDataBytesToEncode <= 55)
+int32 UTSBC_RLP::GetEncodedItemSize(const TArrayView<const uint8> Item)
+{
+    // A single byte below 0x80 is its own encoding
+    if(Item.Num() == 1 && Item[0] < 0x80)
     {
-        Result.Insert(NumDataBytesToEncode + 0xC0, 0);
-        return Result;
+        return 1;
     }
 
-    // Encode more than 55 bytes of data
-    // This byte describes how many bytes make up the length value for the encoded data
-    const uint8 NumBytesForLength = BytesNeeded(NumDataBytesToEncode);
+    return GetHeaderSize(Item.Num()) + Item.Num();
+}
 
-    TArray<uint8> Tmp;
-    Tmp.Add(NumBytesForLength + 0xF7);
+uint8* UTSBC_RLP::WriteHeader(uint8* Dest, const int32 NumBytes, const uint8 Offset)
+{
+    if(NumBytes <= 55)
+    {
+        *Dest++ = Offset + NumBytes;
+        return Dest;
+    }
 
-    // These bytes describe describe the length of the encoded data
-    const uint8* NumDataBytesToEncodeAsUInt8Ptr = reinterpret_cast<uint8*>(const_cast<int32*>(&NumDataBytesToEncode));
+    // The first byte describes how many bytes make up the big-endian length value
+    const uint32 NumBytesForLength = BytesNeeded(NumBytes);
+    *Dest++ = Offset + 55 + NumBytesForLength;
     for(int32 i = NumBytesForLength - 1; i >= 0; i--)
     {
-        const uint8 Byte = NumDataBytesToEncodeAsUInt8Ptr[i];
-        Tmp.Add(Byte);
+        *Dest++ = static_cast<uint8>(NumBytes >> (8 * i));
     }
 
-    Result.Insert(Tmp, 0);
-    return Result;
+    return Dest;
 }
 
-uint32 UTSBC_RLP::BytesNeeded(int32 Number)
+uint8* UTSBC_RLP::WriteItem(uint8* Dest, const TArrayView<const uint8> Item)
 {
-    uint8 ByteCount = 0;
-    while(Number > 0)
+    if(Item.Num() == 1 && Item[0] < 0x80)
     {
-        Number >>= 8;
-        ByteCount++;
+        *Dest++ = Item[0];
+        return Dest;
     }
 
-    return ByteCount;
+    Dest = WriteHeader(Dest, Item.Num(), 0x80);
+    if(Item.Num() > 0)
+    {
+        FMemory::Memcpy(Dest, Item.GetData(), Item.Num());
+    }
+
+    return Dest + Item.Num();
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "Encoding/TSBC_RLPReader.h"
+
+namespace
+{
+    /**
+     * @returns True if the string is a canonical integer: no leading zero bytes and at most MaxBytes long.
+     */
+    bool IsCanonicalInteger(const FTSBC_RLPItem& Item, const int32 MaxBytes)
+    {
+        return !Item.bIsList
+            && Item.Payload.Num() <= MaxBytes
+            && (Item.Payload.Num() == 0 || Item.Payload[0] != 0);
+    }
+}
+
+bool FTSBC_RLPItem::ToUint256(FTSBC_uint256& OutValue) const
+{
+    if(!IsCanonicalInteger(*this, FTSBC_uint256::NUM_BYTES))
+    {
+        return false;
+    }
+
+    return FTSBC_uint256::ParseFromBytes(Payload.GetData(), Payload.Num(), OutValue);
+}
+
+bool FTSBC_RLPItem::ToUint64(uint64& OutValue) const
+{
+    if(!IsCanonicalInteger(*this, sizeof(uint64)))
+    {
+        return false;
+    }
+
+    OutValue = 0;
+    for(const uint8 Byte : Payload)
+    {
+        OutValue = (OutValue << 8) | Byte;
+    }
+
+    return true;
+}
+
+CTSBC_RLPReader::CTSBC_RLPReader(const TArrayView<const uint8> Data)
+    : CTSBC_RLPReader(Data.GetData(), 0, Data.Num())
+{
+}
+
+CTSBC_RLPReader::CTSBC_RLPReader(const uint8* InBase, const int32 InPosition, const int32 InEnd)
+    : Base(InBase)
+    , Position(InPosition)
+    , End(InEnd)
+{
+}
+
+bool CTSBC_RLPReader::Next(FTSBC_RLPItem& OutItem)
+{
+    if(IsAtEnd() || HasError())
+    {
+        return false;
+    }
+
+    const uint8* Header = Base + Position;
+    const uint8 Prefix = Header[0];
+
+    int64 NumPayloadBytes;
+    int32 HeaderSize;
+
+    if(Prefix < 0x80)
+    {
+        // A single byte below 0x80 is its own encoding
+        OutItem.bIsList = false;
+        OutItem.Offset = Position;
+        OutItem.HeaderSize = 0;
+        OutItem.Payload = TArrayView<const uint8>(Header, 1);
+
+        Position++;
+        return true;
+    }
+
+    const bool bIsList = Prefix >= 0xC0;
+    const uint8 ShortBase = bIsList ? 0xC0 : 0x80;
+    const uint8 NumShortLengths = 56;
+
+    if(Prefix < ShortBase + NumShortLengths)
+    {
+        HeaderSize = 1;
+        NumPayloadBytes = Prefix - ShortBase;
+    }
+    else
+    {
+        const int32 NumLengthBytes = Prefix - (ShortBase + NumShortLengths - 1);
+        HeaderSize = 1 + NumLengthBytes;
+
+        // Payloads must fit into the buffer anyway, so longer lengths can only be malformed
+        if(NumLengthBytes > 4)
+        {
+            return Fail(TEXT("Length of more than 4 bytes"));
+        }
+
+        if(HeaderSize > End - Position)
+        {
+            return Fail(TEXT("Truncated length"));
+        }
+
+        if(Header[1] == 0)
+        {
+            return Fail(TEXT("Non-canonical length with leading zero bytes"));
+        }
+
+        NumPayloadBytes = 0;
+        for(int32 i = 1; i <= NumLengthBytes; i++)
+        {
+            NumPayloadBytes = (NumPayloadBytes << 8) | Header[i];
+        }
+
+        if(NumPayloadBytes < NumShortLengths)
+        {
+            return Fail(TEXT("Non-canonical long length for a short payload"));
+        }
+    }
+
+    if(NumPayloadBytes > End - Position - HeaderSize)
+    {
+        return Fail(TEXT("Item exceeds the enclosing data"));
+    }
+
+    if(!bIsList && NumPayloadBytes == 1 && Header[HeaderSize] < 0x80)
+    {
+        return Fail(TEXT("Non-canonical single byte with header"));
+    }
+
+    OutItem.bIsList = bIsList;
+    OutItem.Offset = Position;
+    OutItem.HeaderSize = HeaderSize;
+    OutItem.Payload = TArrayView<const uint8>(Header + HeaderSize, static_cast<int32>(NumPayloadBytes));
+
+    Position += HeaderSize + static_cast<int32>(NumPayloadBytes);
+    return true;
+}
+
+CTSBC_RLPReader CTSBC_RLPReader::EnterList(const FTSBC_RLPItem& List) const
+{
+    check(List.bIsList);
+
+    const int32 Begin = List.Offset + List.HeaderSize;
+    return CTSBC_RLPReader(Base, Begin, Begin + List.Payload.Num());
+}
+
+bool CTSBC_RLPReader::IsAtEnd() const
+{
+    return Position >= End;
+}
+
+bool CTSBC_RLPReader::HasError() const
+{
+    return !ErrorMessage.IsEmpty();
+}
+
+const FString& CTSBC_RLPReader::GetErrorMessage() const
+{
+    return ErrorMessage;
+}
+
+bool CTSBC_RLPReader::ReadSingle(const TArrayView<const uint8> Data, FTSBC_RLPItem& OutItem, FString& OutErrorMessage)
+{
+    CTSBC_RLPReader Reader(Data);
+
+    if(!Reader.Next(OutItem))
+    {
+        OutErrorMessage = Reader.HasError() ? Reader.GetErrorMessage() : TEXT("No RLP item found");
+        return false;
+    }
+
+    if(!Reader.IsAtEnd())
+    {
+        OutErrorMessage = FString::Printf(
+            TEXT("Unexpected data after the RLP item at offset %d"),
+            OutItem.Offset + OutItem.GetEncodedSize());
+        return false;
+    }
+
+    return true;
+}
+
+bool CTSBC_RLPReader::Validate(const TArrayView<const uint8> Data, FString& OutErrorMessage)
+{
+    // Explicit stack, so that deeply nested input cannot exhaust the call stack
+    TArray<CTSBC_RLPReader, TInlineAllocator<16>> Readers;
+    Readers.Add(CTSBC_RLPReader(Data));
+
+    while(Readers.Num() > 0)
+    {
+        CTSBC_RLPReader& Reader = Readers.Last();
+
+        FTSBC_RLPItem Item;
+        if(Reader.Next(Item))
+        {
+            if(Item.bIsList)
+            {
+                // Adding may reallocate, so the reference above must not be used afterwards
+                const CTSBC_RLPReader ListReader = Reader.EnterList(Item);
+                Readers.Add(ListReader);
+            }
+
+            continue;
+        }
+
+        if(Reader.HasError())
+        {
+            OutErrorMessage = Reader.GetErrorMessage();
+            return false;
+        }
+
+        Readers.Pop(false);
+    }
+
+    return true;
+}
+
+bool CTSBC_RLPReader::Fail(const TCHAR* Message)
+{
+    ErrorMessage = FString::Printf(TEXT("%s at offset %d"), Message, Position);
+
+    // Nothing after malformed data can be trusted
+    Position = End;
+
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "Encoding/TSBC_RLPWriter.h"
+
+#include "Encoding/TSBC_RLP.h"
+
+CTSBC_RLPWriter::CTSBC_RLPWriter()
+    : NumEncodedBytes(0)
+{
+}
+
+void CTSBC_RLPWriter::AddBytes(const TArrayView<const uint8> Bytes)
+{
+    Nodes.Add(FNode{ENodeType::Bytes, Bytes.GetData(), Bytes.Num(), 0});
+    AddToParent(UTSBC_RLP::GetEncodedItemSize(Bytes));
+}
+
+void CTSBC_RLPWriter::AddUint64(const uint64 Value)
+{
+    uint8 Bytes[sizeof(uint64)];
+    int32 NumBytes = 0;
+    for(int32 Shift = 8 * (sizeof(uint64) - 1); Shift >= 0; Shift -= 8)
+    {
+        const uint8 Byte = static_cast<uint8>(Value >> Shift);
+        if(NumBytes > 0 || Byte != 0)
+        {
+            Bytes[NumBytes++] = Byte;
+        }
+    }
+
+    AddInteger(Bytes, NumBytes);
+}
+
+void CTSBC_RLPWriter::AddUint256(const FTSBC_uint256& Value)
+{
+    uint8 Bytes[FTSBC_uint256::NUM_BYTES];
+    const int32 NumBytes = Value.ToBytes(Bytes);
+
+    AddInteger(Bytes + FTSBC_uint256::NUM_BYTES - NumBytes, NumBytes);
+}
+
+void CTSBC_RLPWriter::AddFixedUint256(const FTSBC_uint256& Value)
+{
+    uint8 Bytes[FTSBC_uint256::NUM_BYTES];
+    Value.ToBytes(Bytes);
+
+    // Stored like an integer, but including leading zero bytes
+    AddInteger(Bytes, FTSBC_uint256::NUM_BYTES);
+}
+
+void CTSBC_RLPWriter::BeginList()
+{
+    OpenLists.Add(Nodes.Num());
+    Nodes.Add(FNode{ENodeType::List, nullptr, 0, 0});
+}
+
+void CTSBC_RLPWriter::EndList()
+{
+    check(OpenLists.Num() > 0);
+
+    const int32 ListIndex = OpenLists.Pop(false);
+    FNode& List = Nodes[ListIndex];
+    List.Index = Nodes.Num();
+
+    AddToParent(UTSBC_RLP::GetHeaderSize(List.NumBytes) + List.NumBytes);
+}
+
+bool CTSBC_RLPWriter::IsComplete() const
+{
+    return OpenLists.Num() == 0;
+}
+
+int32 CTSBC_RLPWriter::GetEncodedSize() const
+{
+    return NumEncodedBytes;
+}
+
+int32 CTSBC_RLPWriter::WriteTo(const TArrayView<uint8> Buffer) const
+{
+    if(!IsComplete() || Buffer.Num() < NumEncodedBytes)
+    {
+        return -1;
+    }
+
+    uint8* Dest = Buffer.GetData();
+    for(const FNode& Node : Nodes)
+    {
+        // Children of a list directly follow its node, so writing the header is enough
+        Dest = Node.Type == ENodeType::List
+               ? UTSBC_RLP::WriteHeader(Dest, Node.NumBytes, 0xC0)
+               : UTSBC_RLP::WriteItem(Dest, GetPayload(Node));
+    }
+
+    check(Dest - Buffer.GetData() == NumEncodedBytes);
+    return NumEncodedBytes;
+}
+
+bool CTSBC_RLPWriter::AppendTo(TArray<uint8>& Out) const
+{
+    if(!IsComplete())
+    {
+        return false;
+    }
+
+    const int32 Offset = Out.AddUninitialized(NumEncodedBytes);
+    WriteTo(TArrayView<uint8>(Out.GetData() + Offset, NumEncodedBytes));
+
+    return true;
+}
+
+TArray<uint8> CTSBC_RLPWriter::ToBytes() const
+{
+    TArray<uint8> Result;
+    AppendTo(Result);
+
+    return Result;
+}
+
+void CTSBC_RLPWriter::Reset()
+{
+    Nodes.Reset();
+    IntegerStorage.Reset();
+    OpenLists.Reset();
+    NumEncodedBytes = 0;
+}
+
+void CTSBC_RLPWriter::AddToParent(const int32 NumElementBytes)
+{
+    if(OpenLists.Num() > 0)
+    {
+        Nodes[OpenLists.Last()].NumBytes += NumElementBytes;
+    }
+    else
+    {
+        NumEncodedBytes += NumElementBytes;
+    }
+}
+
+void CTSBC_RLPWriter::AddInteger(const uint8* Bytes, const int32 NumBytes)
+{
+    const int32 Offset = IntegerStorage.Num();
+    IntegerStorage.Append(Bytes, NumBytes);
+
+    // The storage may still grow, so the node keeps an offset instead of a pointer
+    Nodes.Add(FNode{ENodeType::Integer, nullptr, NumBytes, Offset});
+    AddToParent(UTSBC_RLP::GetEncodedItemSize(TArrayView<const uint8>(Bytes, NumBytes)));
+}
+
+TArrayView<const uint8> CTSBC_RLPWriter::GetPayload(const FNode& Node) const
+{
+    return Node.Type == ENodeType::Integer
+           ? TArrayView<const uint8>(IntegerStorage.GetData() + Node.Index, Node.NumBytes)
+           : TArrayView<const uint8>(Node.Data, Node.NumBytes);
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "JsonRpc/Eth/Async/TSBC_EthGetLogsAsyncTask.h"
+
+#include "JsonRpc/Eth/TSBC_EthGetLogs.h"
+
+UTSBC_EthGetLogsAsyncTask* UTSBC_EthGetLogsAsyncTask::K2_EthGetLogsAsync(
+    const FString& URL,
+    const int64 FromBlock,
+    const int64 ToBlock,
+    const TArray<FString>& Addresses,
+    const TArray<FString>& Topics,
+    const int32 MaxConcurrentRequests)
+{
+    UTSBC_EthGetLogsAsyncTask* AsyncTask = NewObject<UTSBC_EthGetLogsAsyncTask>();
+    AsyncTask->_URL = URL;
+    AsyncTask->_FromBlock = FromBlock;
+    AsyncTask->_ToBlock = ToBlock;
+    AsyncTask->_Addresses = Addresses;
+    AsyncTask->_Topics = Topics;
+    AsyncTask->_MaxConcurrentRequests = MaxConcurrentRequests;
+
+    return AsyncTask;
+}
+
+void UTSBC_EthGetLogsAsyncTask::Activate()
+{
+    CTSBC_EthGetLogs::FTSBC_EthGetLogsBatch_Delegate InternalBatchDelegate;
+    InternalBatchDelegate.BindLambda(
+        [OnLogs=OnLogs](const int64 FromBlock, const int64 ToBlock, const TArray<FTSBC_EthLog>& Logs)
+        {
+            OnLogs.Broadcast(FromBlock, ToBlock, Logs);
+        });
+
+    CTSBC_EthGetLogs::FTSBC_EthGetLogsCompleted_Delegate InternalCompletedDelegate;
+    InternalCompletedDelegate.BindLambda(
+        [OnCompleted=OnCompleted](const bool bSuccess, const FTSBC_JsonRpcResponse& Response)
+        {
+            OnCompleted.Broadcast(bSuccess, Response);
+        });
+
+    TArray<TArray<FString>> Topics;
+    for(const FString& Topic : _Topics)
+    {
+        TArray<FString>& Alternatives = Topics.AddDefaulted_GetRef();
+        if(!Topic.TrimStartAndEnd().IsEmpty())
+        {
+            Alternatives.Add(Topic);
+        }
+    }
+
+    CTSBC_EthGetLogs::FTSBC_EthGetLogsOptions Options;
+    Options.MaxConcurrentRequests = _MaxConcurrentRequests;
+
+    CTSBC_EthGetLogs::EthGetLogs(
+        InternalBatchDelegate,
+        InternalCompletedDelegate,
+        _URL,
+        _FromBlock,
+        _ToBlock,
+        _Addresses,
+        Topics,
+        Options);
+}
\ No newline at end of file
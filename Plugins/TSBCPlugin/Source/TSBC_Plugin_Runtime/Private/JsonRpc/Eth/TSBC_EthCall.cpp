@@ -2,7 +2,9 @@
 
 #include "JsonRpc/Eth/TSBC_EthCall.h"
 
+#include "Module/TSBC_PluginUserSettings.h"
 #include "Module/TSBC_RuntimeLogCategories.h"
+#include "JsonRpc/Eth/TSBC_Multicall3.h"
 #include "JsonRpc/Generic/TSBC_SendJsonRpcRequest.h"
 #include "Blockchain/TSBC_EthereumBlockchainFunctionLibrary.h"
 
@@ -17,6 +19,20 @@ void CTSBC_EthCall::EthCall(
 {
     // TODO Currently only supports reading data; Impl writing data as well.
 
+    const FString FromAddressSanitized = FromAddress.TrimStartAndEnd();
+    const bool bWithoutFromAddress = FromAddressSanitized == ""
+                                     || FromAddressSanitized == "0"
+                                     || FromAddressSanitized == "0x"
+                                     || FromAddressSanitized == "0x0";
+
+    // Calls with a from address may depend on msg.sender, which would be the Multicall3 contract
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    if(Settings && Settings->bEthCallAggregationEnabled && bWithoutFromAddress)
+    {
+        CTSBC_Multicall3::EthCall(MoveTemp(ResponseDelegate), URL, ID, ToAddress, Data, BlockIdentifier);
+        return;
+    }
+
     CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcResponse_Delegate InternalCallback;
     InternalCallback.BindLambda(
         [ResponseDelegate](const FTSBC_JsonRpcResponse& Response)
@@ -44,11 +60,7 @@ void CTSBC_EthCall::EthCall(
             ResponseDelegate.ExecuteIfBound(Response.bSuccess, Response, ResponseData);
         });
 
-    const FString FromAddressSanitized = FromAddress.TrimStartAndEnd();
-    if(FromAddressSanitized == ""
-       || FromAddressSanitized == "0"
-       || FromAddressSanitized == "0x"
-       || FromAddressSanitized == "0x0")
+    if(bWithoutFromAddress)
     {
         CTSBC_SendJsonRpcRequest::SendJsonRpcRequest(
             InternalCallback,
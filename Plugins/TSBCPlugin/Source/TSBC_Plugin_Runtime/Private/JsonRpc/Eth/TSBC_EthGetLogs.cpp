@@ -0,0 +1,400 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "JsonRpc/Eth/TSBC_EthGetLogs.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "Containers/Ticker.h"
+// =============================================================================
+
+#include "JsonRpc/Eth/TSBC_EthGetTransactionReceipt.h"
+#include "JsonRpc/Generic/TSBC_SendJsonRpcRequest.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
+
+namespace
+{
+    /**
+     * @returns The values as JSON array of strings.
+     */
+    FString MakeJsonStringArray(const TArray<FString>& Values)
+    {
+        FString Json = "[";
+        for(int32 i = 0; i < Values.Num(); i++)
+        {
+            if(i > 0)
+            {
+                Json += ",";
+            }
+
+            Json += FString::Printf(TEXT("\"%s\""), *Values[i].TrimStartAndEnd());
+        }
+        Json += "]";
+
+        return Json;
+    }
+
+    FString MakeHexQuantity(const int64 Value)
+    {
+        return FString::Printf(TEXT("\"0x%llx\""), Value);
+    }
+}
+
+TSharedRef<CTSBC_EthGetLogs> CTSBC_EthGetLogs::EthGetLogs(
+    FTSBC_EthGetLogsBatch_Delegate BatchDelegate,
+    FTSBC_EthGetLogsCompleted_Delegate CompletedDelegate,
+    const FString& URL,
+    const int64 FromBlock,
+    const int64 ToBlock,
+    const TArray<FString>& Addresses,
+    const TArray<TArray<FString>>& Topics,
+    const FTSBC_EthGetLogsOptions& Options)
+{
+    const TSharedRef<CTSBC_EthGetLogs> EthGetLogs = MakeShared<CTSBC_EthGetLogs>(
+        MoveTemp(BatchDelegate),
+        MoveTemp(CompletedDelegate),
+        URL,
+        FromBlock,
+        ToBlock,
+        Addresses,
+        Topics,
+        Options);
+
+    EthGetLogs->Pump();
+
+    return EthGetLogs;
+}
+
+CTSBC_EthGetLogs::CTSBC_EthGetLogs(
+    FTSBC_EthGetLogsBatch_Delegate InBatchDelegate,
+    FTSBC_EthGetLogsCompleted_Delegate InCompletedDelegate,
+    const FString& InURL,
+    const int64 FromBlock,
+    const int64 InToBlock,
+    const TArray<FString>& Addresses,
+    const TArray<TArray<FString>>& Topics,
+    const FTSBC_EthGetLogsOptions& InOptions)
+    : BatchDelegate(MoveTemp(InBatchDelegate)),
+      CompletedDelegate(MoveTemp(InCompletedDelegate)),
+      URL(InURL),
+      Options(InOptions),
+      NextBlock(FromBlock),
+      ToBlock(InToBlock),
+      LastPassedOnBlock(FromBlock - 1)
+{
+    Options.MaxChunkSize = FMath::Max<int64>(1, Options.MaxChunkSize);
+    Options.MaxConcurrentRequests = FMath::Max(1, Options.MaxConcurrentRequests);
+    Options.InitialRetryDelay = FMath::Max(0.0f, Options.InitialRetryDelay);
+    Options.MaxRetryDelay = FMath::Max(Options.InitialRetryDelay, Options.MaxRetryDelay);
+    ChunkSize = FMath::Clamp<int64>(Options.InitialChunkSize, 1, Options.MaxChunkSize);
+
+    if(Addresses.Num() > 0)
+    {
+        FilterFields += FString::Printf(TEXT(",\"address\":%s"), *MakeJsonStringArray(Addresses));
+    }
+
+    if(Topics.Num() > 0)
+    {
+        FilterFields += ",\"topics\":[";
+        for(int32 i = 0; i < Topics.Num(); i++)
+        {
+            if(i > 0)
+            {
+                FilterFields += ",";
+            }
+
+            FilterFields += Topics[i].Num() > 0 ? MakeJsonStringArray(Topics[i]) : FString("null");
+        }
+        FilterFields += "]";
+    }
+}
+
+void CTSBC_EthGetLogs::Cancel()
+{
+    bFinished = true;
+    Chunks.Empty();
+    NumWaiting = 0;
+}
+
+int64 CTSBC_EthGetLogs::GetLastPassedOnBlock() const
+{
+    return LastPassedOnBlock;
+}
+
+void CTSBC_EthGetLogs::Pump()
+{
+    if(bFinished)
+    {
+        return;
+    }
+
+    // Chunks split after an error come first, they are the oldest
+    for(int32 i = 0; i < Chunks.Num() && NumInFlight < Options.MaxConcurrentRequests; i++)
+    {
+        if(Chunks[i].State == EChunkState::Pending)
+        {
+            SendChunk(Chunks[i]);
+        }
+    }
+
+    // New chunks wait until the failed ones went through, the node may be limiting the request rate
+    while(NumInFlight < Options.MaxConcurrentRequests && NumWaiting == 0 && NextBlock <= ToBlock)
+    {
+        FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+        Chunk.FromBlock = NextBlock;
+        Chunk.ToBlock = FMath::Min(ToBlock, NextBlock + ChunkSize - 1);
+        NextBlock = Chunk.ToBlock + 1;
+
+        SendChunk(Chunk);
+    }
+
+    if(Chunks.Num() == 0 && NextBlock > ToBlock)
+    {
+        Complete(true, FTSBC_JsonRpcResponse());
+    }
+}
+
+void CTSBC_EthGetLogs::SendChunk(FChunk& Chunk)
+{
+    Chunk.State = EChunkState::InFlight;
+    NumInFlight++;
+
+    CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcResponse_Delegate InternalCallback;
+    InternalCallback.BindLambda(
+        [This = AsShared(), FromBlock = Chunk.FromBlock](const FTSBC_JsonRpcResponse& Response)
+        {
+            This->OnChunkResponse(FromBlock, Response);
+        });
+
+    CTSBC_SendJsonRpcRequest::SendJsonRpcRequest(
+        InternalCallback,
+        URL,
+        FString::Printf(TEXT("EthGetLogs-%lld"), Chunk.FromBlock),
+        "eth_getLogs",
+        FString::Printf(
+            TEXT("{\"fromBlock\":%s,\"toBlock\":%s%s}"),
+            *MakeHexQuantity(Chunk.FromBlock),
+            *MakeHexQuantity(Chunk.ToBlock),
+            *FilterFields));
+}
+
+void CTSBC_EthGetLogs::OnChunkResponse(const int64 FromBlock, const FTSBC_JsonRpcResponse& Response)
+{
+    NumInFlight--;
+
+    const int32 ChunkIndex = Chunks.IndexOfByPredicate(
+        [FromBlock](const FChunk& Chunk)
+        {
+            return Chunk.FromBlock == FromBlock && Chunk.State == EChunkState::InFlight;
+        });
+
+    if(bFinished || ChunkIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Nodes also answer errors with status codes like 400 or 413, so the body is checked in any case
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+    const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Response.Body);
+    const bool bParsed = FJsonSerializer::Deserialize(JsonReader, JsonObject) && JsonObject.IsValid();
+
+    FChunk& Chunk = Chunks[ChunkIndex];
+
+    if(bParsed && JsonObject->HasTypedField<EJson::Array>("result"))
+    {
+        CTSBC_EthGetTransactionReceipt::ParseResponseField(JsonObject, "result", Chunk.Logs, false);
+        Chunk.State = EChunkState::Done;
+        NumConsecutiveFailures = 0;
+
+        // Grow again slowly, so a dense range right after a sparse one does not fail repeatedly
+        ChunkSize = FMath::Min(Options.MaxChunkSize, ChunkSize + FMath::Max<int64>(1, ChunkSize / 4));
+
+        PassOnDoneChunks();
+    }
+    else if(bParsed && IsRangeTooLargeError(JsonObject) && Chunk.FromBlock < Chunk.ToBlock)
+    {
+        const int64 MidBlock = Chunk.FromBlock + (Chunk.ToBlock - Chunk.FromBlock) / 2;
+        ChunkSize = FMath::Max<int64>(1, FMath::Min(ChunkSize, MidBlock - Chunk.FromBlock + 1));
+
+        FChunk SecondHalf;
+        SecondHalf.FromBlock = MidBlock + 1;
+        SecondHalf.ToBlock = Chunk.ToBlock;
+
+        const int64 FromSplitBlock = Chunk.FromBlock;
+        const int64 ToSplitBlock = Chunk.ToBlock;
+
+        Chunk.ToBlock = MidBlock;
+        Chunk.NumRetries = 0;
+
+        Chunks.Insert(MoveTemp(SecondHalf), ChunkIndex + 1);
+
+        ScheduleRetry(FromSplitBlock, ToSplitBlock);
+    }
+    else if(Chunk.NumRetries < Options.MaxRetries)
+    {
+        TSBC_LOG(
+            Warning,
+            TEXT("eth_getLogs failed for blocks %lld to %lld, retrying: %s"),
+            Chunk.FromBlock,
+            Chunk.ToBlock,
+            *Response.Body);
+
+        Chunk.NumRetries++;
+
+        ScheduleRetry(Chunk.FromBlock, Chunk.ToBlock);
+    }
+    else
+    {
+        TSBC_LOG(
+            Error,
+            TEXT("eth_getLogs failed for blocks %lld to %lld: %s"),
+            Chunk.FromBlock,
+            Chunk.ToBlock,
+            *Response.Body);
+
+        Complete(false, Response);
+        return;
+    }
+
+    Pump();
+}
+
+void CTSBC_EthGetLogs::ScheduleRetry(const int64 FromBlock, const int64 InToBlock)
+{
+    for(FChunk& Chunk : Chunks)
+    {
+        if(Chunk.FromBlock >= FromBlock && Chunk.ToBlock <= InToBlock && Chunk.State != EChunkState::Waiting)
+        {
+            Chunk.State = EChunkState::Waiting;
+            NumWaiting++;
+        }
+    }
+
+    const float Delay = FMath::Min(
+        Options.MaxRetryDelay,
+        Options.InitialRetryDelay * FMath::Pow(2.0f, FMath::Min(NumConsecutiveFailures, 16)));
+    NumConsecutiveFailures++;
+
+    FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda(
+            [This = AsShared(), FromBlock, InToBlock](float DeltaTime)
+            {
+                This->OnRetryDelayElapsed(FromBlock, InToBlock);
+                return false;
+            }),
+        Delay);
+}
+
+void CTSBC_EthGetLogs::OnRetryDelayElapsed(const int64 FromBlock, const int64 InToBlock)
+{
+    if(bFinished)
+    {
+        return;
+    }
+
+    for(FChunk& Chunk : Chunks)
+    {
+        if(Chunk.FromBlock >= FromBlock && Chunk.ToBlock <= InToBlock && Chunk.State == EChunkState::Waiting)
+        {
+            Chunk.State = EChunkState::Pending;
+            NumWaiting--;
+        }
+    }
+
+    Pump();
+}
+
+void CTSBC_EthGetLogs::PassOnDoneChunks()
+{
+    int32 NumDone = 0;
+    while(NumDone < Chunks.Num() && Chunks[NumDone].State == EChunkState::Done)
+    {
+        NumDone++;
+    }
+
+    if(NumDone == 0)
+    {
+        return;
+    }
+
+    // Removed before the delegate is called, which may cancel the fetch
+    TArray<FChunk> DoneChunks;
+    DoneChunks.Reserve(NumDone);
+    for(int32 i = 0; i < NumDone; i++)
+    {
+        DoneChunks.Add(MoveTemp(Chunks[i]));
+    }
+    Chunks.RemoveAt(0, NumDone, false);
+
+    for(const FChunk& Chunk : DoneChunks)
+    {
+        if(bFinished)
+        {
+            return;
+        }
+
+        LastPassedOnBlock = Chunk.ToBlock;
+
+        // ReSharper disable once CppExpressionWithoutSideEffects
+        BatchDelegate.ExecuteIfBound(Chunk.FromBlock, Chunk.ToBlock, Chunk.Logs);
+    }
+}
+
+void CTSBC_EthGetLogs::Complete(const bool bSuccess, const FTSBC_JsonRpcResponse& Response)
+{
+    if(bFinished)
+    {
+        return;
+    }
+
+    bFinished = true;
+    Chunks.Empty();
+    NumWaiting = 0;
+
+    // ReSharper disable once CppExpressionWithoutSideEffects
+    CompletedDelegate.ExecuteIfBound(bSuccess, Response);
+}
+
+bool CTSBC_EthGetLogs::IsRangeTooLargeError(const TSharedPtr<FJsonObject>& ResponseObject)
+{
+    const TSharedPtr<FJsonObject>* ErrorObject;
+    if(!ResponseObject->TryGetObjectField("error", ErrorObject))
+    {
+        return false;
+    }
+
+    // -32005 is the "limit exceeded" code of EIP-1474
+    int32 Code;
+    if((*ErrorObject)->TryGetNumberField("code", Code) && Code == -32005)
+    {
+        return true;
+    }
+
+    // Providers word this differently, e.g. "query returned more than 10000 results",
+    // "block range is too wide", "exceed maximum block range" or "Log response size exceeded"
+    FString Message;
+    if(!(*ErrorObject)->TryGetStringField("message", Message))
+    {
+        return false;
+    }
+
+    static const TCHAR* Patterns[] = {
+        TEXT("more than"),
+        TEXT("too many"),
+        TEXT("too large"),
+        TEXT("too wide"),
+        TEXT("block range"),
+        TEXT("limit exceeded"),
+        TEXT("size exceeded"),
+        TEXT("range exceeded"),
+    };
+
+    for(const TCHAR* Pattern : Patterns)
+    {
+        if(Message.Contains(Pattern, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
\ No newline at end of file
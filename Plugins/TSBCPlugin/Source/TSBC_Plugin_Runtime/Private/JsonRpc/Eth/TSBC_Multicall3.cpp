@@ -0,0 +1,593 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "JsonRpc/Eth/TSBC_Multicall3.h"
+
+#include "Blockchain/TSBC_EthereumBlockchainFunctionLibrary.h"
+#include "Encoding/TSBC_ContractAbiDecoding.h"
+#include "Encoding/TSBC_ContractAbiEncoding.h"
+#include "Encoding/TSBC_ContractAbiHelper.h"
+#include "JsonRpc/Generic/TSBC_SendJsonRpcRequest.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Module/TSBC_PluginUserSettings.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
+#include "Util/TSBC_StringUtils.h"
+
+TMap<FString, CTSBC_Multicall3::FTSBC_Multicall3Batch> CTSBC_Multicall3::PendingBatches;
+FTSTicker::FDelegateHandle CTSBC_Multicall3::FlushHandle;
+FCriticalSection CTSBC_Multicall3::PendingBatchesLock;
+
+namespace
+{
+    /**
+     * Function selector of "aggregate3((address,bool,bytes)[])".
+     */
+    const FString Aggregate3Selector = "0x82ad56cb";
+
+    /**
+     * @returns The "result" field of an "eth_call" response, empty if there is none.
+     */
+    FString GetEthCallResult(const FTSBC_JsonRpcResponse& Response)
+    {
+        if(!Response.bSuccess)
+        {
+            return "";
+        }
+
+        TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+        const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Response.Body);
+        if(!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+        {
+            return "";
+        }
+
+        if(!JsonObject->HasField("result"))
+        {
+            TSBC_LOG(Error, TEXT("Missing expected field 'result' in response body"));
+            return "";
+        }
+
+        return JsonObject->GetStringField("result");
+    }
+
+    /**
+     * Builds the response of one aggregated call from the response of the aggregated request.
+     *
+     * @param bDecoded Whether the aggregated request returned one result per call. If not, only the "id" field of
+     *                 the body is replaced, so the error of the aggregated request is kept.
+     * @param bCallSuccess Whether the call did not revert.
+     * @param ReturnData The call's return data, or its revert data.
+     * @returns The response with a body holding the call's ID and either its return data as "result" or the same
+     *          "execution reverted" error a plain "eth_call" would be answered with.
+     */
+    FTSBC_JsonRpcResponse MakeMulticall3CallResponse(
+        const FTSBC_JsonRpcResponse& Response,
+        const FString& ID,
+        const bool bDecoded,
+        const bool bCallSuccess,
+        const FString& ReturnData)
+    {
+        TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject());
+        if(bDecoded)
+        {
+            ResponseObject->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+            ResponseObject->SetStringField(TEXT("id"), ID);
+
+            if(bCallSuccess)
+            {
+                ResponseObject->SetStringField(TEXT("result"), ReturnData);
+            }
+            else
+            {
+                const TSharedRef<FJsonObject> ErrorObject = MakeShareable(new FJsonObject());
+                ErrorObject->SetNumberField(TEXT("code"), 3);
+                ErrorObject->SetStringField(TEXT("message"), TEXT("execution reverted"));
+                ErrorObject->SetStringField(TEXT("data"), ReturnData);
+                ResponseObject->SetObjectField(TEXT("error"), ErrorObject);
+            }
+        }
+        else
+        {
+            const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Response.Body);
+            if(!FJsonSerializer::Deserialize(JsonReader, ResponseObject)
+                || !ResponseObject.IsValid()
+                || !ResponseObject->HasField(TEXT("id")))
+            {
+                return Response;
+            }
+
+            ResponseObject->SetStringField(TEXT("id"), ID);
+        }
+
+        FTSBC_JsonRpcResponse CallResponse = Response;
+        CallResponse.Body.Reset();
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&CallResponse.Body);
+        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), JsonWriter);
+
+        return CallResponse;
+    }
+
+    /**
+     * Appends an unsigned integer as 32-byte ABI word.
+     */
+    void AppendAbiWord(FString& EncodedData, const uint64 Value)
+    {
+        EncodedData.Append(FString::ChrN(AbiSegmentCharLength - 16, TEXT('0')));
+        EncodedData.Append(FString::Printf(TEXT("%016llx"), Value));
+    }
+
+    /**
+     * Encodes the calldata of "aggregate3" with every call allowed to fail.
+     *
+     * The existing ABI encoder does not support arrays of tuples, so the (address,bool,bytes)[] argument is laid out
+     * here: the offset of the array, its length, the offset of each tuple relative to the first one's offset, and
+     * the tuples, each with the address, the flag, the offset and length of the bytes, and the padded bytes.
+     *
+     * @returns False if an address or calldata is not valid hex.
+     */
+    bool EncodeAggregate3(
+        const TArray<FString>& Targets,
+        const TArray<FString>& CallData,
+        FString& FunctionSelectorAndEncodedArguments)
+    {
+        TArray<FString> Addresses;
+        TArray<FString> Bytes;
+        Addresses.Reserve(Targets.Num());
+        Bytes.Reserve(CallData.Num());
+
+        for(int32 i = 0; i < Targets.Num(); i++)
+        {
+            FString Address = Targets[i].TrimStartAndEnd().ToLower();
+            FString Data = CallData[i].TrimStartAndEnd().ToLower();
+            Address.RemoveFromStart("0x");
+            Data.RemoveFromStart("0x");
+
+            if(Address.Len() != EthereumAddressCharLength
+                || !TSBC_StringUtils::IsHexString(Address, false)
+                || Data.Len() % 2 != 0
+                || (!Data.IsEmpty() && !TSBC_StringUtils::IsHexString(Data, false)))
+            {
+                TSBC_LOG(Error, TEXT("Invalid call for Multicall3: To<%s> Data<%s>"), *Targets[i], *CallData[i]);
+                return false;
+            }
+
+            Addresses.Add(MoveTemp(Address));
+            Bytes.Add(MoveTemp(Data));
+        }
+
+        // 4 words per tuple plus the padded bytes, 2 words for offset and length, 1 word per tuple offset
+        int32 NumChars = Aggregate3Selector.Len() + (2 + Targets.Num()) * AbiSegmentCharLength;
+        for(const FString& Data : Bytes)
+        {
+            NumChars += 4 * AbiSegmentCharLength + Align(Data.Len(), AbiSegmentCharLength);
+        }
+
+        FString& Out = FunctionSelectorAndEncodedArguments;
+        Out.Reset(NumChars);
+        Out.Append(Aggregate3Selector);
+
+        AppendAbiWord(Out, AbiSegmentBytesLength);
+        AppendAbiWord(Out, Targets.Num());
+
+        uint64 TupleOffset = Targets.Num() * AbiSegmentBytesLength;
+        for(const FString& Data : Bytes)
+        {
+            AppendAbiWord(Out, TupleOffset);
+            TupleOffset += 4 * AbiSegmentBytesLength + Align(Data.Len(), AbiSegmentCharLength) / 2;
+        }
+
+        for(int32 i = 0; i < Addresses.Num(); i++)
+        {
+            Out.Append(TSBC_StringUtils::ZeroPadLeft(Addresses[i], AbiSegmentCharLength));
+            AppendAbiWord(Out, 1);
+            AppendAbiWord(Out, 3 * AbiSegmentBytesLength);
+            AppendAbiWord(Out, Bytes[i].Len() / 2);
+            Out.Append(TSBC_StringUtils::ZeroPadRight(Bytes[i], Align(Bytes[i].Len(), AbiSegmentCharLength)));
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads a 32-byte ABI word holding an offset, length or flag.
+     *
+     * @returns False if the word is out of bounds or its value exceeds the data, which is never valid.
+     */
+    bool ReadAbiWord(const TArray<uint8>& Data, const int64 Offset, int64& OutValue)
+    {
+        if(Offset < 0 || Offset + AbiSegmentBytesLength > Data.Num())
+        {
+            return false;
+        }
+
+        uint64 Value = 0;
+        for(int32 i = 0; i < AbiSegmentBytesLength; i++)
+        {
+            Value = Value << 8 | Data[Offset + i];
+            if(Value > static_cast<uint64>(Data.Num()))
+            {
+                return false;
+            }
+        }
+
+        OutValue = static_cast<int64>(Value);
+        return true;
+    }
+
+    /**
+     * Decodes the (bool success, bytes returnData)[] returned by "aggregate3".
+     *
+     * @returns False if the data is malformed or does not hold one result per call.
+     */
+    bool DecodeAggregate3(
+        const FString& ReturnData,
+        const int32 NumCalls,
+        TArray<bool>& OutSuccess,
+        TArray<FString>& OutReturnData)
+    {
+        FString Hex = ReturnData.TrimStartAndEnd();
+        if(!Hex.RemoveFromStart("0x") || Hex.Len() % 2 != 0 || !TSBC_StringUtils::IsHexString(Hex, false))
+        {
+            return false;
+        }
+
+        TArray<uint8> Data;
+        Data.AddUninitialized(Hex.Len() / 2);
+        HexToBytes(Hex, Data.GetData());
+
+        int64 ArrayOffset;
+        int64 Length;
+        if(!ReadAbiWord(Data, 0, ArrayOffset) || !ReadAbiWord(Data, ArrayOffset, Length) || Length != NumCalls)
+        {
+            return false;
+        }
+
+        OutSuccess.Reset(NumCalls);
+        OutReturnData.Reset(NumCalls);
+
+        const int64 ArrayStart = ArrayOffset + AbiSegmentBytesLength;
+        for(int32 i = 0; i < NumCalls; i++)
+        {
+            int64 TupleOffset;
+            int64 bSuccess;
+            int64 BytesOffset;
+            int64 BytesLength;
+            if(!ReadAbiWord(Data, ArrayStart + i * AbiSegmentBytesLength, TupleOffset)
+                || !ReadAbiWord(Data, ArrayStart + TupleOffset, bSuccess)
+                || !ReadAbiWord(Data, ArrayStart + TupleOffset + AbiSegmentBytesLength, BytesOffset)
+                || !ReadAbiWord(Data, ArrayStart + TupleOffset + BytesOffset, BytesLength))
+            {
+                return false;
+            }
+
+            const int64 BytesStart = ArrayStart + TupleOffset + BytesOffset + AbiSegmentBytesLength;
+            if(bSuccess > 1 || BytesStart + BytesLength > Data.Num())
+            {
+                return false;
+            }
+
+            OutSuccess.Add(bSuccess == 1);
+            OutReturnData.Add("0x" + BytesToHex(Data.GetData() + BytesStart, static_cast<int32>(BytesLength)).ToLower());
+        }
+
+        return true;
+    }
+}
+
+void CTSBC_Multicall3::EthCall(
+    CTSBC_EthCall::FTSBC_EthCall_Delegate ResponseDelegate,
+    const FString& URL,
+    const FString& ID,
+    const FString& ToAddress,
+    const FString& Data,
+    const ETSBC_EthBlockIdentifier BlockIdentifier)
+{
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    const float Window = Settings ? FMath::Max(0.0f, Settings->EthCallAggregationWindow) : 0.0f;
+    const int32 MaxCalls = Settings ? FMath::Max(1, Settings->EthCallAggregationMaxCalls) : 1;
+
+    const FString Block = UTSBC_EthereumBlockchainFunctionLibrary::BlockIdentifierFromEnum(BlockIdentifier);
+    const FString Key = URL + TEXT("\n") + Block;
+
+    FTSBC_Multicall3Batch FullBatch;
+    {
+        FScopeLock Lock(&PendingBatchesLock);
+
+        FTSBC_Multicall3Batch& Batch = PendingBatches.FindOrAdd(Key);
+        Batch.URL = URL;
+        Batch.BlockIdentifier = Block;
+        Batch.Calls.Add({MoveTemp(ResponseDelegate), ID, ToAddress, Data});
+
+        if(Batch.Calls.Num() >= MaxCalls)
+        {
+            FullBatch = MoveTemp(Batch);
+            PendingBatches.Remove(Key);
+        }
+        else if(!FlushHandle.IsValid())
+        {
+            FlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+                FTickerDelegate::CreateStatic(&CTSBC_Multicall3::FlushTick),
+                Window);
+        }
+    }
+
+    if(FullBatch.Calls.Num() > 0)
+    {
+        SendBatch(MoveTemp(FullBatch));
+    }
+}
+
+void CTSBC_Multicall3::CallFunction(
+    FTSBC_Multicall3Function_Delegate ResponseDelegate,
+    const FString& URL,
+    const FString& ToAddress,
+    const FTSBC_ContractAbi& ContractAbi,
+    const FString& FunctionName,
+    const TArray<FTSBC_SolidityValueList>& Arguments,
+    const ETSBC_EthBlockIdentifier BlockIdentifier)
+{
+    bool bSuccess;
+    FString ErrorMessage;
+    FString FunctionSelectorAndEncodedArguments;
+    CTSBC_ContractAbiEncoding::EncodeAbi(
+        bSuccess,
+        ErrorMessage,
+        ContractAbi,
+        FunctionName,
+        Arguments,
+        FunctionSelectorAndEncodedArguments);
+
+    if(!bSuccess)
+    {
+        // ReSharper disable once CppExpressionWithoutSideEffects
+        ResponseDelegate.ExecuteIfBound(false, ErrorMessage, {});
+        return;
+    }
+
+    // Only the called function is needed for decoding, so the rest of the ABI is not kept around
+    FTSBC_ContractAbi FunctionAbi;
+    CTSBC_ContractAbiHelper::IsFunctionAvailable(
+        ContractAbi,
+        FunctionName,
+        FunctionAbi.ContractAbiFunctions.AddDefaulted_GetRef());
+
+    CTSBC_EthCall::FTSBC_EthCall_Delegate InternalCallback;
+    InternalCallback.BindLambda(
+        [ResponseDelegate, FunctionAbi, FunctionName](
+        const bool bCallSuccess,
+        const FTSBC_JsonRpcResponse& Response,
+        const FString& ResponseData)
+        {
+            TArray<FTSBC_SolidityValueList> DecodedValues;
+
+            if(!bCallSuccess)
+            {
+                const FString CallErrorMessage = Response.bSuccess
+                                                     ? FString::Printf(TEXT("Call reverted: %s"), *ResponseData)
+                                                     : FString("Request failed");
+
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(false, CallErrorMessage, DecodedValues);
+                return;
+            }
+
+            bool bDecodeSuccess;
+            FString DecodeErrorMessage;
+            CTSBC_ContractAbiDecoding::DecodeAbi(
+                bDecodeSuccess,
+                DecodeErrorMessage,
+                FunctionAbi,
+                FunctionName,
+                ResponseData,
+                DecodedValues);
+
+            // ReSharper disable once CppExpressionWithoutSideEffects
+            ResponseDelegate.ExecuteIfBound(bDecodeSuccess, DecodeErrorMessage, DecodedValues);
+        });
+
+    EthCall(InternalCallback, URL, "Multicall3", ToAddress, FunctionSelectorAndEncodedArguments, BlockIdentifier);
+}
+
+void CTSBC_Multicall3::CallFunction(
+    FTSBC_Multicall3Function_Delegate ResponseDelegate,
+    const FString& URL,
+    const FString& ToAddress,
+    const TSharedRef<const CTSBC_CompiledContractAbi>& CompiledAbi,
+    const FString& FunctionName,
+    const TArray<FTSBC_SolidityValueList>& Arguments,
+    const ETSBC_EthBlockIdentifier BlockIdentifier)
+{
+    const FTSBC_CompiledAbiFunction* Function = CompiledAbi->FindFunction(FunctionName);
+    if(!Function)
+    {
+        // ReSharper disable once CppExpressionWithoutSideEffects
+        ResponseDelegate.ExecuteIfBound(false, FString("Function not found"), {});
+        return;
+    }
+
+    FString ErrorMessage;
+    FString FunctionSelectorAndEncodedArguments;
+    if(!CompiledAbi->EncodeFunctionCall(ErrorMessage, *Function, Arguments, FunctionSelectorAndEncodedArguments))
+    {
+        // ReSharper disable once CppExpressionWithoutSideEffects
+        ResponseDelegate.ExecuteIfBound(false, ErrorMessage, {});
+        return;
+    }
+
+    // The function stays valid as long as the compiled ABI is kept alive by the callback
+    CTSBC_EthCall::FTSBC_EthCall_Delegate InternalCallback;
+    InternalCallback.BindLambda(
+        [ResponseDelegate, CompiledAbi, Function](
+        const bool bCallSuccess,
+        const FTSBC_JsonRpcResponse& Response,
+        const FString& ResponseData)
+        {
+            TArray<FTSBC_SolidityValueList> DecodedValues;
+
+            if(!bCallSuccess)
+            {
+                const FString CallErrorMessage = Response.bSuccess
+                                                     ? FString::Printf(TEXT("Call reverted: %s"), *ResponseData)
+                                                     : FString("Request failed");
+
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(false, CallErrorMessage, DecodedValues);
+                return;
+            }
+
+            FString DecodeErrorMessage;
+            const bool bDecodeSuccess = CompiledAbi->DecodeFunctionResult(
+                DecodeErrorMessage,
+                *Function,
+                ResponseData,
+                DecodedValues);
+
+            // ReSharper disable once CppExpressionWithoutSideEffects
+            ResponseDelegate.ExecuteIfBound(bDecodeSuccess, DecodeErrorMessage, DecodedValues);
+        });
+
+    EthCall(InternalCallback, URL, "Multicall3", ToAddress, FunctionSelectorAndEncodedArguments, BlockIdentifier);
+}
+
+void CTSBC_Multicall3::Flush()
+{
+    TMap<FString, FTSBC_Multicall3Batch> Batches;
+    {
+        FScopeLock Lock(&PendingBatchesLock);
+
+        Batches = MoveTemp(PendingBatches);
+        PendingBatches.Reset();
+
+        if(FlushHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+            FlushHandle.Reset();
+        }
+    }
+
+    // Sent outside of the lock, since the delegates may queue further calls
+    for(TPair<FString, FTSBC_Multicall3Batch>& Batch : Batches)
+    {
+        SendBatch(MoveTemp(Batch.Value));
+    }
+}
+
+void CTSBC_Multicall3::Shutdown()
+{
+    FScopeLock Lock(&PendingBatchesLock);
+
+    PendingBatches.Empty();
+
+    if(FlushHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+        FlushHandle.Reset();
+    }
+}
+
+void CTSBC_Multicall3::SendBatch(FTSBC_Multicall3Batch&& Batch)
+{
+    TArray<FTSBC_Multicall3Call> Calls = MoveTemp(Batch.Calls);
+
+    if(Calls.Num() == 1)
+    {
+        CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcResponse_Delegate InternalCallback;
+        InternalCallback.BindLambda(
+            [ResponseDelegate = MoveTemp(Calls[0].ResponseDelegate)](const FTSBC_JsonRpcResponse& Response)
+            {
+                // A reverted call is answered with an error instead of a result
+                const FString Result = GetEthCallResult(Response);
+
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(!Result.IsEmpty(), Response, Result);
+            });
+
+        CTSBC_SendJsonRpcRequest::SendJsonRpcRequest(
+            InternalCallback,
+            Batch.URL,
+            Calls[0].ID,
+            "eth_call",
+            FString::Printf(
+                TEXT("{\"to\":\"%s\",\"data\":\"%s\"}, \"%s\""),
+                *Calls[0].ToAddress,
+                *Calls[0].Data,
+                *Batch.BlockIdentifier));
+        return;
+    }
+
+    TArray<FString> Targets;
+    TArray<FString> CallData;
+    Targets.Reserve(Calls.Num());
+    CallData.Reserve(Calls.Num());
+    for(const FTSBC_Multicall3Call& Call : Calls)
+    {
+        Targets.Add(Call.ToAddress);
+        CallData.Add(Call.Data);
+    }
+
+    FString FunctionSelectorAndEncodedArguments;
+    if(!EncodeAggregate3(Targets, CallData, FunctionSelectorAndEncodedArguments))
+    {
+        // Sent one by one, so only the invalid call fails
+        for(FTSBC_Multicall3Call& Call : Calls)
+        {
+            FTSBC_Multicall3Batch SingleBatch{Batch.URL, Batch.BlockIdentifier};
+            SingleBatch.Calls.Add(MoveTemp(Call));
+            SendBatch(MoveTemp(SingleBatch));
+        }
+        return;
+    }
+
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    const FString Multicall3Address = Settings ? Settings->Multicall3Address : FString();
+
+    CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcResponse_Delegate InternalCallback;
+    InternalCallback.BindLambda(
+        [Calls = MoveTemp(Calls)](const FTSBC_JsonRpcResponse& Response)
+        {
+            TArray<bool> Success;
+            TArray<FString> ReturnData;
+            const bool bDecoded = DecodeAggregate3(GetEthCallResult(Response), Calls.Num(), Success, ReturnData);
+            if(Response.bSuccess && !bDecoded)
+            {
+                TSBC_LOG(Error, TEXT("Unexpected Multicall3 response: %s"), *Response.Body);
+            }
+
+            for(int32 i = 0; i < Calls.Num(); i++)
+            {
+                const bool bCallSuccess = bDecoded && Success[i];
+                const FString CallReturnData = bDecoded ? ReturnData[i] : FString();
+
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                Calls[i].ResponseDelegate.ExecuteIfBound(
+                    bCallSuccess,
+                    MakeMulticall3CallResponse(Response, Calls[i].ID, bDecoded, bCallSuccess, CallReturnData),
+                    CallReturnData);
+            }
+        });
+
+    CTSBC_SendJsonRpcRequest::SendJsonRpcRequest(
+        InternalCallback,
+        Batch.URL,
+        "Multicall3",
+        "eth_call",
+        FString::Printf(
+            TEXT("{\"to\":\"%s\",\"data\":\"%s\"}, \"%s\""),
+            *Multicall3Address,
+            *FunctionSelectorAndEncodedArguments,
+            *Batch.BlockIdentifier));
+}
+
+bool CTSBC_Multicall3::FlushTick(float DeltaTime)
+{
+    {
+        FScopeLock Lock(&PendingBatchesLock);
+
+        // The ticker is removed by returning false
+        FlushHandle.Reset();
+    }
+
+    Flush();
+
+    return false;
+}
\ No newline at end of file
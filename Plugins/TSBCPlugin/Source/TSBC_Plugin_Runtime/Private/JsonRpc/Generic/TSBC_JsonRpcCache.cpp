@@ -0,0 +1,396 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "JsonRpc/Generic/TSBC_JsonRpcCache.h"
+
+#include "Module/TSBC_PluginUserSettings.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+// =============================================================================
+
+namespace
+{
+    FString MakeCacheKey(const FString& URL, const FString& Method, const FString& Params)
+    {
+        return URL + TEXT("\n") + Method + TEXT("\n") + Params;
+    }
+
+    /**
+     * Parses a quantity like "0x1b4".
+     */
+    bool ParseHexQuantity(const FString& Hex, uint64& OutValue)
+    {
+        if(Hex.Len() < 3 || Hex.Len() > 18 || !Hex.StartsWith(TEXT("0x")))
+        {
+            return false;
+        }
+
+        TCHAR* End = nullptr;
+        OutValue = FCString::Strtoui64(*Hex + 2, &End, 16);
+        return End == *Hex + Hex.Len();
+    }
+
+    /**
+     * @returns Index of the block parameter of a method.
+     */
+    int32 GetBlockParamIndex(const FString& Method)
+    {
+        return Method == TEXT("eth_getStorageAt") ? 2 : 1;
+    }
+}
+
+CTSBC_JsonRpcCache& CTSBC_JsonRpcCache::Get()
+{
+    static CTSBC_JsonRpcCache Instance;
+    return Instance;
+}
+
+bool CTSBC_JsonRpcCache::IsCacheableMethod(const FString& Method)
+{
+    static const TCHAR* CacheableMethods[] = {
+        TEXT("eth_call"),
+        TEXT("eth_chainId"),
+        TEXT("eth_getBalance"),
+        TEXT("eth_getCode"),
+        TEXT("eth_getStorageAt"),
+        TEXT("eth_getTransactionCount"),
+        TEXT("eth_getTransactionReceipt"),
+    };
+
+    for(const TCHAR* CacheableMethod : CacheableMethods)
+    {
+        if(Method.Equals(CacheableMethod, ESearchCase::CaseSensitive))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CTSBC_JsonRpcCache::Find(
+    const FString& URL,
+    const FString& ID,
+    const FString& Method,
+    const FString& Params,
+    FTSBC_JsonRpcResponse& OutResponse)
+{
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    const double MaxAge = Settings ? Settings->JsonRpcCacheMaxAge : 0.0;
+    const FString Key = MakeCacheKey(URL, Method, Params);
+
+    FScopeLock ScopeLock(&Lock);
+
+    const int32* Index = IndexByKey.Find(Key);
+    if(!Index)
+    {
+        Stats.NumMisses++;
+        return false;
+    }
+
+    const FEntry& Entry = Entries[*Index];
+    if(!Entry.bPermanent)
+    {
+        const uint64* LatestBlock = LatestBlocks.Find(URL);
+        const bool bIsStale = Entry.BlockNumber != (LatestBlock ? *LatestBlock : 0)
+                              || FPlatformTime::Seconds() - Entry.StoreTime > MaxAge;
+        if(bIsStale)
+        {
+            RemoveEntry(*Index);
+            Stats.NumMisses++;
+            return false;
+        }
+    }
+
+    OutResponse.bSuccess = true;
+    OutResponse.StatusCode = Entry.StatusCode;
+    OutResponse.Headers = Entry.Headers;
+    OutResponse.Body = FString::Printf(TEXT("{\"id\":\"%s\",%s"), *ID, *Entry.BodyWithoutId + 1);
+
+    Unlink(*Index);
+    LinkAsMostRecent(*Index);
+
+    Stats.NumHits++;
+    return true;
+}
+
+void CTSBC_JsonRpcCache::Store(
+    const FString& URL,
+    const FString& Method,
+    const FString& Params,
+    const FTSBC_JsonRpcResponse& Response)
+{
+    if(!Response.bSuccess)
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject());
+    const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Response.Body);
+    if(!FJsonSerializer::Deserialize(JsonReader, ResponseObject)
+        || !ResponseObject.IsValid()
+        || !ResponseObject->HasField("result")
+        || ResponseObject->HasField("error"))
+    {
+        return;
+    }
+
+    if(Method == TEXT("eth_blockNumber"))
+    {
+        uint64 BlockNumber;
+        if(ParseHexQuantity(ResponseObject->GetStringField("result"), BlockNumber))
+        {
+            FScopeLock ScopeLock(&Lock);
+
+            uint64& LatestBlock = LatestBlocks.FindOrAdd(URL);
+            LatestBlock = FMath::Max(LatestBlock, BlockNumber);
+        }
+
+        return;
+    }
+
+    const bool bIsReceipt = Method == TEXT("eth_getTransactionReceipt");
+    if(!IsCacheableMethod(Method) || (!bIsReceipt && ResponseObject->HasTypedField<EJson::Null>("result")))
+    {
+        return;
+    }
+
+    // The ID is added again for every request answered from the cache
+    ResponseObject->RemoveField("id");
+    FString BodyWithoutId;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&BodyWithoutId);
+    FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), JsonWriter);
+
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    const int64 Budget = static_cast<int64>(Settings ? Settings->JsonRpcCacheSizeMB : 0) * 1024 * 1024;
+    const FString Key = MakeCacheKey(URL, Method, Params);
+
+    int64 NumBytes = sizeof(FEntry) + (Key.Len() + BodyWithoutId.Len()) * sizeof(TCHAR);
+    for(const FString& Header : Response.Headers)
+    {
+        NumBytes += sizeof(FString) + Header.Len() * sizeof(TCHAR);
+    }
+
+    if(NumBytes > Budget)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+
+    ELifetime Lifetime;
+    if(bIsReceipt)
+    {
+        Lifetime = GetReceiptLifetime(URL, ResponseObject);
+    }
+    else if(Method == TEXT("eth_chainId"))
+    {
+        Lifetime = ELifetime::Permanent;
+    }
+    else
+    {
+        Lifetime = GetBlockTagLifetime(URL, Method, Params);
+    }
+
+    if(Lifetime == ELifetime::None)
+    {
+        return;
+    }
+
+    if(const int32* ExistingIndex = IndexByKey.Find(Key))
+    {
+        RemoveEntry(*ExistingIndex);
+    }
+
+    const int32 Index = FreeIndices.Num() > 0 ? FreeIndices.Pop(false) : Entries.AddDefaulted();
+
+    const uint64* LatestBlock = LatestBlocks.Find(URL);
+
+    FEntry& Entry = Entries[Index];
+    Entry.Key = Key;
+    Entry.BodyWithoutId = MoveTemp(BodyWithoutId);
+    Entry.StatusCode = Response.StatusCode;
+    Entry.Headers = Response.Headers;
+    Entry.BlockNumber = LatestBlock ? *LatestBlock : 0;
+    Entry.StoreTime = FPlatformTime::Seconds();
+    Entry.bPermanent = Lifetime == ELifetime::Permanent;
+    Entry.NumBytes = NumBytes;
+
+    IndexByKey.Add(Key, Index);
+    LinkAsMostRecent(Index);
+
+    Stats.NumEntries++;
+    Stats.NumBytes += NumBytes;
+
+    while(Stats.NumBytes > Budget && LeastRecent != Index)
+    {
+        RemoveEntry(LeastRecent);
+        Stats.NumEvictions++;
+    }
+}
+
+void CTSBC_JsonRpcCache::Empty()
+{
+    FScopeLock ScopeLock(&Lock);
+
+    Entries.Empty();
+    FreeIndices.Empty();
+    IndexByKey.Empty();
+    MostRecent = INDEX_NONE;
+    LeastRecent = INDEX_NONE;
+
+    Stats.NumEntries = 0;
+    Stats.NumBytes = 0;
+}
+
+FTSBC_JsonRpcCacheStats CTSBC_JsonRpcCache::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Stats;
+}
+
+CTSBC_JsonRpcCache::ELifetime CTSBC_JsonRpcCache::GetBlockTagLifetime(
+    const FString& URL,
+    const FString& Method,
+    const FString& Params) const
+{
+    TArray<TSharedPtr<FJsonValue>> ParamValues;
+    const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(TEXT("[") + Params + TEXT("]"));
+    if(!FJsonSerializer::Deserialize(JsonReader, ParamValues))
+    {
+        return ELifetime::None;
+    }
+
+    // Nodes use the latest block if the parameter is omitted
+    const int32 BlockParamIndex = GetBlockParamIndex(Method);
+    if(!ParamValues.IsValidIndex(BlockParamIndex))
+    {
+        return ELifetime::Block;
+    }
+
+    FString BlockTag;
+    const TSharedPtr<FJsonObject>* BlockObject;
+    if(ParamValues[BlockParamIndex]->TryGetObject(BlockObject))
+    {
+        // EIP-1898: a block hash always refers to the same state
+        if((*BlockObject)->HasField("blockHash"))
+        {
+            return ELifetime::Permanent;
+        }
+
+        BlockTag = (*BlockObject)->GetStringField("blockNumber");
+    }
+    else if(!ParamValues[BlockParamIndex]->TryGetString(BlockTag))
+    {
+        return ELifetime::None;
+    }
+
+    if(BlockTag == TEXT("latest") || BlockTag == TEXT("safe") || BlockTag == TEXT("finalized"))
+    {
+        return ELifetime::Block;
+    }
+
+    if(BlockTag == TEXT("earliest"))
+    {
+        return ELifetime::Permanent;
+    }
+
+    uint64 BlockNumber;
+    if(ParseHexQuantity(BlockTag, BlockNumber))
+    {
+        return IsFinal(URL, BlockNumber) ? ELifetime::Permanent : ELifetime::Block;
+    }
+
+    // "pending" and anything unknown
+    return ELifetime::None;
+}
+
+CTSBC_JsonRpcCache::ELifetime CTSBC_JsonRpcCache::GetReceiptLifetime(
+    const FString& URL,
+    const TSharedPtr<FJsonObject>& ResponseObject) const
+{
+    // Not mined yet, which may change with the next block
+    const TSharedPtr<FJsonObject>* Receipt;
+    if(!ResponseObject->TryGetObjectField("result", Receipt))
+    {
+        return ELifetime::Block;
+    }
+
+    uint64 BlockNumber;
+    if(ParseHexQuantity((*Receipt)->GetStringField("blockNumber"), BlockNumber) && IsFinal(URL, BlockNumber))
+    {
+        return ELifetime::Permanent;
+    }
+
+    return ELifetime::Block;
+}
+
+bool CTSBC_JsonRpcCache::IsFinal(const FString& URL, const uint64 BlockNumber) const
+{
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    const uint64 FinalityDepth = Settings ? FMath::Max(0, Settings->JsonRpcCacheFinalityDepth) : 0;
+
+    const uint64* LatestBlock = LatestBlocks.Find(URL);
+    return LatestBlock && BlockNumber + FinalityDepth <= *LatestBlock;
+}
+
+void CTSBC_JsonRpcCache::LinkAsMostRecent(const int32 Index)
+{
+    FEntry& Entry = Entries[Index];
+    Entry.MoreRecent = INDEX_NONE;
+    Entry.LessRecent = MostRecent;
+
+    if(MostRecent != INDEX_NONE)
+    {
+        Entries[MostRecent].MoreRecent = Index;
+    }
+    else
+    {
+        LeastRecent = Index;
+    }
+
+    MostRecent = Index;
+}
+
+void CTSBC_JsonRpcCache::Unlink(const int32 Index)
+{
+    const FEntry& Entry = Entries[Index];
+
+    if(Entry.MoreRecent != INDEX_NONE)
+    {
+        Entries[Entry.MoreRecent].LessRecent = Entry.LessRecent;
+    }
+    else
+    {
+        MostRecent = Entry.LessRecent;
+    }
+
+    if(Entry.LessRecent != INDEX_NONE)
+    {
+        Entries[Entry.LessRecent].MoreRecent = Entry.MoreRecent;
+    }
+    else
+    {
+        LeastRecent = Entry.MoreRecent;
+    }
+}
+
+void CTSBC_JsonRpcCache::RemoveEntry(const int32 Index)
+{
+    Unlink(Index);
+
+    FEntry& Entry = Entries[Index];
+    IndexByKey.Remove(Entry.Key);
+
+    Stats.NumEntries--;
+    Stats.NumBytes -= Entry.NumBytes;
+
+    // Release the strings now, the slot itself is reused by the next entry
+    Entry = FEntry();
+    FreeIndices.Add(Index);
+}
\ No newline at end of file
@@ -0,0 +1,487 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#include "JsonRpc/Generic/TSBC_RpcEndpointPool.h"
+
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "Async/Async.h"
+// =============================================================================
+
+TMap<FString, TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe>> CTSBC_RpcEndpointPool::Pools;
+FCriticalSection CTSBC_RpcEndpointPool::PoolsLock;
+
+namespace
+{
+    /**
+     * Number of latencies kept per endpoint for the 95th percentile.
+     */
+    constexpr int32 NumRecentLatencies = 64;
+
+    /**
+     * Below this number of latencies the 95th percentile is not meaningful.
+     */
+    constexpr int32 MinLatenciesForP95 = 10;
+
+    /**
+     * Latency assumed for an endpoint without successful requests, in seconds.
+     * Fast endpoints are preferred over unknown ones, slow ones are not.
+     */
+    constexpr double UnknownLatency = 0.3;
+
+    /**
+     * Weight of the newest sample in the moving averages.
+     */
+    constexpr double LatencySmoothing = 0.2;
+    constexpr double ErrorRateSmoothing = 0.1;
+
+    /**
+     * An error rate of 10% doubles the score of an endpoint.
+     */
+    constexpr double ErrorRatePenalty = 10.0;
+
+    /**
+     * Time a failed endpoint is skipped, doubled with every further failure in a row, in seconds.
+     */
+    constexpr double MinCoolDown = 1.0;
+    constexpr double MaxCoolDown = 30.0;
+
+    /**
+     * Hedging delays, in seconds. Used while an endpoint has too few latencies for the 95th percentile.
+     */
+    constexpr double DefaultHedgeDelay = 1.0;
+    constexpr double MinHedgeDelay = 0.05;
+
+    FTSBC_JsonRpcResponse MakeJsonRpcResponse(const FHttpResponsePtr HttpResponse, const bool bWasSuccessful)
+    {
+        FTSBC_JsonRpcResponse JsonRpcResponse;
+        if(HttpResponse)
+        {
+            const bool bStatusCodeOk = HttpResponse->GetResponseCode() >= 200
+                                       && HttpResponse->GetResponseCode() <= 299;
+            JsonRpcResponse.bSuccess = bWasSuccessful && bStatusCodeOk;
+            JsonRpcResponse.StatusCode = HttpResponse->GetResponseCode();
+            JsonRpcResponse.Headers = HttpResponse->GetAllHeaders();
+            JsonRpcResponse.Body = HttpResponse->GetContentAsString();
+        }
+
+        return JsonRpcResponse;
+    }
+}
+
+void CTSBC_RpcEndpointPool::Register(const FTSBC_BlockchainConfig& BlockchainConfig)
+{
+    if(BlockchainConfig.RpcUrl.TrimStartAndEnd().IsEmpty())
+    {
+        TSBC_LOG(Error, TEXT("Cannot register RPC endpoints without RPC URL: Network<%s>"), *BlockchainConfig.NetworkName);
+        return;
+    }
+
+    const TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe> Pool =
+        MakeShared<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe>(BlockchainConfig);
+
+    FScopeLock Lock(&PoolsLock);
+    Pools.Add(BlockchainConfig.RpcUrl, Pool);
+}
+
+void CTSBC_RpcEndpointPool::Unregister(const FString& RpcUrl)
+{
+    FScopeLock Lock(&PoolsLock);
+    Pools.Remove(RpcUrl);
+}
+
+TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe> CTSBC_RpcEndpointPool::Find(const FString& RpcUrl)
+{
+    FScopeLock Lock(&PoolsLock);
+
+    const TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe>* Pool = Pools.Find(RpcUrl);
+    return Pool ? *Pool : nullptr;
+}
+
+void CTSBC_RpcEndpointPool::Shutdown()
+{
+    FScopeLock Lock(&PoolsLock);
+    Pools.Empty();
+}
+
+bool CTSBC_RpcEndpointPool::IsReadOnlyMethod(const FString& Method)
+{
+    static const TCHAR* ReadOnlyMethods[] = {
+        TEXT("eth_blockNumber"),
+        TEXT("eth_call"),
+        TEXT("eth_chainId"),
+        TEXT("eth_estimateGas"),
+        TEXT("eth_feeHistory"),
+        TEXT("eth_gasPrice"),
+        TEXT("eth_getBalance"),
+        TEXT("eth_getBlockByHash"),
+        TEXT("eth_getBlockByNumber"),
+        TEXT("eth_getCode"),
+        TEXT("eth_getLogs"),
+        TEXT("eth_getStorageAt"),
+        TEXT("eth_getTransactionByHash"),
+        TEXT("eth_getTransactionCount"),
+        TEXT("eth_getTransactionReceipt"),
+        TEXT("eth_maxPriorityFeePerGas"),
+        TEXT("net_version"),
+    };
+
+    for(const TCHAR* ReadOnlyMethod : ReadOnlyMethods)
+    {
+        if(Method.Equals(ReadOnlyMethod, ESearchCase::CaseSensitive))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+CTSBC_RpcEndpointPool::CTSBC_RpcEndpointPool(const FTSBC_BlockchainConfig& BlockchainConfig)
+    : RequestTimeout(BlockchainConfig.RpcRequestTimeout)
+    , bHedgeReadOnlyRequests(BlockchainConfig.bHedgeReadOnlyRequests)
+{
+    Endpoints.AddDefaulted_GetRef().URL = BlockchainConfig.RpcUrl;
+
+    for(const FString& FallbackRpcUrl : BlockchainConfig.FallbackRpcUrls)
+    {
+        const FString URL = FallbackRpcUrl.TrimStartAndEnd();
+        const bool bIsKnown = Endpoints.ContainsByPredicate(
+            [&URL](const FEndpoint& Endpoint)
+            {
+                return Endpoint.URL == URL;
+            });
+
+        if(!URL.IsEmpty() && !bIsKnown)
+        {
+            Endpoints.AddDefaulted_GetRef().URL = URL;
+        }
+    }
+}
+
+void CTSBC_RpcEndpointPool::Send(
+    const FString& Body,
+    const bool bReadOnly,
+    TFunction<void(const FTSBC_JsonRpcResponse&)> OnComplete)
+{
+    // Attempts are only started and completed on the game thread, so the request state needs no lock
+    if(!IsInGameThread())
+    {
+        AsyncTask(
+            ENamedThreads::GameThread,
+            [Pool = AsShared(), Body, bReadOnly, OnComplete = MoveTemp(OnComplete)]() mutable
+            {
+                Pool->Send(Body, bReadOnly, MoveTemp(OnComplete));
+            });
+        return;
+    }
+
+    const TSharedRef<FRequest, ESPMode::ThreadSafe> Request = MakeShared<FRequest, ESPMode::ThreadSafe>();
+    Request->Body = Body;
+    Request->OnComplete = MoveTemp(OnComplete);
+    Request->bTried.Init(false, Endpoints.Num());
+    Request->bReadOnly = bReadOnly;
+    Request->bHedge = bReadOnly && bHedgeReadOnlyRequests && Endpoints.Num() > 1;
+
+    StartAttempt(Request, SelectEndpoint(*Request));
+}
+
+TArray<FTSBC_RpcEndpointStats> CTSBC_RpcEndpointPool::GetStats() const
+{
+    FScopeLock Lock(&EndpointsLock);
+
+    const double Now = FPlatformTime::Seconds();
+
+    TArray<FTSBC_RpcEndpointStats> Stats;
+    for(const FEndpoint& Endpoint : Endpoints)
+    {
+        FTSBC_RpcEndpointStats& EndpointStats = Stats.AddDefaulted_GetRef();
+        EndpointStats.URL = Endpoint.URL;
+        EndpointStats.AverageLatency = Endpoint.AverageLatency;
+        EndpointStats.P95Latency = GetP95Latency(Endpoint);
+        EndpointStats.ErrorRate = Endpoint.ErrorRate;
+        EndpointStats.NumRequests = Endpoint.NumRequests;
+        EndpointStats.NumFailures = Endpoint.NumFailures;
+        EndpointStats.bCoolingDown = Endpoint.CoolDownUntil > Now;
+    }
+
+    return Stats;
+}
+
+int32 CTSBC_RpcEndpointPool::SelectEndpoint(const FRequest& Request) const
+{
+    FScopeLock Lock(&EndpointsLock);
+
+    const double Now = FPlatformTime::Seconds();
+
+    int32 BestIndex = INDEX_NONE;
+    double BestScore = 0.0;
+    bool bBestIsCoolingDown = false;
+
+    for(int32 i = 0; i < Endpoints.Num(); i++)
+    {
+        if(Request.bTried[i])
+        {
+            continue;
+        }
+
+        const FEndpoint& Endpoint = Endpoints[i];
+        const double Latency = Endpoint.RecentLatencies.Num() > 0 ? Endpoint.AverageLatency : UnknownLatency;
+        const double Score = Latency * (1.0 + ErrorRatePenalty * Endpoint.ErrorRate);
+        const bool bIsCoolingDown = Endpoint.CoolDownUntil > Now;
+
+        // Endpoints that are cooling down are only used if no other endpoint is left
+        const bool bIsBetter = BestIndex == INDEX_NONE
+                               || (bBestIsCoolingDown && !bIsCoolingDown)
+                               || (bBestIsCoolingDown == bIsCoolingDown && Score < BestScore);
+        if(bIsBetter)
+        {
+            BestIndex = i;
+            BestScore = Score;
+            bBestIsCoolingDown = bIsCoolingDown;
+        }
+    }
+
+    return BestIndex;
+}
+
+void CTSBC_RpcEndpointPool::StartAttempt(
+    const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request,
+    const int32 EndpointIndex)
+{
+    SendAttempt(Request, EndpointIndex);
+
+    if(Request->bHedge && !Request->bCompleted)
+    {
+        ScheduleHedge(Request, EndpointIndex);
+    }
+}
+
+void CTSBC_RpcEndpointPool::SendAttempt(
+    const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request,
+    const int32 EndpointIndex)
+{
+    Request->bTried[EndpointIndex] = true;
+
+    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+    HttpRequest->SetVerb("POST");
+    HttpRequest->SetHeader("Content-Type", "application/json");
+    HttpRequest->SetURL(Endpoints[EndpointIndex].URL);
+    HttpRequest->SetContentAsString(Request->Body);
+    if(RequestTimeout > 0.0f)
+    {
+        HttpRequest->SetTimeout(RequestTimeout);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    HttpRequest->OnProcessRequestComplete().BindLambda(
+        [Pool = AsShared(), Request, EndpointIndex, StartTime](
+        const FHttpRequestPtr CompletedRequest,
+        const FHttpResponsePtr HttpResponse,
+        const bool bWasSuccessful)
+        {
+            const double Latency = FPlatformTime::Seconds() - StartTime;
+            Pool->OnAttemptComplete(Request, EndpointIndex, CompletedRequest, HttpResponse, bWasSuccessful, Latency);
+        });
+
+    Request->InFlight.Add(HttpRequest);
+    HttpRequest->ProcessRequest();
+}
+
+void CTSBC_RpcEndpointPool::ScheduleHedge(
+    const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request,
+    const int32 EndpointIndex)
+{
+    double Delay;
+    {
+        FScopeLock Lock(&EndpointsLock);
+        Delay = GetP95Latency(Endpoints[EndpointIndex]);
+    }
+
+    Delay = FMath::Max(Delay > 0.0 ? Delay : DefaultHedgeDelay, MinHedgeDelay);
+
+    if(Request->HedgeHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(Request->HedgeHandle);
+    }
+
+    // Weak, so that a completed request is not kept alive until the ticker fires
+    const TWeakPtr<FRequest, ESPMode::ThreadSafe> WeakRequest = Request;
+    Request->HedgeHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda(
+            [Pool = AsShared(), WeakRequest](float DeltaTime)
+            {
+                const TSharedPtr<FRequest, ESPMode::ThreadSafe> PendingRequest = WeakRequest.Pin();
+                if(!PendingRequest.IsValid() || PendingRequest->bCompleted)
+                {
+                    return false;
+                }
+
+                PendingRequest->HedgeHandle.Reset();
+
+                const int32 HedgeIndex = Pool->SelectEndpoint(*PendingRequest);
+                if(HedgeIndex != INDEX_NONE)
+                {
+                    Pool->SendAttempt(PendingRequest.ToSharedRef(), HedgeIndex);
+                }
+
+                return false;
+            }),
+        static_cast<float>(Delay));
+}
+
+void CTSBC_RpcEndpointPool::OnAttemptComplete(
+    const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request,
+    const int32 EndpointIndex,
+    const FHttpRequestPtr HttpRequest,
+    const FHttpResponsePtr HttpResponse,
+    const bool bWasSuccessful,
+    const double Latency)
+{
+    Request->InFlight.RemoveSingleSwap(HttpRequest);
+
+    // The slower attempt of a hedged request, cancelled or not, has nothing to pass on
+    if(Request->bCompleted)
+    {
+        return;
+    }
+
+    const FTSBC_JsonRpcResponse Response = MakeJsonRpcResponse(HttpResponse, bWasSuccessful);
+
+    // Other client errors are answered the same way by every endpoint, so they are passed on
+    const bool bShouldFailOver = !bWasSuccessful
+                                 || !HttpResponse
+                                 || Response.StatusCode == 429
+                                 || Response.StatusCode >= 500;
+    if(!bShouldFailOver)
+    {
+        RecordSuccess(EndpointIndex, Latency);
+        Complete(*Request, Response);
+        return;
+    }
+
+    double RetryAfter = 0.0;
+    if(HttpResponse && Response.StatusCode == 429)
+    {
+        RetryAfter = FCString::Atod(*HttpResponse->GetHeader(TEXT("Retry-After")));
+    }
+
+    TSBC_LOG(
+        Warning,
+        TEXT("RPC request failed: URL<%s> StatusCode<%d> Latency<%.3fs>"),
+        *Endpoints[EndpointIndex].URL,
+        Response.StatusCode,
+        Latency);
+
+    RecordFailure(EndpointIndex, RetryAfter);
+    Request->LastFailure = Response;
+
+    // A hedged attempt is still running and may succeed
+    if(Request->InFlight.Num() > 0)
+    {
+        return;
+    }
+
+    // A write may have reached the node before timing out or failing, so sending it again would be answered by
+    // "already known". A rate limited write was rejected before being processed, so it is safe to send elsewhere.
+    if(!Request->bReadOnly && Response.StatusCode != 429)
+    {
+        Complete(*Request, Request->LastFailure);
+        return;
+    }
+
+    const int32 NextIndex = SelectEndpoint(*Request);
+    if(NextIndex == INDEX_NONE)
+    {
+        Complete(*Request, Request->LastFailure);
+        return;
+    }
+
+    StartAttempt(Request, NextIndex);
+}
+
+void CTSBC_RpcEndpointPool::Complete(FRequest& Request, const FTSBC_JsonRpcResponse& Response)
+{
+    Request.bCompleted = true;
+
+    if(Request.HedgeHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(Request.HedgeHandle);
+        Request.HedgeHandle.Reset();
+    }
+
+    // Cancelling may complete the attempts right away, which must not modify the array while it is iterated
+    const TArray<FHttpRequestPtr> Remaining = MoveTemp(Request.InFlight);
+    Request.InFlight.Reset();
+    for(const FHttpRequestPtr& HttpRequest : Remaining)
+    {
+        HttpRequest->CancelRequest();
+    }
+
+    Request.OnComplete(Response);
+}
+
+void CTSBC_RpcEndpointPool::RecordSuccess(const int32 EndpointIndex, const double Latency)
+{
+    FScopeLock Lock(&EndpointsLock);
+
+    FEndpoint& Endpoint = Endpoints[EndpointIndex];
+    Endpoint.NumRequests++;
+    Endpoint.NumConsecutiveFailures = 0;
+    Endpoint.CoolDownUntil = 0.0;
+    Endpoint.ErrorRate *= 1.0 - ErrorRateSmoothing;
+
+    if(Endpoint.RecentLatencies.Num() == 0)
+    {
+        Endpoint.AverageLatency = Latency;
+    }
+    else
+    {
+        Endpoint.AverageLatency += LatencySmoothing * (Latency - Endpoint.AverageLatency);
+    }
+
+    if(Endpoint.RecentLatencies.Num() < NumRecentLatencies)
+    {
+        Endpoint.RecentLatencies.Add(Latency);
+    }
+    else
+    {
+        Endpoint.RecentLatencies[Endpoint.NextLatencyIndex] = Latency;
+        Endpoint.NextLatencyIndex = (Endpoint.NextLatencyIndex + 1) % NumRecentLatencies;
+    }
+}
+
+void CTSBC_RpcEndpointPool::RecordFailure(const int32 EndpointIndex, const double RetryAfter)
+{
+    FScopeLock Lock(&EndpointsLock);
+
+    FEndpoint& Endpoint = Endpoints[EndpointIndex];
+    Endpoint.NumRequests++;
+    Endpoint.NumFailures++;
+    Endpoint.NumConsecutiveFailures++;
+    Endpoint.ErrorRate += ErrorRateSmoothing * (1.0 - Endpoint.ErrorRate);
+
+    const double CoolDown = RetryAfter > 0.0
+                                ? RetryAfter
+                                : FMath::Min(
+                                    MinCoolDown * (1 << FMath::Min(Endpoint.NumConsecutiveFailures - 1, 5)),
+                                    MaxCoolDown);
+    Endpoint.CoolDownUntil = FPlatformTime::Seconds() + CoolDown;
+}
+
+double CTSBC_RpcEndpointPool::GetP95Latency(const FEndpoint& Endpoint) const
+{
+    if(Endpoint.RecentLatencies.Num() < MinLatenciesForP95)
+    {
+        return 0.0;
+    }
+
+    TArray<double> SortedLatencies = Endpoint.RecentLatencies;
+    SortedLatencies.Sort();
+
+    const int32 Index = FMath::CeilToInt(0.95f * SortedLatencies.Num()) - 1;
+    return SortedLatencies[Index];
+}
\ No newline at end of file
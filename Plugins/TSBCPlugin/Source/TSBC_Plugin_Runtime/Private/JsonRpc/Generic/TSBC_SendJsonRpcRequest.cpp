@@ -3,9 +3,211 @@
 #include "JsonRpc/Generic/TSBC_SendJsonRpcRequest.h"
 
 #include "HttpModule.h"
+#include "Async/Async.h"
 #include "Interfaces/IHttpResponse.h"
+#include "JsonRpc/Generic/TSBC_JsonRpcCache.h"
+#include "JsonRpc/Generic/TSBC_RpcEndpointPool.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Module/TSBC_PluginUserSettings.h"
 #include "Module/TSBC_RuntimeLogCategories.h"
 
+TMap<FString, TArray<CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcBatchEntry>> CTSBC_SendJsonRpcRequest::CoalescedRequests;
+FTSTicker::FDelegateHandle CTSBC_SendJsonRpcRequest::FlushHandle;
+FCriticalSection CTSBC_SendJsonRpcRequest::CoalescedRequestsLock;
+TMap<FString, TArray<CTSBC_SendJsonRpcRequest::FTSBC_InFlightWaiter>> CTSBC_SendJsonRpcRequest::InFlightRequests;
+FCriticalSection CTSBC_SendJsonRpcRequest::InFlightRequestsLock;
+
+namespace
+{
+    using FBatchEntry = CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcBatchEntry;
+
+    /**
+     * @param JsonID The ID as JSON value, i.e. a quoted string or a number.
+     * @returns The JSON-RPC request object.
+     */
+    FString MakeRequestObject(const FString& Method, const FString& Params, const FString& JsonID)
+    {
+        return FString::Printf(
+            TEXT("{\"jsonrpc\":\"2.0\",\"method\":\"%s\",\"params\":[%s],\"id\":%s}"),
+            *Method,
+            *Params,
+            *JsonID);
+    }
+
+    /**
+     * @returns The response with the "id" field of its body replaced, or the response as is if it has no ID.
+     */
+    FTSBC_JsonRpcResponse WithResponseId(const FTSBC_JsonRpcResponse& Response, const FString& ID)
+    {
+        TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject());
+        const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Response.Body);
+        if(!FJsonSerializer::Deserialize(JsonReader, ResponseObject)
+            || !ResponseObject.IsValid()
+            || !ResponseObject->HasField(TEXT("id")))
+        {
+            return Response;
+        }
+
+        ResponseObject->SetStringField(TEXT("id"), ID);
+
+        FTSBC_JsonRpcResponse ResponseWithId = Response;
+        ResponseWithId.Body.Reset();
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ResponseWithId.Body);
+        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), JsonWriter);
+
+        return ResponseWithId;
+    }
+
+    /**
+     * Sends a JSON body via HTTP POST, through the endpoint pool registered for the URL if there is one.
+     * The completion callback is called on the game thread.
+     */
+    void PostJsonRpcBody(
+        const FString& URL,
+        const FString& Body,
+        const bool bReadOnly,
+        TFunction<void(const FTSBC_JsonRpcResponse&)> OnComplete)
+    {
+        if(const TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe> Pool = CTSBC_RpcEndpointPool::Find(URL))
+        {
+            Pool->Send(Body, bReadOnly, MoveTemp(OnComplete));
+            return;
+        }
+
+        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+        HttpRequest->SetVerb("POST");
+        HttpRequest->SetHeader("Content-Type", "application/json");
+        HttpRequest->SetURL(URL);
+        HttpRequest->SetContentAsString(Body);
+
+        HttpRequest->OnProcessRequestComplete().BindLambda(
+            [OnComplete](const FHttpRequestPtr, const FHttpResponsePtr HttpResponse, const bool bWasSuccessful)
+            {
+                FTSBC_JsonRpcResponse JsonRpcResponse;
+                if(HttpResponse)
+                {
+                    const bool bStatusCodeOk = HttpResponse->GetResponseCode() >= 200
+                                               && HttpResponse->GetResponseCode() <= 299;
+                    JsonRpcResponse.bSuccess = bWasSuccessful && bStatusCodeOk;
+                    JsonRpcResponse.StatusCode = HttpResponse->GetResponseCode();
+                    JsonRpcResponse.Headers = HttpResponse->GetAllHeaders();
+                    JsonRpcResponse.Body = HttpResponse->GetContentAsString();
+                }
+
+                OnComplete(JsonRpcResponse);
+            });
+
+        HttpRequest->ProcessRequest();
+    }
+
+    void SendSingleRequest(
+        const CTSBC_SendJsonRpcRequest::FTSBC_JsonRpcResponse_Delegate& ResponseDelegate,
+        const FString& URL,
+        const FString& ID,
+        const FString& Method,
+        const FString& Params)
+    {
+#if !UE_BUILD_SHIPPING
+        if(URL.TrimStartAndEnd().IsEmpty())
+        {
+            TSBC_LOG(Error, TEXT("JSON-RPC URL is unset: Method<%s> ID<%s>"), *Method, *ID);
+        }
+#endif
+
+        PostJsonRpcBody(
+            URL,
+            MakeRequestObject(Method, Params, FString::Printf(TEXT("\"%s\""), *ID)),
+            CTSBC_RpcEndpointPool::IsReadOnlyMethod(Method),
+            [ResponseDelegate](const FTSBC_JsonRpcResponse& JsonRpcResponse)
+            {
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(JsonRpcResponse);
+            });
+    }
+
+    /**
+     * Sends coalesced requests. A lone request is sent as is, so it behaves exactly like without coalescing.
+     */
+    void SendCoalescedRequests(const FString& URL, TArray<FBatchEntry>&& Entries)
+    {
+        if(Entries.Num() == 1)
+        {
+            const FBatchEntry& Entry = Entries[0];
+            SendSingleRequest(Entry.ResponseDelegate, URL, Entry.ID, Entry.Method, Entry.Params);
+        }
+        else
+        {
+            CTSBC_SendJsonRpcRequest::SendJsonRpcBatchRequest(URL, MoveTemp(Entries));
+        }
+    }
+
+    /**
+     * Splits the response of a batch request into the responses of its entries and calls their delegates.
+     */
+    void DispatchBatchResponse(const TArray<FBatchEntry>& Entries, const FTSBC_JsonRpcResponse& BatchResponse)
+    {
+        // Without a response array, e.g. if the request failed or the node rejected the whole batch,
+        // every entry gets the response as is
+        TArray<FTSBC_JsonRpcResponse> Responses;
+        Responses.Init(BatchResponse, Entries.Num());
+
+        TArray<TSharedPtr<FJsonValue>> ResponseValues;
+        const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(BatchResponse.Body);
+        if(BatchResponse.bSuccess && FJsonSerializer::Deserialize(JsonReader, ResponseValues))
+        {
+            TBitArray<> bAnswered(false, Entries.Num());
+
+            for(const TSharedPtr<FJsonValue>& ResponseValue : ResponseValues)
+            {
+                const TSharedPtr<FJsonObject>* ResponseObject;
+                int32 Index;
+                if(!ResponseValue.IsValid()
+                    || !ResponseValue->TryGetObject(ResponseObject)
+                    || !(*ResponseObject)->TryGetNumberField(TEXT("id"), Index)
+                    || !Entries.IsValidIndex(Index)
+                    || bAnswered[Index])
+                {
+                    TSBC_LOG(Warning, TEXT("Unexpected element in JSON-RPC batch response: %s"), *BatchResponse.Body);
+                    continue;
+                }
+
+                // Restore the caller's ID, which was replaced by the position within the batch
+                (*ResponseObject)->SetStringField(TEXT("id"), Entries[Index].ID);
+
+                FString Body;
+                const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+                    TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+                FJsonSerializer::Serialize(ResponseObject->ToSharedRef(), JsonWriter);
+
+                Responses[Index].Body = MoveTemp(Body);
+                bAnswered[Index] = true;
+            }
+
+            for(int32 i = 0; i < Entries.Num(); i++)
+            {
+                if(!bAnswered[i])
+                {
+                    TSBC_LOG(
+                        Warning,
+                        TEXT("Missing response in JSON-RPC batch response: Method<%s> ID<%s>"),
+                        *Entries[i].Method,
+                        *Entries[i].ID);
+
+                    Responses[i].bSuccess = false;
+                    Responses[i].Body = "";
+                }
+            }
+        }
+
+        for(int32 i = 0; i < Entries.Num(); i++)
+        {
+            // ReSharper disable once CppExpressionWithoutSideEffects
+            Entries[i].ResponseDelegate.ExecuteIfBound(Responses[i]);
+        }
+    }
+}
+
 void CTSBC_SendJsonRpcRequest::SendJsonRpcRequest(
     FTSBC_JsonRpcResponse_Delegate ResponseDelegate,
     const FString& URL,
@@ -13,42 +215,229 @@ void CTSBC_SendJsonRpcRequest::SendJsonRpcRequest(
     const FString& Method,
     const FString& Params)
 {
-    const FString Body = FString::Printf(
-        TEXT("{\"jsonrpc\":\"2.0\",\"method\":\"%s\",\"params\":[%s],\"id\":\"%s\"}"),
-        *Method,
-        *Params,
-        *ID);
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    if(Settings && Settings->bJsonRpcCacheEnabled)
+    {
+        FTSBC_JsonRpcResponse CachedResponse;
+        if(CTSBC_JsonRpcCache::IsCacheableMethod(Method)
+            && CTSBC_JsonRpcCache::Get().Find(URL, ID, Method, Params, CachedResponse))
+        {
+            // Answer asynchronously like a sent request, so callers do not need to handle both cases
+            AsyncTask(
+                ENamedThreads::GameThread,
+                [ResponseDelegate, CachedResponse]()
+                {
+                    // ReSharper disable once CppExpressionWithoutSideEffects
+                    ResponseDelegate.ExecuteIfBound(CachedResponse);
+                });
+            return;
+        }
+    }
+
+    if(Settings && Settings->bJsonRpcDeduplicationEnabled && CTSBC_RpcEndpointPool::IsReadOnlyMethod(Method))
+    {
+        const FString Key = URL + TEXT("\n") + Method + TEXT("\n") + Params;
+        if(JoinInFlightRequest(Key, ResponseDelegate, ID))
+        {
+            return;
+        }
+
+        ResponseDelegate = FTSBC_JsonRpcResponse_Delegate::CreateLambda(
+            [Key](const FTSBC_JsonRpcResponse& Response)
+            {
+                CompleteInFlightRequest(Key, Response);
+            });
+    }
+
+    // eth_blockNumber is not cached itself, but tells the cache when responses for "latest" become stale.
+    // Stored before the response is passed on, so that requests issued by the delegates can use it
+    if(Settings
+        && Settings->bJsonRpcCacheEnabled
+        && (CTSBC_JsonRpcCache::IsCacheableMethod(Method) || Method == TEXT("eth_blockNumber")))
+    {
+        ResponseDelegate = FTSBC_JsonRpcResponse_Delegate::CreateLambda(
+            [ResponseDelegate, URL, Method, Params](const FTSBC_JsonRpcResponse& Response)
+            {
+                CTSBC_JsonRpcCache::Get().Store(URL, Method, Params, Response);
+
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                ResponseDelegate.ExecuteIfBound(Response);
+            });
+    }
+
+    if(Settings && Settings->bJsonRpcCoalescingEnabled)
+    {
+        CoalesceRequest(URL, {MoveTemp(ResponseDelegate), ID, Method, Params});
+        return;
+    }
+
+    SendSingleRequest(ResponseDelegate, URL, ID, Method, Params);
+}
+
+void CTSBC_SendJsonRpcRequest::SendJsonRpcBatchRequest(const FString& URL, TArray<FTSBC_JsonRpcBatchEntry> Entries)
+{
+    if(Entries.Num() == 0)
+    {
+        return;
+    }
 
 #if !UE_BUILD_SHIPPING
     if(URL.TrimStartAndEnd().IsEmpty())
     {
-        TSBC_LOG(Error, TEXT("JSON-RPC URL is unset: Method<%s> ID<%s>"), *Method, *ID);
+        TSBC_LOG(Error, TEXT("JSON-RPC URL is unset: Batch of %d requests"), Entries.Num());
     }
 #endif
 
-    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-    HttpRequest->SetVerb("POST");
-    HttpRequest->SetHeader("Content-Type", "application/json");
-    HttpRequest->SetURL(URL);
-    HttpRequest->SetContentAsString(Body);
+    // The position within the batch is sent as ID, since the callers' IDs do not need to be unique
+    FString Body = "[";
+    bool bReadOnly = true;
+    for(int32 i = 0; i < Entries.Num(); i++)
+    {
+        bReadOnly &= CTSBC_RpcEndpointPool::IsReadOnlyMethod(Entries[i].Method);
 
-    HttpRequest->OnProcessRequestComplete().BindLambda(
-        [ResponseDelegate](const FHttpRequestPtr, const FHttpResponsePtr HttpResponse, const bool bWasSuccessful)
+        if(i > 0)
         {
-            FTSBC_JsonRpcResponse JsonRpcResponse;
-            if(HttpResponse)
-            {
-                const bool bStatusCodeOk = HttpResponse->GetResponseCode() >= 200
-                                           && HttpResponse->GetResponseCode() <= 299;
-                JsonRpcResponse.bSuccess = bWasSuccessful && bStatusCodeOk;
-                JsonRpcResponse.StatusCode = HttpResponse->GetResponseCode();
-                JsonRpcResponse.Headers = HttpResponse->GetAllHeaders();
-                JsonRpcResponse.Body = HttpResponse->GetContentAsString();
-            }
+            Body += ",";
+        }
 
-            // ReSharper disable once CppExpressionWithoutSideEffects
-            ResponseDelegate.ExecuteIfBound(JsonRpcResponse);
+        Body += MakeRequestObject(Entries[i].Method, Entries[i].Params, FString::FromInt(i));
+    }
+    Body += "]";
+
+    PostJsonRpcBody(
+        URL,
+        Body,
+        bReadOnly,
+        [Entries = MoveTemp(Entries)](const FTSBC_JsonRpcResponse& BatchResponse)
+        {
+            DispatchBatchResponse(Entries, BatchResponse);
         });
+}
+
+void CTSBC_SendJsonRpcRequest::FlushCoalescedRequests()
+{
+    TMap<FString, TArray<FTSBC_JsonRpcBatchEntry>> Batches;
+    {
+        FScopeLock Lock(&CoalescedRequestsLock);
+
+        Batches = MoveTemp(CoalescedRequests);
+        CoalescedRequests.Reset();
+
+        if(FlushHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+            FlushHandle.Reset();
+        }
+    }
+
+    // Sent outside of the lock, since the requests may complete right away and issue further requests
+    for(TPair<FString, TArray<FTSBC_JsonRpcBatchEntry>>& Batch : Batches)
+    {
+        SendCoalescedRequests(Batch.Key, MoveTemp(Batch.Value));
+    }
+}
+
+void CTSBC_SendJsonRpcRequest::Shutdown()
+{
+    {
+        FScopeLock Lock(&CoalescedRequestsLock);
+
+        CoalescedRequests.Empty();
+
+        if(FlushHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+            FlushHandle.Reset();
+        }
+    }
+
+    FScopeLock Lock(&InFlightRequestsLock);
+    InFlightRequests.Empty();
+}
+
+bool CTSBC_SendJsonRpcRequest::JoinInFlightRequest(
+    const FString& Key,
+    const FTSBC_JsonRpcResponse_Delegate& ResponseDelegate,
+    const FString& ID)
+{
+    FScopeLock Lock(&InFlightRequestsLock);
+
+    TArray<FTSBC_InFlightWaiter>* Waiters = InFlightRequests.Find(Key);
+    if(Waiters)
+    {
+        Waiters->Add({ResponseDelegate, ID});
+        return true;
+    }
+
+    InFlightRequests.Add(Key).Add({ResponseDelegate, ID});
+    return false;
+}
+
+void CTSBC_SendJsonRpcRequest::CompleteInFlightRequest(const FString& Key, const FTSBC_JsonRpcResponse& Response)
+{
+    // Removed before the delegates are called, so that requests issued by them are sent again
+    TArray<FTSBC_InFlightWaiter> Waiters;
+    {
+        FScopeLock Lock(&InFlightRequestsLock);
+
+        if(!InFlightRequests.RemoveAndCopyValue(Key, Waiters))
+        {
+            return;
+        }
+    }
+
+    for(int32 i = 0; i < Waiters.Num(); i++)
+    {
+        // The response already carries the ID of the request that was sent
+        const bool bSameId = i == 0 || Waiters[i].ID == Waiters[0].ID;
+
+        // ReSharper disable once CppExpressionWithoutSideEffects
+        Waiters[i].ResponseDelegate.ExecuteIfBound(bSameId ? Response : WithResponseId(Response, Waiters[i].ID));
+    }
+}
+
+void CTSBC_SendJsonRpcRequest::CoalesceRequest(const FString& URL, FTSBC_JsonRpcBatchEntry&& Entry)
+{
+    const UTSBC_PluginUserSettings* Settings = UTSBC_PluginUserSettings::Get();
+    const float Window = Settings ? FMath::Max(0.0f, Settings->JsonRpcCoalescingWindow) : 0.0f;
+    const int32 MaxBatchSize = Settings ? FMath::Max(1, Settings->JsonRpcMaxBatchSize) : 1;
+
+    TArray<FTSBC_JsonRpcBatchEntry> FullBatch;
+    {
+        FScopeLock Lock(&CoalescedRequestsLock);
+
+        TArray<FTSBC_JsonRpcBatchEntry>& Batch = CoalescedRequests.FindOrAdd(URL);
+        Batch.Add(MoveTemp(Entry));
+
+        if(Batch.Num() >= MaxBatchSize)
+        {
+            FullBatch = MoveTemp(Batch);
+            CoalescedRequests.Remove(URL);
+        }
+        else if(!FlushHandle.IsValid())
+        {
+            FlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+                FTickerDelegate::CreateStatic(&CTSBC_SendJsonRpcRequest::FlushCoalescedRequestsTick),
+                Window);
+        }
+    }
+
+    if(FullBatch.Num() > 0)
+    {
+        SendCoalescedRequests(URL, MoveTemp(FullBatch));
+    }
+}
+
+bool CTSBC_SendJsonRpcRequest::FlushCoalescedRequestsTick(float DeltaTime)
+{
+    {
+        FScopeLock Lock(&CoalescedRequestsLock);
+
+        // The ticker is removed by returning false
+        FlushHandle.Reset();
+    }
+
+    FlushCoalescedRequests();
 
-    HttpRequest->ProcessRequest();
+    return false;
 }
\ No newline at end of file
@@ -2,8 +2,41 @@
 
 #include "Math/TSBC_BaseConverter.h"
 
+#include "HAL/IConsoleManager.h"
 #include "Module/TSBC_RuntimeLogCategories.h"
 
+namespace
+{
+    void RunBaseConverterBenchmarkCommand(const TArray<FString>& Args)
+    {
+        const int32 NumConversions = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+
+        for(const int32 NumBytes : {32, 64, 256})
+        {
+            const FTSBC_BaseConverterBenchmarkResult Result = CTSBC_BaseConverter::Benchmark(NumConversions, NumBytes);
+
+            TSBC_LOG(
+                Display,
+                TEXT("BaseConverter %d x %d bytes: hex to dec %.2f us, dec to hex %.2f us"),
+                Result.NumConversions,
+                Result.NumBytes,
+                Result.Hex2DecMicroseconds,
+                Result.Dec2HexMicroseconds);
+
+            TSBC_LOG_COND(
+                !Result.bRoundTripsMatch,
+                Error,
+                TEXT("BaseConverter round trip of %d byte values differs"),
+                Result.NumBytes);
+        }
+    }
+
+    FAutoConsoleCommand BaseConverterBenchmarkCommand(
+        TEXT("TSBC.BaseConverterBenchmark"),
+        TEXT("Measures hex/decimal conversion latency at 32, 64 and 256 bytes. Arguments: [NumConversions]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunBaseConverterBenchmarkCommand));
+}
+
 const TCHAR* CTSBC_BaseConverter::CHARSET_BASE_BIN = TEXT("01");
 const TCHAR* CTSBC_BaseConverter::CHARSET_BASE_OCT = TEXT("01234567");
 const TCHAR* CTSBC_BaseConverter::CHARSET_BASE_DEC = TEXT("0123456789");
@@ -134,30 +167,49 @@ bool CTSBC_BaseConverter::Convert(
         }
     }
 
-    FString Result;
+    FLimbs Limbs;
+    if(!ParseLimbs(_SourceCharset, Value, Limbs))
+    {
+        return false;
+    }
+
+    // Emit digits from the least significant end, one chunk of target digits per division.
+    uint32 ChunkDivisor;
+    const int32 ChunkDigits = GetChunkSize(TargetBase, ChunkDivisor);
+    if(ChunkDigits <= 0)
+    {
+        return false;
+    }
+
+    TArray<TCHAR, TInlineAllocator<256>> Digits;
     do
     {
-        uint32 Remainder;
-        FString Quotient;
-        if(!Divide(
-            _SourceCharset,
-            TargetBase,
-            Value,
-            Quotient,
-            Remainder))
+        uint32 Chunk = DivideLimbs(Limbs, ChunkDivisor);
+        const bool bRemaining = Limbs.Num() > 0;
+
+        // Inner chunks are always zero-padded to their full length, the most significant one is not.
+        for(int32 i = 0; i < ChunkDigits && (bRemaining || Chunk != 0); ++i)
         {
-            return false;
+            Digits.Add(_TargetCharset[Chunk % TargetBase]);
+            Chunk /= TargetBase;
         }
+    } while(Limbs.Num() > 0);
 
-        Value = Quotient;
-        Result.AppendChar(_TargetCharset[Remainder]);
-    } while(!Value.IsEmpty() && !(Value.Len() == 1 && Value[0] == _SourceCharset[0]));
-
-    OutValue = Result.Reverse();
+    if(Digits.Num() == 0)
+    {
+        Digits.Add(_TargetCharset[0]);
+    }
 
-    OutValue = OutValue.Len() < MinDigits
-               ? FString::ChrN(MinDigits - OutValue.Len(), _TargetCharset[0]) + OutValue
-               : OutValue;
+    const int32 NumPaddingDigits = FMath::Max(0, MinDigits - Digits.Num());
+    OutValue.Reset(NumPaddingDigits + Digits.Num());
+    for(int32 i = 0; i < NumPaddingDigits; ++i)
+    {
+        OutValue.AppendChar(_TargetCharset[0]);
+    }
+    for(int32 i = Digits.Num() - 1; i >= 0; --i)
+    {
+        OutValue.AppendChar(Digits[i]);
+    }
 
     return true;
 }
@@ -182,60 +234,158 @@ bool CTSBC_BaseConverter::ToDecimal(const FString& Value, uint32& OutDecimal) co
     return Base2Dec(_SourceCharset, Value, Decimal);
 }
 
-bool CTSBC_BaseConverter::Divide(
-    const FString& BaseCharset,
-    const uint32 TargetNumberBase,
-    FString Value,
-    FString& OutQuotient,
-    uint32& OutRemainder)
+FTSBC_BaseConverterBenchmarkResult CTSBC_BaseConverter::Benchmark(const int32 NumConversions, const int32 NumBytes)
 {
-    FString Quotient;
-    const int32 Length = Value.Len();
-    for(int32 Index = 0; Index < Length; ++Index)
+    FTSBC_BaseConverterBenchmarkResult Result;
+    Result.NumConversions = FMath::Clamp(NumConversions, 1, 1000000);
+    Result.NumBytes = FMath::Clamp(NumBytes, 1, 4096);
+
+    // Values use every digit, so leading zeroes do not shorten the conversion
+    FRandomStream Random(Result.NumConversions ^ Result.NumBytes);
+    TArray<FString> HexValues;
+    HexValues.Reserve(Result.NumConversions);
+    for(int32 i = 0; i < Result.NumConversions; i++)
     {
-        const int32 j = Index + 1 + Value.Len() - Length;
-        if(Value.Len() < j)
+        FString& HexValue = HexValues.AddDefaulted_GetRef();
+        HexValue.Reserve(2 * Result.NumBytes);
+        HexValue.AppendChar(CHARSET_BASE_HEX[1 + Random.RandHelper(15)]);
+        for(int32 Digit = 1; Digit < 2 * Result.NumBytes; Digit++)
         {
-            break;
+            HexValue.AppendChar(CHARSET_BASE_HEX[Random.RandHelper(16)]);
         }
+    }
 
-        uint32 Decimal;
-        if(!Base2Dec(BaseCharset, Value.Mid(0, j), Decimal))
-        {
-            return false;
-        }
+    const CTSBC_BaseConverter Hex2Dec = Hex2DecConverter();
+    const CTSBC_BaseConverter Dec2Hex = Dec2HexConverter();
+
+    TArray<FString> DecValues;
+    DecValues.SetNum(Result.NumConversions);
+    TArray<FString> RoundTrips;
+    RoundTrips.SetNum(Result.NumConversions);
 
-        Quotient.AppendChar(BaseCharset[Decimal / TargetNumberBase]);
-        Value = Dec2Base(BaseCharset, Decimal % TargetNumberBase) + Value.Mid(j);
+    bool bConverted = true;
+
+    const double Hex2DecStart = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Result.NumConversions; i++)
+    {
+        bConverted &= Hex2Dec.Convert(HexValues[i], DecValues[i]);
+    }
+    const double Hex2DecSeconds = FPlatformTime::Seconds() - Hex2DecStart;
+
+    const double Dec2HexStart = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Result.NumConversions; i++)
+    {
+        bConverted &= Dec2Hex.Convert(DecValues[i], RoundTrips[i]);
+    }
+    const double Dec2HexSeconds = FPlatformTime::Seconds() - Dec2HexStart;
+
+    const double MinSeconds = 1e-9;
+
+    Result.Hex2DecMicroseconds = FMath::Max(Hex2DecSeconds, MinSeconds) * 1e6 / Result.NumConversions;
+    Result.Dec2HexMicroseconds = FMath::Max(Dec2HexSeconds, MinSeconds) * 1e6 / Result.NumConversions;
+    Result.bRoundTripsMatch = bConverted && RoundTrips == HexValues;
+
+    return Result;
+}
+
+int32 CTSBC_BaseConverter::GetChunkSize(const uint32 NumberBase, uint32& OutChunkBase)
+{
+    if(NumberBase < 2)
+    {
+        OutChunkBase = 0;
+        return 0;
     }
 
-    uint32 Remainder;
-    if(!Base2Dec(BaseCharset, Value, Remainder))
+    // Largest power of the number base that still fits into a 32 bit limb (e.g. 10^9 or 16^7).
+    uint64 ChunkBase = NumberBase;
+    int32 ChunkDigits = 1;
+    while(ChunkBase * NumberBase <= 0xFFFFFFFFull)
+    {
+        ChunkBase *= NumberBase;
+        ChunkDigits++;
+    }
+
+    OutChunkBase = static_cast<uint32>(ChunkBase);
+    return ChunkDigits;
+}
+
+bool CTSBC_BaseConverter::ParseLimbs(const FString& SourceBaseCharset, const FString& Value, FLimbs& OutLimbs)
+{
+    const uint32 NumberBase = SourceBaseCharset.Len();
+
+    uint32 ChunkBase;
+    const int32 ChunkDigits = GetChunkSize(NumberBase, ChunkBase);
+    if(ChunkDigits <= 0)
     {
         return false;
     }
 
-    // Remove all leading zeros from Quotient and put remaining string in OutRemainder
-    int32 n = INDEX_NONE;
-    for(int32 i = 0; i < Quotient.Len(); ++i)
+    OutLimbs.Reset();
+
+    // Digits are consumed in chunks; the first chunk takes the digits that do not fill up a whole chunk.
+    const int32 NumChars = Value.Len();
+    for(int32 Index = 0; Index < NumChars;)
     {
-        if(Quotient[i] != BaseCharset[0])
+        const int32 NumChunkDigits = Index == 0 && NumChars % ChunkDigits != 0 ? NumChars % ChunkDigits : ChunkDigits;
+
+        uint32 Chunk = 0;
+        uint32 Factor = 1;
+        for(int32 i = 0; i < NumChunkDigits; ++i)
         {
-            n = i;
-            break;
+            int32 CharAtIndex;
+            if(!SourceBaseCharset.FindChar(Value[Index + i], CharAtIndex))
+            {
+                TSBC_LOG(
+                    Error,
+                    TEXT(
+                        "Invalid character '%c' in input value: "
+                        "Cannot convert this value using source base charset '%s'."
+                    ),
+                    Value[Index + i],
+                    *SourceBaseCharset);
+                return false;
+            }
+
+            Chunk = Chunk * NumberBase + CharAtIndex;
+            Factor *= NumberBase;
+        }
+        Index += NumChunkDigits;
+
+        // Limbs = Limbs * Factor + Chunk
+        uint64 Carry = Chunk;
+        for(uint32& Limb : OutLimbs)
+        {
+            const uint64 Tmp = static_cast<uint64>(Limb) * Factor + Carry;
+            Limb = static_cast<uint32>(Tmp);
+            Carry = Tmp >> 32;
+        }
+
+        if(Carry != 0)
+        {
+            OutLimbs.Add(static_cast<uint32>(Carry));
         }
     }
-    if(n != INDEX_NONE)
+
+    return true;
+}
+
+uint32 CTSBC_BaseConverter::DivideLimbs(FLimbs& Limbs, const uint32 Divisor)
+{
+    uint64 Remainder = 0;
+    for(int32 i = Limbs.Num() - 1; i >= 0; --i)
     {
-        OutQuotient = Quotient.Mid(n);
+        const uint64 Tmp = Remainder << 32 | Limbs[i];
+        Limbs[i] = static_cast<uint32>(Tmp / Divisor);
+        Remainder = Tmp % Divisor;
     }
-    else
+
+    // Keep the most significant limb non-zero so an empty array means zero.
+    while(Limbs.Num() > 0 && Limbs.Last() == 0)
     {
-        OutQuotient.Reset();
+        Limbs.Pop(false);
     }
 
-    OutRemainder = Remainder;
-    return true;
+    return static_cast<uint32>(Remainder);
 }
 
 FString CTSBC_BaseConverter::Dec2Base(const FString& TargetBaseCharset, uint32 Value)
@@ -0,0 +1,136 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * When enabled, 256 bit arithmetic operates on four 64 bit limbs using native 128 bit products instead of looping over
+ * eight 32 bit words. Used by both the uint256 type and the secp256k1 field and scalar multiplication, so both switch
+ * backends together. Enabled by default on 64 bit compilers that provide 128 bit multiplication.
+ */
+#ifndef TSBC_UINT256_USE_64BIT_LIMBS
+#if defined(__SIZEOF_INT128__) || (defined(_MSC_VER) && _MSC_VER >= 1920 && defined(_M_X64))
+#define TSBC_UINT256_USE_64BIT_LIMBS true
+#else
+#define TSBC_UINT256_USE_64BIT_LIMBS false
+#endif
+#endif
+
+#if TSBC_UINT256_USE_64BIT_LIMBS
+#if !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+/**
+ * 64 bit limb kernels of the 256 bit arithmetic.
+ *
+ * Values are still stored as eight little-endian 32 bit words. Every kernel loads the words into four 64 bit limbs,
+ * computes with native 64x64->128 bit products and writes the result back.
+ */
+namespace TSBC_Uint256Limbs
+{
+    constexpr int32 NUM_LIMBS = 4;
+
+    FORCEINLINE void Load(uint64* Limbs, const uint32* Words, const int32 NumLimbs = NUM_LIMBS)
+    {
+        for(int32 i = 0; i < NumLimbs; ++i)
+        {
+            Limbs[i] = static_cast<uint64>(Words[2 * i]) | static_cast<uint64>(Words[2 * i + 1]) << 32;
+        }
+    }
+
+    FORCEINLINE void Store(uint32* Words, const uint64* Limbs, const int32 NumLimbs = NUM_LIMBS)
+    {
+        for(int32 i = 0; i < NumLimbs; ++i)
+        {
+            Words[2 * i] = static_cast<uint32>(Limbs[i]);
+            Words[2 * i + 1] = static_cast<uint32>(Limbs[i] >> 32);
+        }
+    }
+
+    /**
+     * @returns The lower 64 bits of Left * Right, the upper 64 bits are written to Hi.
+     */
+    FORCEINLINE uint64 MulWide(const uint64 Left, const uint64 Right, uint64& Hi)
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 Product = static_cast<unsigned __int128>(Left) * Right;
+        Hi = static_cast<uint64>(Product >> 64);
+        return static_cast<uint64>(Product);
+#else
+        return _umul128(Left, Right, &Hi);
+#endif
+    }
+
+    /**
+     * Divides the 128 bit value Hi:Lo by Divisor. Requires Hi < Divisor so the quotient fits into 64 bits.
+     */
+    FORCEINLINE uint64 DivWide(const uint64 Hi, const uint64 Lo, const uint64 Divisor, uint64& Remainder)
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 Dividend = static_cast<unsigned __int128>(Hi) << 64 | Lo;
+        Remainder = static_cast<uint64>(Dividend % Divisor);
+        return static_cast<uint64>(Dividend / Divisor);
+#else
+        return _udiv128(Hi, Lo, Divisor, &Remainder);
+#endif
+    }
+
+    FORCEINLINE uint64 AddCarry(const uint64 Left, const uint64 Right, uint64& Carry)
+    {
+        const uint64 Sum = Left + Right;
+        const uint64 Result = Sum + Carry;
+        Carry = (Sum < Left) | (Result < Sum);
+        return Result;
+    }
+
+    FORCEINLINE uint64 SubBorrow(const uint64 Left, const uint64 Right, uint64& Borrow)
+    {
+        const uint64 Diff = Left - Right;
+        const uint64 Result = Diff - Borrow;
+        Borrow = (Left < Right) | (Diff < Borrow);
+        return Result;
+    }
+
+    /**
+     * Computes the full 512 bit product (16 partial products instead of 64 with 32 bit words).
+     */
+    FORCEINLINE void Multiply(uint64* Product, const uint64* a, const uint64* b)
+    {
+        for(int32 i = 0; i < 2 * NUM_LIMBS; ++i)
+        {
+            Product[i] = 0;
+        }
+
+        for(int32 j = 0; j < NUM_LIMBS; ++j)
+        {
+            uint64 k = 0;
+            for(int32 i = 0; i < NUM_LIMBS; ++i)
+            {
+                // a[i] * b[j] + Product[i + j] + k always fits into 128 bits, so Hi can not overflow.
+                uint64 hi;
+                uint64 lo = MulWide(a[i], b[j], hi);
+                uint64 carry = 0;
+                lo = AddCarry(lo, Product[i + j], carry);
+                hi += carry;
+                carry = 0;
+                Product[i + j] = AddCarry(lo, k, carry);
+                k = hi + carry;
+            }
+            Product[j + NUM_LIMBS] = k;
+        }
+    }
+
+    /**
+     * Multiplies two values given as eight 32 bit words, the product has sixteen words.
+     */
+    FORCEINLINE void Multiply(uint32* Result, const uint32* Left, const uint32* Right)
+    {
+        uint64 a[NUM_LIMBS], b[NUM_LIMBS], r[2 * NUM_LIMBS];
+        Load(a, Left);
+        Load(b, Right);
+        Multiply(r, a, b);
+        Store(Result, r, 2 * NUM_LIMBS);
+    }
+}
+#endif
\ No newline at end of file
@@ -4,6 +4,10 @@
 
 #include "Crypto/Encryption/TSBC_EcdsaSecp256k1.h"
 #include "Crypto/Random/TSBC_SecureRandom.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/TSBC_Uint256Limbs.h"
+#include "Misc/StringBuilder.h"
+#include "Module/TSBC_RuntimeLogCategories.h"
 #include "Util/TSBC_StringUtils.h"
 
 constexpr uint256_t FTSBC_uint256::MIN_VALUE = {
@@ -28,6 +32,343 @@ constexpr uint256_t FTSBC_uint256::MAX_VALUE = {
     0xFFFFFFFF,
 };
 
+#if TSBC_UINT256_USE_64BIT_LIMBS
+/**
+ * Kernels of the 64 bit limb backend only used by the uint256 type. The shared ones are in TSBC_Uint256Limbs.h.
+ */
+namespace TSBC_Uint256Limbs
+{
+    FORCEINLINE bool Add(uint32* Result, const uint32* Left, const uint32* Right)
+    {
+        uint64 a[NUM_LIMBS], b[NUM_LIMBS], r[NUM_LIMBS];
+        Load(a, Left);
+        Load(b, Right);
+
+        uint64 carry = 0;
+        for(int32 i = 0; i < NUM_LIMBS; ++i)
+        {
+            r[i] = AddCarry(a[i], b[i], carry);
+        }
+
+        Store(Result, r);
+        return carry != 0;
+    }
+
+    FORCEINLINE bool Subtract(uint32* Result, const uint32* Left, const uint32* Right)
+    {
+        uint64 a[NUM_LIMBS], b[NUM_LIMBS], r[NUM_LIMBS];
+        Load(a, Left);
+        Load(b, Right);
+
+        uint64 borrow = 0;
+        for(int32 i = 0; i < NUM_LIMBS; ++i)
+        {
+            r[i] = SubBorrow(a[i], b[i], borrow);
+        }
+
+        Store(Result, r);
+        return borrow != 0;
+    }
+
+    FORCEINLINE int32 CompareUnsafe(const uint32* Left, const uint32* Right)
+    {
+        uint64 a[NUM_LIMBS], b[NUM_LIMBS];
+        Load(a, Left);
+        Load(b, Right);
+
+        for(int32 i = NUM_LIMBS - 1; i >= 0; --i)
+        {
+            if(a[i] != b[i])
+            {
+                return a[i] > b[i] ? 1 : -1;
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * Computes Left * Right mod (2^256 - 1) by folding the upper half of the product onto the lower half.
+     */
+    FORCEINLINE void MultiplyModMax(uint32* Result, const uint32* Left, const uint32* Right)
+    {
+        uint64 a[NUM_LIMBS], b[NUM_LIMBS], p[2 * NUM_LIMBS], r[NUM_LIMBS];
+        Load(a, Left);
+        Load(b, Right);
+        Multiply(p, a, b);
+
+        uint64 carry = 0;
+        for(int32 i = 0; i < NUM_LIMBS; ++i)
+        {
+            r[i] = AddCarry(p[i], p[i + NUM_LIMBS], carry);
+        }
+
+        // 2^256 is congruent to 1, so the carry wraps around. This can not carry again.
+        for(int32 i = 0; i < NUM_LIMBS && carry; ++i)
+        {
+            r[i] = AddCarry(r[i], 0, carry);
+        }
+
+        if((r[0] & r[1] & r[2] & r[3]) == ~0ull)
+        {
+            r[0] = r[1] = r[2] = r[3] = 0;
+        }
+
+        Store(Result, r);
+    }
+
+    /**
+     * Divides the value in place by a single limb.
+     *
+     * @returns The remainder of the division.
+     */
+    FORCEINLINE uint64 DivideBySmall(uint64* Limbs, const uint64 Divisor)
+    {
+        uint64 rem = 0;
+        for(int32 i = NUM_LIMBS - 1; i >= 0; --i)
+        {
+            Limbs[i] = DivWide(rem, Limbs[i], Divisor, rem);
+        }
+        return rem;
+    }
+
+    /**
+     * Computes Limbs = Limbs * Factor + Addend in place.
+     *
+     * @returns True, if the result does not fit into 256 bits.
+     */
+    FORCEINLINE bool MultiplyAddSmall(uint64* Limbs, const uint64 Factor, const uint64 Addend)
+    {
+        uint64 k = Addend;
+        for(int32 i = 0; i < NUM_LIMBS; ++i)
+        {
+            uint64 hi;
+            uint64 lo = MulWide(Limbs[i], Factor, hi);
+            uint64 carry = 0;
+            Limbs[i] = AddCarry(lo, k, carry);
+            k = hi + carry;
+        }
+        return k != 0;
+    }
+
+    /**
+     * Parses validated decimal digits 19 at a time; the first chunk takes the digits that do not fill up a whole chunk.
+     *
+     * @returns False, if the value does not fit into 256 bits.
+     */
+    FORCEINLINE bool ParseDecDigits(uint32* Words, const TCHAR* Chars, const int32 NumChars)
+    {
+        constexpr int32 ChunkDigits = 19;
+
+        uint64 Value[NUM_LIMBS] = {0};
+        for(int32 Index = 0; Index < NumChars;)
+        {
+            const int32 NumChunkDigits = Index == 0 && NumChars % ChunkDigits != 0
+                                             ? NumChars % ChunkDigits
+                                             : ChunkDigits;
+
+            uint64 Chunk = 0;
+            uint64 Factor = 1;
+            for(int32 i = 0; i < NumChunkDigits; i++)
+            {
+                Chunk = Chunk * 10 + (Chars[Index + i] - '0');
+                Factor *= 10;
+            }
+            Index += NumChunkDigits;
+
+            if(MultiplyAddSmall(Value, Factor, Chunk))
+            {
+                return false;
+            }
+        }
+
+        Store(Words, Value);
+        return true;
+    }
+
+    /**
+     * Knuth's algorithm D with 64 bit digits.
+     */
+    FORCEINLINE bool Divide(uint32* Quotient, uint32* Remainder, const uint32* Dividend, const uint32* Divisor)
+    {
+        uint64 u[NUM_LIMBS], v[NUM_LIMBS];
+        Load(u, Dividend);
+        Load(v, Divisor);
+
+        int32 n = NUM_LIMBS;
+        while(n > 0 && v[n - 1] == 0)
+        {
+            --n;
+        }
+
+        if(n == 0)
+        {
+            return false;
+        }
+
+        int32 m = NUM_LIMBS;
+        while(m > 0 && u[m - 1] == 0)
+        {
+            --m;
+        }
+
+        uint64 q[NUM_LIMBS] = {0};
+        uint64 r[NUM_LIMBS] = {0};
+
+        if(m < n)
+        {
+            // Dividend is smaller than the divisor.
+            for(int32 i = 0; i < NUM_LIMBS; ++i)
+            {
+                r[i] = u[i];
+            }
+        }
+        else if(n == 1)
+        {
+            uint64 rem = 0;
+            for(int32 i = m - 1; i >= 0; --i)
+            {
+                q[i] = DivWide(rem, u[i], v[0], rem);
+            }
+            r[0] = rem;
+        }
+        else
+        {
+            const int32 s = FMath::CountLeadingZeros64(v[n - 1]);
+            uint64 vn[NUM_LIMBS];
+            uint64 un[NUM_LIMBS + 1];
+
+            for(int32 i = n - 1; i > 0; --i)
+            {
+                vn[i] = v[i] << s | (s ? v[i - 1] >> (64 - s) : 0);
+            }
+            vn[0] = v[0] << s;
+
+            un[m] = s ? u[m - 1] >> (64 - s) : 0;
+            for(int32 i = m - 1; i > 0; --i)
+            {
+                un[i] = u[i] << s | (s ? u[i - 1] >> (64 - s) : 0);
+            }
+            un[0] = u[0] << s;
+
+            for(int32 j = m - n; j >= 0; --j)
+            {
+                uint64 qhat;
+                uint64 rhat;
+                bool bRhatOverflow;
+                if(un[j + n] >= vn[n - 1])
+                {
+                    qhat = ~0ull;
+                    rhat = un[j + n - 1] + vn[n - 1];
+                    bRhatOverflow = rhat < vn[n - 1];
+                }
+                else
+                {
+                    qhat = DivWide(un[j + n], un[j + n - 1], vn[n - 1], rhat);
+                    bRhatOverflow = false;
+                }
+
+                while(!bRhatOverflow)
+                {
+                    uint64 hi;
+                    const uint64 lo = MulWide(qhat, vn[n - 2], hi);
+                    if(hi < rhat || (hi == rhat && lo <= un[j + n - 2]))
+                    {
+                        break;
+                    }
+
+                    --qhat;
+                    rhat += vn[n - 1];
+                    bRhatOverflow = rhat < vn[n - 1];
+                }
+
+                // Multiply and subtract.
+                uint64 k = 0;
+                uint64 borrow = 0;
+                for(int32 i = 0; i < n; ++i)
+                {
+                    uint64 hi;
+                    uint64 lo = MulWide(qhat, vn[i], hi);
+                    uint64 carry = 0;
+                    lo = AddCarry(lo, k, carry);
+                    k = hi + carry;
+                    un[i + j] = SubBorrow(un[i + j], lo, borrow);
+                }
+                un[j + n] = SubBorrow(un[j + n], k, borrow);
+
+                if(borrow)
+                {
+                    // Subtracted too much, add back.
+                    --qhat;
+                    uint64 carry = 0;
+                    for(int32 i = 0; i < n; ++i)
+                    {
+                        un[i + j] = AddCarry(un[i + j], vn[i], carry);
+                    }
+                    un[j + n] += carry;
+                }
+
+                q[j] = qhat;
+            }
+
+            for(int32 i = 0; i < n - 1; ++i)
+            {
+                r[i] = un[i] >> s | (s ? un[i + 1] << (64 - s) : 0);
+            }
+            r[n - 1] = un[n - 1] >> s;
+        }
+
+        Store(Quotient, q);
+        if(Remainder != nullptr)
+        {
+            Store(Remainder, r);
+        }
+
+        return true;
+    }
+}
+#endif
+
+namespace
+{
+    void RunUint256BenchmarkCommand(const TArray<FString>& Args)
+    {
+        const int32 NumOperations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+
+        const FTSBC_uint256BenchmarkResult Result = FTSBC_uint256::Benchmark(NumOperations);
+
+        TSBC_LOG(
+            Display,
+            TEXT("uint256 %d operations, 32 bit words: multiply %.1f ns, divide %.1f ns, parse %.1f ns"),
+            Result.NumOperations,
+            Result.Multiply32BitNanoseconds,
+            Result.Divide32BitNanoseconds,
+            Result.ParseDec32BitNanoseconds);
+
+        if(Result.bHas64BitLimbs)
+        {
+            TSBC_LOG(
+                Display,
+                TEXT("uint256 %d operations, 64 bit limbs: multiply %.1f ns, divide %.1f ns, parse %.1f ns"),
+                Result.NumOperations,
+                Result.Multiply64BitNanoseconds,
+                Result.Divide64BitNanoseconds,
+                Result.ParseDec64BitNanoseconds);
+        }
+        else
+        {
+            TSBC_LOG(Display, TEXT("uint256 64 bit limbs are not available on this compiler"));
+        }
+
+        TSBC_LOG_COND(!Result.bResultsMatch, Error, TEXT("uint256 32 bit and 64 bit results differ"));
+    }
+
+    FAutoConsoleCommand Uint256BenchmarkCommand(
+        TEXT("TSBC.Uint256Benchmark"),
+        TEXT("Measures uint256 multiply, divide and parse on both backends. Arguments: [NumOperations]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunUint256BenchmarkCommand));
+}
+
 FTSBC_uint256::FTSBC_uint256()
 {
 #if WITH_EDITOR
@@ -293,35 +634,35 @@ FTSBC_uint256& FTSBC_uint256::operator-=(const FString& Other)
 FTSBC_uint256 FTSBC_uint256::operator*(const uint64_t& Other) const
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, FTSBC_uint256(Other).CurrentValue, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, FTSBC_uint256(Other).CurrentValue);
     return result;
 }
 
 FTSBC_uint256 FTSBC_uint256::operator*(const uint256_t& Other) const
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, Other, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, Other);
     return result;
 }
 
 FTSBC_uint256 FTSBC_uint256::operator*(const FTSBC_uint256& Other) const
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, Other.CurrentValue, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, Other.CurrentValue);
     return result;
 }
 
 FTSBC_uint256 FTSBC_uint256::operator*(const FString& Other) const
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, FTSBC_uint256(Other).CurrentValue, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, FTSBC_uint256(Other).CurrentValue);
     return result;
 }
 
 FTSBC_uint256& FTSBC_uint256::operator*=(const uint64_t& Other)
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, FTSBC_uint256(Other).CurrentValue, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, FTSBC_uint256(Other).CurrentValue);
     SetValue(result);
 
 #if WITH_EDITOR
@@ -334,7 +675,7 @@ FTSBC_uint256& FTSBC_uint256::operator*=(const uint64_t& Other)
 FTSBC_uint256& FTSBC_uint256::operator*=(const uint256_t& Other)
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, Other, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, Other);
     SetValue(result);
 
 #if WITH_EDITOR
@@ -347,7 +688,7 @@ FTSBC_uint256& FTSBC_uint256::operator*=(const uint256_t& Other)
 FTSBC_uint256& FTSBC_uint256::operator*=(const FTSBC_uint256& Other)
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, Other.CurrentValue, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, Other.CurrentValue);
     SetValue(result);
 
 #if WITH_EDITOR
@@ -360,7 +701,7 @@ FTSBC_uint256& FTSBC_uint256::operator*=(const FTSBC_uint256& Other)
 FTSBC_uint256& FTSBC_uint256::operator*=(const FString& Other)
 {
     uint256_t result = {0};
-    ModMultiply(result, CurrentValue, FTSBC_uint256(Other).CurrentValue, MAX_VALUE, NUM_WORDS);
+    MultiplyWrapping(result, CurrentValue, FTSBC_uint256(Other).CurrentValue);
     SetValue(result);
 
 #if WITH_EDITOR
@@ -660,30 +1001,9 @@ bool FTSBC_uint256::operator<=(const FString& Other) const
 
 FString FTSBC_uint256::ToHexString(const bool bZeroPadded) const
 {
-    uint8 Bytes[NUM_BYTES] = {0};
-    NativeToBytes(Bytes, NUM_BYTES, CurrentValue);
-
-    FString Hex;
-    for(int i = 0; i < NUM_BYTES; i++)
-    {
-        const uint8 Num = Bytes[i];
-        const FString Tmp = FString::Printf(TEXT("%02x"), Num);
-        if(Tmp == "00" && Hex.IsEmpty() && i < NUM_BYTES - 1)
-        {
-            continue;
-        }
-        Hex += Tmp;
-    }
-
-    if(!bZeroPadded)
-    {
-        if(Hex.GetCharArray()[0] == '0')
-        {
-            Hex.MidInline(1);
-        }
-    }
-
-    return FString("0x") + Hex;
+    TCHAR Buffer[2 + MAX_HEX_DIGITS + 1];
+    const int32 NumChars = ToHexChars(Buffer, UE_ARRAY_COUNT(Buffer), bZeroPadded);
+    return FString(NumChars, Buffer);
 }
 
 FString FTSBC_uint256::ToDecString(
@@ -692,13 +1012,16 @@ FString FTSBC_uint256::ToDecString(
     const int32 MinFracDigits,
     const int32 MaxFracDigits) const
 {
-    FString DecValueIntegral;
-    FString DecValueFractional;
+    TCHAR IntegralDigits[MAX_DEC_DIGITS + 1];
+    TCHAR FractionalDigits[MAX_DEC_DIGITS + 1];
+    int32 NumIntegralDigits;
+    int32 NumFractionalDigits = 0;
+    int32 NumFractionalLeadingZeroes = 0;
 
     // If there is no unit conversion required, we can use a shortcut and save CPU cycles.
     if(Exponent <= 0)
     {
-        CTSBC_BaseConverter::Hex2DecConverter().Convert(ToHexString(), DecValueIntegral);
+        NumIntegralDigits = ToDecChars(IntegralDigits, UE_ARRAY_COUNT(IntegralDigits));
     }
     else
     {
@@ -711,45 +1034,155 @@ FString FTSBC_uint256::ToDecString(
             return "";
         }
 
-        CTSBC_BaseConverter::Hex2DecConverter().Convert(Quotient.ToHexString(), DecValueIntegral);
-        CTSBC_BaseConverter::Hex2DecConverter().Convert(Remainder.ToHexString(), DecValueFractional);
+        NumIntegralDigits = Quotient.ToDecChars(IntegralDigits, UE_ARRAY_COUNT(IntegralDigits));
 
-        // Strip unnecessary zeroes from end
-        if(Remainder == 0)
+        // Strip unnecessary zeroes from end, the remainder is zero-padded from the left to the exponent's length.
+        if(Remainder != 0)
         {
-            DecValueFractional = "";
+            NumFractionalDigits = Remainder.ToDecChars(FractionalDigits, UE_ARRAY_COUNT(FractionalDigits));
+            NumFractionalLeadingZeroes = FMath::Max(0, static_cast<int32>(Exponent) - NumFractionalDigits);
+            while(NumFractionalDigits > 0 && FractionalDigits[NumFractionalDigits - 1] == '0')
+            {
+                NumFractionalDigits--;
+            }
         }
-        else
+    }
+
+    TStringBuilder<128> DecValue;
+    for(int32 i = NumIntegralDigits; i < MinIntDigits; i++)
+    {
+        DecValue.AppendChar('0');
+    }
+    DecValue.Append(IntegralDigits, NumIntegralDigits);
+
+    if(MaxFracDigits > 0)
+    {
+        int32 NumFracDigits = NumFractionalLeadingZeroes + NumFractionalDigits;
+        if(NumFracDigits > MaxFracDigits)
+        {
+            NumFracDigits = MaxFracDigits;
+        }
+
+        const int32 NumFracDigitsPadded = FMath::Max(NumFracDigits, MinFracDigits);
+        if(NumFracDigitsPadded > 0)
         {
-            TSBC_StringUtils::StripTrailingZeroes(DecValueFractional);
+            DecValue.AppendChar('.');
+            for(int32 i = 0; i < NumFracDigitsPadded; i++)
+            {
+                const int32 DigitIndex = i - NumFractionalLeadingZeroes;
+                const bool bIsDigit = i < NumFracDigits && DigitIndex >= 0;
+                DecValue.AppendChar(bIsDigit ? FractionalDigits[DigitIndex] : '0');
+            }
         }
     }
 
-    if(DecValueIntegral.Len() < MinIntDigits)
+    return FString(DecValue.Len(), DecValue.GetData());
+}
+
+int32 FTSBC_uint256::ToHexChars(TCHAR* Buffer, const int32 BufferSize, const bool bZeroPadded) const
+{
+    static const TCHAR* HexDigits = TEXT("0123456789abcdef");
+
+    // Like the byte-wise notation: two digits per byte, leading zero bytes are skipped but at least one is kept.
+    int32 NumDigits = 2 * NUM_BYTES;
+    while(NumDigits > 2 && (CurrentValue[(NumDigits - 2) / 8] >> (4 * ((NumDigits - 2) % 8)) & 0xFF) == 0)
+    {
+        NumDigits -= 2;
+    }
+
+    if(!bZeroPadded && (CurrentValue[(NumDigits - 1) / 8] >> (4 * ((NumDigits - 1) % 8)) & 0xF) == 0)
     {
-        DecValueIntegral = FString::ChrN(MinIntDigits - DecValueIntegral.Len(), '0') + DecValueIntegral;
+        NumDigits--;
     }
 
-    if(MaxFracDigits <= 0)
+    const int32 NumChars = 2 + NumDigits;
+    if(Buffer == nullptr || BufferSize < NumChars + 1)
     {
-        DecValueFractional.Empty();
+        return 0;
     }
-    else
+
+    Buffer[0] = '0';
+    Buffer[1] = 'x';
+    for(int32 i = 0; i < NumDigits; i++)
     {
-        if(DecValueFractional.Len() < MinFracDigits)
-        {
-            DecValueFractional = DecValueFractional + FString::ChrN(MinFracDigits - DecValueFractional.Len(), '0');
-        }
-        else if(DecValueFractional.Len() > MaxFracDigits)
+        const int32 Nibble = NumDigits - 1 - i;
+        Buffer[2 + i] = HexDigits[CurrentValue[Nibble / 8] >> (4 * (Nibble % 8)) & 0xF];
+    }
+    Buffer[NumChars] = '\0';
+
+    return NumChars;
+}
+
+int32 FTSBC_uint256::ToDecChars(TCHAR* Buffer, const int32 BufferSize) const
+{
+    // Digits are generated from the least significant end, one chunk per division.
+    TCHAR Digits[MAX_DEC_DIGITS];
+    int32 NumDigits = 0;
+
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    constexpr uint64 ChunkDivisor = 10000000000000000000ull;
+    constexpr int32 ChunkDigits = 19;
+
+    uint64 Value[TSBC_Uint256Limbs::NUM_LIMBS];
+    TSBC_Uint256Limbs::Load(Value, CurrentValue);
+
+    bool bRemaining;
+    do
+    {
+        uint64 Chunk = TSBC_Uint256Limbs::DivideBySmall(Value, ChunkDivisor);
+        bRemaining = (Value[0] | Value[1] | Value[2] | Value[3]) != 0;
+#else
+    constexpr uint32 ChunkDivisor = 1000000000;
+    constexpr int32 ChunkDigits = 9;
+
+    uint32 Value[NUM_WORDS];
+    SetValueFromBytes(Value, CurrentValue, NUM_WORDS);
+
+    bool bRemaining;
+    do
+    {
+        uint32 Chunk = DivideByWord(Value, ChunkDivisor, NUM_WORDS);
+        bRemaining = !IsZero(Value, NUM_WORDS);
+#endif
+
+        // Inner chunks are always zero-padded to their full length, the most significant one is not.
+        for(int32 i = 0; i < ChunkDigits && (bRemaining || Chunk != 0); i++)
         {
-            DecValueFractional.MidInline(0, MaxFracDigits);
+            Digits[NumDigits++] = static_cast<TCHAR>('0' + Chunk % 10);
+            Chunk /= 10;
         }
+    } while(bRemaining);
+
+    if(NumDigits == 0)
+    {
+        Digits[NumDigits++] = '0';
+    }
+
+    if(Buffer == nullptr || BufferSize < NumDigits + 1)
+    {
+        return 0;
     }
 
-    const FString DecValue = DecValueFractional.IsEmpty()
-                             ? DecValueIntegral
-                             : FString::Printf(TEXT("%s.%s"), *DecValueIntegral, *DecValueFractional);
-    return DecValue;
+    for(int32 i = 0; i < NumDigits; i++)
+    {
+        Buffer[i] = Digits[NumDigits - 1 - i];
+    }
+    Buffer[NumDigits] = '\0';
+
+    return NumDigits;
+}
+
+int32 FTSBC_uint256::ToBytes(uint8* Bytes) const
+{
+    NativeToBytes(Bytes, NUM_BYTES, CurrentValue);
+
+    int32 NumLeadingZeros = 0;
+    while(NumLeadingZeros < static_cast<int32>(NUM_BYTES) && Bytes[NumLeadingZeros] == 0)
+    {
+        NumLeadingZeros++;
+    }
+
+    return NUM_BYTES - NumLeadingZeros;
 }
 
 FTSBC_uint256 FTSBC_uint256::Pow(const uint32 Base, const uint32 Exponent)
@@ -778,30 +1211,25 @@ FTSBC_uint256 FTSBC_uint256::Pow(const uint32 Base, const uint32 Exponent)
 
 bool FTSBC_uint256::ParseFromString(const FString& Value)
 {
-    FString ValueSanitized = Value.TrimStartAndEnd().ToLower();
-    if(ValueSanitized.IsEmpty())
+    const TCHAR* Chars = *Value;
+    int32 NumChars = Value.Len();
+    TrimWhitespace(Chars, NumChars);
+    if(NumChars == 0)
     {
         return false;
     }
 
     FTSBC_uint256 ValueParsed;
-    if(ValueSanitized.StartsWith("0x"))
+    bool bSuccess;
+    if(HasHexPrefix(Chars, NumChars))
     {
-        ValueSanitized.MidInline(2);
-
-        if(ValueSanitized.IsEmpty())
-        {
-            SetValue(0);
-            return true;
-        }
-
-        const bool bSuccess = ParseFromHexString(ValueSanitized, ValueParsed);
-        SetValue(ValueParsed);
-
-        return bSuccess;
+        // A bare "0x" prefix is treated as zero.
+        bSuccess = NumChars == 2 || ParseFromHexChars(Chars, NumChars, ValueParsed);
+    }
+    else
+    {
+        bSuccess = ParseFromDecChars(Chars, NumChars, ValueParsed);
     }
-
-    const bool bSuccess = ParseFromDecString(ValueSanitized, ValueParsed);
     SetValue(ValueParsed);
 
 #if WITH_EDITOR
@@ -895,54 +1323,125 @@ bool FTSBC_uint256::ParseFromStringWithFractionalValue(const FString& Value, con
 
 bool FTSBC_uint256::ParseFromHexString(const FString& HexAsString, FTSBC_uint256& DecAsUint256)
 {
-    FString ValueSanitized = HexAsString.TrimStartAndEnd();
-    if(HexAsString.IsEmpty())
+    return ParseFromHexChars(*HexAsString, HexAsString.Len(), DecAsUint256);
+}
+
+bool FTSBC_uint256::ParseFromDecString(const FString& DecAsString, FTSBC_uint256& DecAsUint256)
+{
+    return ParseFromDecChars(*DecAsString, DecAsString.Len(), DecAsUint256);
+}
+
+bool FTSBC_uint256::ParseFromHexChars(const TCHAR* Chars, int32 NumChars, FTSBC_uint256& DecAsUint256)
+{
+    TrimWhitespace(Chars, NumChars);
+    if(NumChars == 0)
     {
         return false;
     }
 
-    ValueSanitized.ToLowerInline();
-    if(ValueSanitized.StartsWith("0x"))
+    if(HasHexPrefix(Chars, NumChars))
     {
-        ValueSanitized.MidInline(2);
+        Chars += 2;
+        NumChars -= 2;
+        if(NumChars == 0)
+        {
+            return false;
+        }
     }
 
-    if(!TSBC_StringUtils::IsHexString(ValueSanitized, false))
+    uint256_t Value = {0};
+    for(int32 i = NumChars - 1; i >= 0; i--)
     {
-        return false;
-    }
+        const TCHAR Hex = Chars[i];
+        uint32 Nibble;
+        if(Hex >= '0' && Hex <= '9')
+        {
+            Nibble = Hex - '0';
+        }
+        else if(Hex >= 'a' && Hex <= 'f')
+        {
+            Nibble = Hex - ('a' - 10);
+        }
+        else if(Hex >= 'A' && Hex <= 'F')
+        {
+            Nibble = Hex - ('A' - 10);
+        }
+        else
+        {
+            return false;
+        }
 
-    DecAsUint256 = 0;
-    for(int32 i = 0; i < ValueSanitized.Len(); i++)
-    {
-        const char Hex = ValueSanitized[ValueSanitized.Len() - i - 1];
-        // This statement expects that Hex contains lowercase hex digits only!
-        const uint32 Value = Hex > 57
-                             ? Hex - ('a' - 10)
-                             : Hex - '0';
-        FTSBC_uint256 Power = Pow(16, i);
+        const int32 Position = NumChars - 1 - i;
+        if(Position >= MAX_HEX_DIGITS)
+        {
+            // Leading zeroes are fine, anything else does not fit into 256 bits.
+            if(Nibble != 0)
+            {
+                return false;
+            }
+            continue;
+        }
 
-        DecAsUint256 = DecAsUint256 + Power * Value;
+        Value[Position / 8] |= Nibble << (4 * (Position % 8));
     }
 
+    DecAsUint256.SetValue(Value);
+
+#if WITH_EDITOR
+    DecAsUint256.UpdateDebugValues();
+#endif
+
     return true;
 }
 
-bool FTSBC_uint256::ParseFromDecString(const FString& DecAsString, FTSBC_uint256& DecAsUint256)
+bool FTSBC_uint256::ParseFromDecChars(const TCHAR* Chars, int32 NumChars, FTSBC_uint256& DecAsUint256)
 {
-    const CTSBC_BaseConverter BaseConverter = CTSBC_BaseConverter::Dec2HexConverter();
+    TrimWhitespace(Chars, NumChars);
 
-    FString HexAsString;
-    if(!BaseConverter.Convert(DecAsString, HexAsString))
+    for(int32 i = 0; i < NumChars; i++)
     {
-        return false;
+        if(Chars[i] < '0' || Chars[i] > '9')
+        {
+            return false;
+        }
     }
 
-    if(!ParseFromHexString(HexAsString, DecAsUint256))
+    uint256_t Value;
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(!TSBC_Uint256Limbs::ParseDecDigits(Value, Chars, NumChars))
+#else
+    if(!ParseDecDigitsWords(Value, Chars, NumChars))
+#endif
     {
         return false;
     }
 
+    DecAsUint256.SetValue(Value);
+
+#if WITH_EDITOR
+    DecAsUint256.UpdateDebugValues();
+#endif
+
+    return true;
+}
+
+bool FTSBC_uint256::ParseFromBytes(const uint8* Bytes, int32 NumBytes, FTSBC_uint256& DecAsUint256)
+{
+    while(NumBytes > static_cast<int32>(NUM_BYTES))
+    {
+        if(*Bytes != 0)
+        {
+            return false;
+        }
+
+        Bytes++;
+        NumBytes--;
+    }
+
+    uint256_t Words = {0};
+    BytesToNative(Words, Bytes, NumBytes);
+    DecAsUint256.SetValue(Words);
+
     return true;
 }
 
@@ -1058,6 +1557,13 @@ uint32 FTSBC_uint256::GetNumBits(const uint32* Vli, const int32 MaxWords)
 
 int32 FTSBC_uint256::CompareUnsafe(const uint32* Left, const uint32* Right, const uint32 NumWords)
 {
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(NumWords == NUM_WORDS)
+    {
+        return TSBC_Uint256Limbs::CompareUnsafe(Left, Right);
+    }
+#endif
+
     for(int32 i = NumWords - 1; i >= 0; --i)
     {
         if(Left[i] > Right[i])
@@ -1097,12 +1603,92 @@ void FTSBC_uint256::RightShiftOne(uint32* Vli, const uint32 NumWords)
     }
 }
 
+uint32 FTSBC_uint256::DivideByWord(uint32* Vli, const uint32 Divisor, const uint32 NumWords)
+{
+    uint64 rem = 0;
+    for(int32 i = NumWords - 1; i >= 0; --i)
+    {
+        const uint64 cur = rem << 32 | Vli[i];
+        Vli[i] = static_cast<uint32>(cur / Divisor);
+        rem = cur % Divisor;
+    }
+
+    return static_cast<uint32>(rem);
+}
+
+bool FTSBC_uint256::MultiplyAddWord(uint32* Vli, const uint32 Factor, const uint32 Addend, const uint32 NumWords)
+{
+    uint64 k = Addend;
+    for(uint32 i = 0; i < NumWords; ++i)
+    {
+        const uint64 t = static_cast<uint64>(Vli[i]) * Factor + k;
+        Vli[i] = static_cast<uint32>(t);
+        k = t >> 32;
+    }
+
+    return k != 0;
+}
+
+bool FTSBC_uint256::ParseDecDigitsWords(uint32* Words, const TCHAR* Chars, const int32 NumChars)
+{
+    // Digits are consumed 9 at a time; the first chunk takes the digits that do not fill up a whole chunk.
+    constexpr int32 ChunkDigits = 9;
+
+    ResetToZero(Words, NUM_WORDS);
+    for(int32 Index = 0; Index < NumChars;)
+    {
+        const int32 NumChunkDigits = Index == 0 && NumChars % ChunkDigits != 0 ? NumChars % ChunkDigits : ChunkDigits;
+
+        uint32 Chunk = 0;
+        uint32 Factor = 1;
+        for(int32 i = 0; i < NumChunkDigits; i++)
+        {
+            Chunk = Chunk * 10 + (Chars[Index + i] - '0');
+            Factor *= 10;
+        }
+        Index += NumChunkDigits;
+
+        if(MultiplyAddWord(Words, Factor, Chunk, NUM_WORDS))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FTSBC_uint256::TrimWhitespace(const TCHAR*& Chars, int32& NumChars)
+{
+    while(NumChars > 0 && FChar::IsWhitespace(Chars[0]))
+    {
+        Chars++;
+        NumChars--;
+    }
+
+    while(NumChars > 0 && FChar::IsWhitespace(Chars[NumChars - 1]))
+    {
+        NumChars--;
+    }
+}
+
+bool FTSBC_uint256::HasHexPrefix(const TCHAR* Chars, const int32 NumChars)
+{
+    return NumChars >= 2 && Chars[0] == '0' && (Chars[1] == 'x' || Chars[1] == 'X');
+}
+
 bool FTSBC_uint256::Add(
     uint32* Result,
     const uint32* Left,
     const uint32* Right,
     const uint32 NumWords)
 {
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(NumWords == NUM_WORDS)
+    {
+        return TSBC_Uint256Limbs::Add(Result, Left, Right);
+    }
+#endif
+
     uint32 carry = 0;
     for(uint32 i = 0; i < NumWords; ++i)
     {
@@ -1123,6 +1709,13 @@ bool FTSBC_uint256::Subtract(
     const uint32* Right,
     const uint32 NumWords)
 {
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(NumWords == NUM_WORDS)
+    {
+        return TSBC_Uint256Limbs::Subtract(Result, Left, Right);
+    }
+#endif
+
     uint32 borrow = 0;
     for(uint32 i = 0; i < NumWords; ++i)
     {
@@ -1142,6 +1735,23 @@ void FTSBC_uint256::Multiply(
     const uint32* Left,
     const uint32* Right,
     const uint32 NumWords)
+{
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(NumWords == NUM_WORDS)
+    {
+        TSBC_Uint256Limbs::Multiply(Result, Left, Right);
+        return;
+    }
+#endif
+
+    MultiplyWords(Result, Left, Right, NumWords);
+}
+
+void FTSBC_uint256::MultiplyWords(
+    uint32* Result,
+    const uint32* Left,
+    const uint32* Right,
+    const uint32 NumWords)
 {
     uint64 k, t;
     uint32 i, j;
@@ -1170,6 +1780,23 @@ bool FTSBC_uint256::Divide(
     const uint32* Dividend,
     const uint32* Divisor,
     const uint32 NumWords)
+{
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    if(NumWords == NUM_WORDS)
+    {
+        return TSBC_Uint256Limbs::Divide(Quotient, Remainder, Dividend, Divisor);
+    }
+#endif
+
+    return DivideWords(Quotient, Remainder, Dividend, Divisor, NumWords);
+}
+
+bool FTSBC_uint256::DivideWords(
+    uint32* Quotient,
+    uint32* Remainder,
+    const uint32* Dividend,
+    const uint32* Divisor,
+    const uint32 NumWords)
 {
     uint32 m = NumWords;
     uint32 n = NumWords;
@@ -1382,6 +2009,15 @@ void FTSBC_uint256::ModMultiply(
     MMod(Result, product, Mod, NumWords);
 }
 
+void FTSBC_uint256::MultiplyWrapping(uint32* Result, const uint32* Left, const uint32* Right)
+{
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    TSBC_Uint256Limbs::MultiplyModMax(Result, Left, Right);
+#else
+    ModMultiply(Result, Left, Right, MAX_VALUE, NUM_WORDS);
+#endif
+}
+
 void FTSBC_uint256::ModInverseUpdate(uint32* Uv, const uint32* Mod, const uint32 NumWords)
 {
     bool carry = false;
@@ -1559,4 +2195,125 @@ int32 FTSBC_uint256::Normalize(uint32 Value)
     }
 
     return n;
+}
+
+FTSBC_uint256BenchmarkResult FTSBC_uint256::Benchmark(const int32 NumOperations)
+{
+    FTSBC_uint256BenchmarkResult Result;
+    Result.NumOperations = FMath::Clamp(NumOperations, 1, 1000000);
+    Result.bHas64BitLimbs = TSBC_UINT256_USE_64BIT_LIMBS;
+    Result.bResultsMatch = true;
+
+    const int32 Num = Result.NumOperations;
+    const double MinSeconds = 1e-9;
+
+    // Full width operands; divisors get a random number of significant words to reach every division branch
+    FRandomStream Random(Num);
+    TArray<uint32> Lefts;
+    Lefts.SetNumUninitialized(Num * NUM_WORDS);
+    TArray<uint32> Rights;
+    Rights.SetNumZeroed(Num * NUM_WORDS);
+    TArray<FString> DecStrings;
+    DecStrings.Reserve(Num);
+    for(int32 i = 0; i < Num; i++)
+    {
+        uint256_t Left;
+        for(uint32 Word = 0; Word < NUM_WORDS; Word++)
+        {
+            Left[Word] = Random.GetUnsignedInt();
+        }
+        Left[NUM_WORDS - 1] |= 1;
+
+        uint32* Right = &Rights[i * NUM_WORDS];
+        const int32 NumDivisorWords = 1 + Random.RandHelper(NUM_WORDS);
+        for(int32 Word = 0; Word < NumDivisorWords; Word++)
+        {
+            Right[Word] = Random.GetUnsignedInt();
+        }
+        Right[NumDivisorWords - 1] |= 1;
+
+        FMemory::Memcpy(&Lefts[i * NUM_WORDS], Left, NUM_BYTES);
+        DecStrings.Add(FTSBC_uint256(Left).ToDecString());
+    }
+
+    TArray<uint32> Products32;
+    Products32.SetNumZeroed(Num * 2 * NUM_WORDS);
+    TArray<uint32> Quotients32;
+    Quotients32.SetNumZeroed(Num * NUM_WORDS);
+    TArray<uint32> Remainders32;
+    Remainders32.SetNumZeroed(Num * NUM_WORDS);
+    TArray<uint32> Parsed32;
+    Parsed32.SetNumZeroed(Num * NUM_WORDS);
+
+    double Start = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Num; i++)
+    {
+        MultiplyWords(&Products32[i * 2 * NUM_WORDS], &Lefts[i * NUM_WORDS], &Rights[i * NUM_WORDS], NUM_WORDS);
+    }
+    Result.Multiply32BitNanoseconds = FMath::Max(FPlatformTime::Seconds() - Start, MinSeconds) * 1e9 / Num;
+
+    Start = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Num; i++)
+    {
+        DivideWords(
+            &Quotients32[i * NUM_WORDS],
+            &Remainders32[i * NUM_WORDS],
+            &Lefts[i * NUM_WORDS],
+            &Rights[i * NUM_WORDS],
+            NUM_WORDS);
+    }
+    Result.Divide32BitNanoseconds = FMath::Max(FPlatformTime::Seconds() - Start, MinSeconds) * 1e9 / Num;
+
+    Start = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Num; i++)
+    {
+        ParseDecDigitsWords(&Parsed32[i * NUM_WORDS], *DecStrings[i], DecStrings[i].Len());
+    }
+    Result.ParseDec32BitNanoseconds = FMath::Max(FPlatformTime::Seconds() - Start, MinSeconds) * 1e9 / Num;
+
+    Result.bResultsMatch = Parsed32 == Lefts;
+
+#if TSBC_UINT256_USE_64BIT_LIMBS
+    TArray<uint32> Products64;
+    Products64.SetNumZeroed(Num * 2 * NUM_WORDS);
+    TArray<uint32> Quotients64;
+    Quotients64.SetNumZeroed(Num * NUM_WORDS);
+    TArray<uint32> Remainders64;
+    Remainders64.SetNumZeroed(Num * NUM_WORDS);
+    TArray<uint32> Parsed64;
+    Parsed64.SetNumZeroed(Num * NUM_WORDS);
+
+    Start = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Num; i++)
+    {
+        TSBC_Uint256Limbs::Multiply(&Products64[i * 2 * NUM_WORDS], &Lefts[i * NUM_WORDS], &Rights[i * NUM_WORDS]);
+    }
+    Result.Multiply64BitNanoseconds = FMath::Max(FPlatformTime::Seconds() - Start, MinSeconds) * 1e9 / Num;
+
+    Start = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Num; i++)
+    {
+        TSBC_Uint256Limbs::Divide(
+            &Quotients64[i * NUM_WORDS],
+            &Remainders64[i * NUM_WORDS],
+            &Lefts[i * NUM_WORDS],
+            &Rights[i * NUM_WORDS]);
+    }
+    Result.Divide64BitNanoseconds = FMath::Max(FPlatformTime::Seconds() - Start, MinSeconds) * 1e9 / Num;
+
+    Start = FPlatformTime::Seconds();
+    for(int32 i = 0; i < Num; i++)
+    {
+        TSBC_Uint256Limbs::ParseDecDigits(&Parsed64[i * NUM_WORDS], *DecStrings[i], DecStrings[i].Len());
+    }
+    Result.ParseDec64BitNanoseconds = FMath::Max(FPlatformTime::Seconds() - Start, MinSeconds) * 1e9 / Num;
+
+    Result.bResultsMatch = Result.bResultsMatch
+                           && Products32 == Products64
+                           && Quotients32 == Quotients64
+                           && Remainders32 == Remainders64
+                           && Parsed32 == Parsed64;
+#endif
+
+    return Result;
 }
\ No newline at end of file
@@ -21,9 +21,7 @@ void UTSBC_uint256FunctionLibrary::MakeLiteralUint256FromStringWithFractionalVal
 
 FString UTSBC_uint256FunctionLibrary::Conv_Uint256ToString(const FTSBC_uint256& Value)
 {
-    FString DecValue;
-    CTSBC_BaseConverter::Hex2DecConverter().Convert(Value.ToHexString(), DecValue);
-    return DecValue;
+    return Value.ToDecString();
 }
 
 FString UTSBC_uint256FunctionLibrary::ToDecString(
@@ -7,4 +7,17 @@ UTSBC_PluginUserSettings::UTSBC_PluginUserSettings()
     // Sets default values
     bDebugLoggingSignedTransactionsEnabled = false;
     bDebugUint256Values = false;
+    SigningWorkerCount = 0;
+    bJsonRpcCoalescingEnabled = false;
+    JsonRpcCoalescingWindow = 0.0f;
+    JsonRpcMaxBatchSize = 100;
+    bJsonRpcCacheEnabled = false;
+    JsonRpcCacheSizeMB = 16;
+    JsonRpcCacheMaxAge = 2.0f;
+    JsonRpcCacheFinalityDepth = 64;
+    bJsonRpcDeduplicationEnabled = false;
+    bEthCallAggregationEnabled = false;
+    Multicall3Address = "0xcA11bde05977b3631167028862bE2a173976CA11";
+    EthCallAggregationWindow = 0.0f;
+    EthCallAggregationMaxCalls = 100;
 }
\ No newline at end of file
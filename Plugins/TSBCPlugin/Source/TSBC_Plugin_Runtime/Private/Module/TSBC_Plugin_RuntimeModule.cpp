@@ -7,6 +7,10 @@
 #include "Developer/Settings/Public/ISettingsModule.h"
 // =============================================================================
 
+#include "Blockchain/SignTransaction/TSBC_SigningExecutor.h"
+#include "JsonRpc/Eth/TSBC_Multicall3.h"
+#include "JsonRpc/Generic/TSBC_RpcEndpointPool.h"
+#include "JsonRpc/Generic/TSBC_SendJsonRpcRequest.h"
 #include "Module/TSBC_PluginDefaultSettings.h"
 #include "Module/TSBC_PluginUserSettings.h"
 
@@ -48,6 +52,14 @@ void FTSBC_Plugin_RuntimeModule::ShutdownModule()
     // modules that support dynamic reloading, we call this function before
     // unloading the module.
 
+    // Stop the signing workers before the module's code is unloaded
+    CTSBC_SigningExecutor::Shutdown();
+
+    // Requests held back for coalescing must not be sent by a ticker after the module is gone
+    CTSBC_Multicall3::Shutdown();
+    CTSBC_SendJsonRpcRequest::Shutdown();
+    CTSBC_RpcEndpointPool::Shutdown();
+
     // Remove custom settings
     if(ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
     {
@@ -1,6 +1,7 @@
 // Copyright 2022 3S Game Studio OU. All Rights Reserved.
 
 #pragma once
+#include "Data/TSBC_EthTransactionTypes.h"
 #include "Data/TSBC_Types.h"
 #include "Math/TSBC_uint256.h"
 
@@ -53,7 +54,9 @@ public:
     /**
      * Signs a transaction.
      * 
-     * @param ResponseDelegate Delegate to handle the response. Will also be called if a signing the transaction fails.
+     * The transaction is signed on a worker of the shared signing executor.
+     * 
+     * @param ResponseDelegate Delegate to handle the response on the game thread. Will also be called if a signing the transaction fails.
      * @param PrivateKey The private key to use for signing the transaction.
      * @param Nonce The nonce.
      * @param GasPrice The gas price used for each gas unit.
@@ -109,7 +112,9 @@ public:
     /**
      * Signs a transaction.
      * 
-     * @param ResponseDelegate Delegate to handle the response. Will also be called if a signing the transaction fails.
+     * The transaction is signed on a worker of the shared signing executor.
+     * 
+     * @param ResponseDelegate Delegate to handle the response on the game thread. Will also be called if a signing the transaction fails.
      * @param PrivateKey The private key to use for signing the transaction.
      * @param Transaction The transaction parameters.
      */
@@ -138,40 +143,99 @@ public:
         const FString PrivateKey,
         const FTSBC_EthTransaction& Transaction);
 
-private:
     /**
-     * Normalizes transaction parameters by transforming or filling out missing information.
+     * Signs a transaction given in binary form. All intermediate data stays in byte buffers.
+     *
+     * Legacy transactions are signed according to EIP-155. Access list (0x01) and dynamic fee (0x02) transactions are
+     * encoded as typed envelopes (EIP-2718): the message hash is KEC(Type || RLP(Fields)) and the signed transaction is
+     * Type || RLP(Fields, Y-Parity, R, S).
+     *
+     * @param PrivateKey The 32 byte private key to use for signing the transaction.
+     * @param Transaction The transaction parameters.
+     * @param OutSignedTransaction The encoded and signed transaction data that can be passed to eth_sendRawTransaction.
+     * @param OutMessageHash The 32 byte message hash of the signed transaction.
+     * @param OutTransactionHash The 32 byte hash of the signed transaction.
+     * @param OutErrorMessage Contains an error message in case the operation fails. Otherwise, it will be empty.
+     * @returns True if the operation is successful.
+     */
+    static bool SignTransactionBinarySync(
+        const TArray<uint8>& PrivateKey,
+        const FTSBC_EthTransactionBinary& Transaction,
+        TArray<uint8>& OutSignedTransaction,
+        TArray<uint8>& OutMessageHash,
+        TArray<uint8>& OutTransactionHash,
+        FString& OutErrorMessage);
+
+    /**
+     * Parses transaction parameters given as strings into binary form.
+     * Numbers can be given in decimal or in hex notation (prefixed with "0x"), addresses and data in hex notation.
      *
      * @param InTransaction The transaction parameters.
-     * @param OutTransactionNormalized The normalized transaction parameters.
+     * @param OutTransaction The parsed transaction parameters.
      * @param OutErrorMessage Contains an error message in case the operation fails. Otherwise, it will be empty.
      * @returns True if the operation is successful.
      */
-    static bool NormalizeTransactionData(
+    static bool ParseTransaction(
         const FTSBC_EthTransaction& InTransaction,
-        FTSBC_EthTransaction& OutTransactionNormalized,
+        FTSBC_EthTransactionBinary& OutTransaction,
         FString& OutErrorMessage);
 
+private:
     /**
-     * Builds an array of strings from the transaction parameters to be used for RLP-encoding a message.
+     * Signs a transaction given in binary form and converts the results to hex at the API boundary.
      *
-     * @param InTransaction The transaction parameters.
-     * @returns An array of strings from the transaction parameters.
+     * @param bSuccess True if the operation is successful.
+     * @param ErrorMessage Contains an error message in case the operation fails. Otherwise, it will be empty.
+     * @param SignedTransaction The encoded and signed transaction data that can be passed to eth_sendRawTransaction.
+     * @param MessageHash The message hash of the signed transaction.
+     * @param TransactionHash The hash of the signed transaction.
+     * @param PrivateKey The private key to use for signing the transaction.
+     * @param Transaction The transaction parameters.
      */
-    static TArray<FString> BuildMessageTransactionParams(const FTSBC_EthTransaction& InTransaction);
+    static void SignTransactionBinaryToHex(
+        bool& bSuccess,
+        FString& ErrorMessage,
+        FString& SignedTransaction,
+        FString& MessageHash,
+        FString& TransactionHash,
+        const TArray<uint8>& PrivateKey,
+        const FTSBC_EthTransactionBinary& Transaction);
 
     /**
-     * Builds an array of strings from the transaction parameters to be used for signing the transaction.
+     * Builds the transaction from the parameters of the typed signing functions.
      *
-     * @param InTransaction The transaction parameters.
-     * @param Signature The signature.
-     * @param OutTransactionParams The transaction parameters as string array.
+     * @param OutTransaction The transaction parameters in binary form.
      * @param OutErrorMessage Contains an error message in case the operation fails. Otherwise, it will be empty.
-     * @returns An array of strings from the transaction parameters.
+     * @returns True if the nonce is not negative and the chain ID is positive.
      */
-    static bool BuildSignedTransactionParams(
-        const FTSBC_EthTransaction& InTransaction,
-        const TArray<uint8> Signature,
-        TArray<FString>& OutTransactionParams,
+    static bool MakeTransaction(
+        const int32 Nonce,
+        const FTSBC_uint256& GasPrice,
+        const FTSBC_uint256& GasLimit,
+        const FString& ToAddress,
+        const FTSBC_uint256& Value,
+        const FString& Data,
+        const int32 ChainId,
+        FTSBC_EthTransactionBinary& OutTransaction,
         FString& OutErrorMessage);
+
+    /**
+     * RLP-encodes the transaction parameters that make up the message to sign, including the type prefix of typed
+     * transactions.
+     *
+     * @param InTransaction The transaction parameters.
+     * @returns The RLP-encoded message.
+     */
+    static TArray<uint8> EncodeMessage(const FTSBC_EthTransactionBinary& InTransaction);
+
+    /**
+     * RLP-encodes the transaction parameters together with the signature.
+     *
+     * @param InTransaction The transaction parameters.
+     * @param Signature The 65 byte signature (R, S, recovery id).
+     * @returns The RLP-encoded signed transaction.
+     */
+    static TArray<uint8> EncodeSignedTransaction(
+        const FTSBC_EthTransactionBinary& InTransaction,
+        const TArray<uint8>& Signature);
 };
\ No newline at end of file
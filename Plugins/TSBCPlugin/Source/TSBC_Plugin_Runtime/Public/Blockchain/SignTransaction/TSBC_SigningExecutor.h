@@ -0,0 +1,241 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+/**
+ * Snapshot of the signing executor's counters.
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_SigningExecutorStats
+{
+    /**
+     * Number of worker threads.
+     */
+    int32 NumWorkers = 0;
+
+    /**
+     * Number of submitted jobs that no worker has picked up yet.
+     */
+    int32 QueueDepth = 0;
+
+    /**
+     * Number of jobs currently executing on a worker.
+     */
+    int32 NumActive = 0;
+
+    /**
+     * Number of finished jobs whose completions have not yet run on the game thread.
+     */
+    int32 NumPendingCompletions = 0;
+
+    /**
+     * Total number of jobs submitted since the executor was started.
+     */
+    uint64 NumSubmitted = 0;
+
+    /**
+     * Total number of jobs executed since the executor was started.
+     */
+    uint64 NumExecuted = 0;
+
+    /**
+     * Average time in seconds a job waited in the queue before a worker picked it up.
+     */
+    double AverageQueueLatency = 0.0;
+
+    /**
+     * Average time in seconds from submission until a worker finished the job.
+     */
+    double AverageLatency = 0.0;
+
+    /**
+     * Longest time in seconds from submission until a worker finished a job.
+     */
+    double MaxLatency = 0.0;
+};
+
+/**
+ * Runs signing jobs on a fixed set of persistent worker threads.
+ *
+ * Jobs are submitted through a lock-free multi-producer queue. Each job returns a completion that is handed back to
+ * the game thread; completions that finish close together are run by a single game thread task.
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_SigningExecutor : public TSharedFromThis<CTSBC_SigningExecutor, ESPMode::ThreadSafe>
+{
+public:
+    /**
+     * Runs on the game thread after the job has finished.
+     */
+    using FCompletion = TUniqueFunction<void()>;
+
+    /**
+     * Runs on a worker thread and returns the completion to run on the game thread.
+     */
+    using FWork = TUniqueFunction<FCompletion()>;
+
+private:
+    /**
+     * A submitted job.
+     */
+    struct FJob
+    {
+        /**
+         * The work to execute.
+         */
+        FWork Work;
+
+        /**
+         * Cycle counter at the time of submission.
+         */
+        uint64 SubmitCycles = 0;
+    };
+
+    /**
+     * A worker thread draining the submission queue.
+     */
+    class FWorker final : public FRunnable
+    {
+    public:
+        explicit FWorker(CTSBC_SigningExecutor& InOwner);
+
+        virtual uint32 Run() override;
+
+    private:
+        CTSBC_SigningExecutor& Owner;
+    };
+
+public:
+    /**
+     * Returns the shared executor, starting it on first use.
+     * The number of workers is taken from the plug-in user settings. After Shutdown(), the stopped executor is
+     * returned and it is not started again.
+     */
+    static TSharedRef<CTSBC_SigningExecutor, ESPMode::ThreadSafe> Get();
+
+    /**
+     * Stops the shared executor, if it was started. Jobs that are already queued are still executed, but their
+     * completions are discarded. Jobs submitted afterwards are discarded.
+     */
+    static void Shutdown();
+
+    /**
+     * Starts the workers.
+     *
+     * @param NumWorkers The number of worker threads. Values below 1 select a count based on the available cores.
+     * @param bStopped True to create the executor already stopped, without any workers.
+     */
+    explicit CTSBC_SigningExecutor(int32 NumWorkers, const bool bStopped = false);
+
+    ~CTSBC_SigningExecutor();
+
+    /**
+     * Queues a job. Safe to call from any thread; only waits for a concurrent submission or stop. Once the executor
+     * is stopped, the job is discarded.
+     *
+     * @param Work The work to execute on a worker thread. The completion it returns is run on the game thread.
+     */
+    void Submit(FWork&& Work);
+
+    /**
+     * Returns a snapshot of the queue depth and latency counters.
+     */
+    FTSBC_SigningExecutorStats GetStats() const;
+
+private:
+    /**
+     * Stops and joins all workers.
+     */
+    void StopWorkers();
+
+    /**
+     * Pops the next job. Called by workers only.
+     *
+     * @param OutJob The dequeued job.
+     * @returns True if a job was dequeued.
+     */
+    bool TryDequeue(FJob& OutJob);
+
+    /**
+     * Executes a job on the calling worker thread and queues its completion.
+     *
+     * @param Job The job to execute.
+     */
+    void Execute(FJob& Job);
+
+    /**
+     * Runs all queued completions, including those of jobs that finished while the executor was stopping.
+     * Called on the game thread only.
+     */
+    void DrainCompletions();
+
+private:
+    /**
+     * The shared executor returned by Get().
+     */
+    static TSharedPtr<CTSBC_SigningExecutor, ESPMode::ThreadSafe> Instance;
+
+    /**
+     * Guards creation and destruction of the shared executor.
+     */
+    static FCriticalSection InstanceLock;
+
+    /**
+     * Submitted jobs. Any thread may enqueue.
+     */
+    TQueue<FJob, EQueueMode::Mpsc> Jobs;
+
+    /**
+     * Serializes workers popping from the submission queue; submitters never take it.
+     */
+    FCriticalSection DequeueLock;
+
+    /**
+     * Makes checking bStopping and enqueuing a job atomic with respect to StopWorkers(), so every accepted job is
+     * enqueued before the workers drain the queue and exit.
+     */
+    FCriticalSection SubmitLock;
+
+    /**
+     * Finished jobs' completions. Workers enqueue, the game thread dequeues.
+     */
+    TQueue<FCompletion, EQueueMode::Mpsc> Completions;
+
+    /**
+     * Signaled whenever work is available or the executor is stopping.
+     */
+    FEvent* WorkAvailableEvent;
+
+    TArray<TUniquePtr<FWorker>> Workers;
+
+    TArray<FRunnableThread*> Threads;
+
+    /**
+     * Number of workers that could be started. Set once in the constructor, so it may be read without a lock while
+     * StopWorkers() empties Threads.
+     */
+    int32 NumStartedWorkers;
+
+    std::atomic<bool> bStopping;
+
+    std::atomic<bool> bDrainScheduled;
+
+    std::atomic<int32> QueueDepth;
+
+    std::atomic<int32> NumActive;
+
+    std::atomic<int32> NumPendingCompletions;
+
+    std::atomic<uint64> NumSubmitted;
+
+    std::atomic<uint64> NumExecuted;
+
+    std::atomic<uint64> TotalQueueCycles;
+
+    std::atomic<uint64> TotalLatencyCycles;
+
+    std::atomic<uint64> MaxLatencyCycles;
+};
\ No newline at end of file
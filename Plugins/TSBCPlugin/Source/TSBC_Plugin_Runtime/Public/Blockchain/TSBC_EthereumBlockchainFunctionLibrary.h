@@ -31,6 +31,51 @@ public:
         const ETSBC_EthereumNetwork EthereumNetwork,
         FTSBC_BlockchainConfig& BlockchainConfig);
 
+    /**
+     * Routes all JSON-RPC requests sent to the config's RpcUrl through a pool of its RPC URLs.
+     * Requests go to the URL with the best latency and error rate, fail over to the FallbackRpcUrls on timeouts,
+     * rate limiting and server errors, and are optionally hedged; see the properties of the config.
+     *
+     * @param BlockchainConfig The config with RpcUrl and, optionally, FallbackRpcUrls.
+     */
+    UFUNCTION(
+        BlueprintCallable,
+        DisplayName="Register RPC Endpoints",
+        Category="3Studio|Blockchain|Ethereum")
+    static void RegisterRpcEndpoints(const FTSBC_BlockchainConfig& BlockchainConfig);
+
+    /**
+     * Sends JSON-RPC requests to the RpcUrl directly again.
+     *
+     * @param RpcUrl The RpcUrl of a config registered with "Register RPC Endpoints".
+     */
+    UFUNCTION(
+        BlueprintCallable,
+        DisplayName="Unregister RPC Endpoints",
+        Category="3Studio|Blockchain|Ethereum")
+    static void UnregisterRpcEndpoints(const FString& RpcUrl);
+
+    /**
+     * Gets the counters of the JSON-RPC response cache, which is enabled in the plugin settings.
+     *
+     * @param Stats Hits, misses and evictions since startup, and the current number of entries and their size.
+     */
+    UFUNCTION(
+        BlueprintPure,
+        DisplayName="Get JSON-RPC Cache Stats",
+        Category="3Studio|Blockchain|Ethereum")
+    static void GetJsonRpcCacheStats(FTSBC_JsonRpcCacheStats& Stats);
+
+    /**
+     * Removes all responses from the JSON-RPC response cache, e.g. after the local state was changed by a
+     * transaction.
+     */
+    UFUNCTION(
+        BlueprintCallable,
+        DisplayName="Clear JSON-RPC Cache",
+        Category="3Studio|Blockchain|Ethereum")
+    static void ClearJsonRpcCache();
+
     /**
      * Generates Ethereum Address using keccak-256 algorithm from public key provided as a string.
      * If the public key is not 64 Bytes (128 characters) long or contains non hex characters
@@ -69,6 +114,26 @@ public:
         FString& EthereumAddress,
         FString& ErrorMessage);
 
+    /**
+     * Recovers the Ethereum address of the account that signed the given hash (ecrecover).
+     *
+     * @param Hash The signed hash.
+     * @param Signature The signature (65 bytes), the last byte is the recovery id (0, 1, 27 or 28).
+     * @param EthereumAddress The recovered address with checksum.
+     * @param ErrorMessage Describes why the address couldn't be recovered.
+     * @returns True if the address was recovered.
+     */
+    UFUNCTION(
+        BlueprintCallable,
+        DisplayName = "Recover Ethereum Address from Signature",
+        Category = "3Studio|Blockchain|Ethereum",
+        Meta=(Keywords="ecrecover"))
+    static UPARAM(DisplayName="bSuccess") bool RecoverAddress(
+        const TArray<uint8>& Hash,
+        const TArray<uint8>& Signature,
+        FString& EthereumAddress,
+        FString& ErrorMessage);
+
     /**
      * Validates an Ethereum address.
      * 
@@ -193,4 +258,21 @@ public:
      */
     UFUNCTION(BlueprintPure, DisplayName = "Verify Signature JSON", Category = "Atherlabs|Blockchain|Ethereum")
     static bool VerifySignatureJSONMessage(const FString& PublicKey, const FString& JSONMessage, const FString& Signature);
+    /**
+     * recover the address that signed the json message string with GenerateSignatureJSONMessage (personal_sign)
+     *
+     * @param JSONMessage The stringtify of JSON message.
+     * @param Signature The signature hex string.
+     * @returns The address with checksum, empty if the address couldn't be recovered.
+     */
+    UFUNCTION(BlueprintPure, DisplayName = "Recover Address JSON", Category = "Atherlabs|Blockchain|Ethereum")
+    static FString RecoverAddressJSONMessage(const FString& JSONMessage, const FString& Signature);
+
+    /**
+     * Hashes the message the way personal_sign does, keccak256("\x19Ethereum Signed Message:\n" + length + message).
+     *
+     * @param Message The message.
+     * @returns The hash (32 bytes).
+     */
+    static TArray<uint8> HashPersonalMessage(const FString& Message);
 };
\ No newline at end of file
@@ -2,6 +2,27 @@
 
 #pragma once
 
+/**
+ * A signed hash together with the public key to check it against, input of the batch signature verification.
+ */
+struct FTSBC_Secp256k1SignatureToVerify
+{
+    /**
+     * The public key (64 bytes).
+     */
+    TArrayView<const uint8> PublicKey;
+
+    /**
+     * The signed hash.
+     */
+    TArrayView<const uint8> Hash;
+
+    /**
+     * The signature, only the first 64 bytes (r and s) are used.
+     */
+    TArrayView<const uint8> Signature;
+};
+
 /**
  * This class implements ECDSA using curve secp256k1.
  */
@@ -28,6 +49,7 @@ private:
         void (*mod_sqrt)(uint32* a, const uECC_Curve* curve);
         void (*x_side)(uint32* result, const uint32* x, const uECC_Curve* curve);
         void (*mmod_fast)(uint32* result, uint32* product);
+        void (*mmod_fast_n)(uint32* result, uint32* product);
     };
 
     struct uECC_HashContext
@@ -40,7 +62,62 @@ private:
         uint8* tmp;           /* Must point to a buffer of at least (2 * result_size + block_size) bytes. */
     };
 
+    /**
+     * Constants of the secp256k1 endomorphism lambda * (x, y) = (beta * x, y) and of the scalar decomposition
+     * k = k1 + k2 * lambda (mod n) into two halves of roughly 128 bits.
+     */
+    struct uECC_Endomorphism
+    {
+        uint32 beta[8];
+        uint32 lambda[8];
+        uint32 minus_b1[8];
+        uint32 minus_b2[8];
+        uint32 g1[8];
+        uint32 g2[8];
+    };
+
     const static uECC_Curve curve_secp256k1;
+    const static uECC_Endomorphism endomorphism_secp256k1;
+
+    /**
+     * The fixed-base table for the generator point splits a scalar into 4-bit windows.
+     */
+    constexpr static int32 uECC_BASE_WINDOW_BITS = 4;
+    constexpr static int32 uECC_BASE_WINDOW_SIZE = 1 << uECC_BASE_WINDOW_BITS;
+    constexpr static int32 uECC_BASE_NUM_WINDOWS = 256 / uECC_BASE_WINDOW_BITS;
+
+    /**
+     * Affine multiples of the generator point, points[i][j] = j * 16^i * G + offset_i.
+     * The offsets sum up to zero, so no entry is the point at infinity.
+     */
+    struct uECC_BaseTable
+    {
+        uint32 points[uECC_BASE_NUM_WINDOWS][uECC_BASE_WINDOW_SIZE][8 * 2];
+    };
+
+    /**
+     * Window widths of the wNAF representations used for verification, the generator point gets a wider
+     * window because its table of odd multiples is only built once.
+     */
+    constexpr static int32 uECC_WNAF_G_WINDOW_BITS = 8;
+    constexpr static int32 uECC_WNAF_POINT_WINDOW_BITS = 5;
+    constexpr static int32 uECC_WNAF_G_TABLE_SIZE = 1 << (uECC_WNAF_G_WINDOW_BITS - 2);
+    constexpr static int32 uECC_WNAF_POINT_TABLE_SIZE = 1 << (uECC_WNAF_POINT_WINDOW_BITS - 2);
+    constexpr static int32 uECC_WNAF_MAX_DIGITS = 258;
+
+    /**
+     * Number of signatures that share their inversions in a batch verification, every chunk is one task.
+     */
+    constexpr static int32 uECC_VERIFY_BATCH_CHUNK_SIZE = 64;
+
+    /**
+     * Affine odd multiples G, 3G, 5G, ... of the generator point and their images under the endomorphism.
+     */
+    struct uECC_WnafTable
+    {
+        uint32 points[uECC_WNAF_G_TABLE_SIZE][8 * 2];
+        uint32 points_lambda[uECC_WNAF_G_TABLE_SIZE][8 * 2];
+    };
 
 public:
     /**
@@ -120,6 +197,36 @@ public:
         const TArray<uint8>& Hash,
         const TArray<uint8>& Signature);
 
+    /**
+     * Checks the signatures of many signed hashes with secp256k1 at once.
+     *
+     * Works like Secp256k1_VerifySignature for every item, but the modular inversions of the items are shared and
+     * the work is spread over the task graph worker threads.
+     *
+     * @param Signatures The public keys, signed hashes and signatures to check.
+     * @param Results Bit i is set if the signature of item i is valid.
+     * @returns True if all signatures are valid.
+     */
+    static bool Secp256k1_VerifySignatureBatch(
+        const TArrayView<const FTSBC_Secp256k1SignatureToVerify> Signatures,
+        TBitArray<>& Results);
+
+    /**
+     * Recovers the public key that created the signature of a signed hash with secp256k1 (ecrecover).
+     *
+     * The last byte of the signature is the recovery id as written by Secp256k1_CreateSignature (0 or 1), the legacy
+     * values 27 and 28 are accepted as well.
+     *
+     * @param Hash The signed hash.
+     * @param Signature The signature (65 bytes).
+     * @param PublicKey The recovered public key (64 bytes).
+     * @returns False on failure.
+     */
+    static bool Secp256k1_RecoverPublicKey(
+        const TArray<uint8>& Hash,
+        const TArray<uint8>& Signature,
+        TArray<uint8>& PublicKey);
+
     /**
      * Compresses the public key.
      *
@@ -188,6 +295,7 @@ private:
     static void x_side_secp256k1(uint32* result, const uint32* x, const uECC_Curve* curve);
     static void vli_mmod_fast_secp256k1(uint32* result, uint32* product);
     static void omega_mult_secp256k1(uint32* result, const uint32* right);
+    static void vli_mmod_fast_n_secp256k1(uint32* result, uint32* product);
     static int32 uECC_curve_private_key_size(const uECC_Curve* curve);
     static int32 uECC_curve_public_key_size(const uECC_Curve* curve);
     static void uECC_vli_clear(uint32* vli, const int32 num_words);
@@ -225,8 +333,10 @@ private:
         const int32 num_words);
     static void uECC_vli_modMult_fast(uint32* result, const uint32* left, const uint32* right, const uECC_Curve* curve);
     static void uECC_vli_modSquare_fast(uint32* result, const uint32* left, const uECC_Curve* curve);
+    static void uECC_vli_modMult_n(uint32* result, const uint32* left, const uint32* right, const uECC_Curve* curve);
     static void vli_modInv_update(uint32* uv, const uint32* mod, const int32 num_words);
     static void uECC_vli_modInv(uint32* result, const uint32* input, const uint32* mod, const int32 num_words);
+    static void uECC_vli_modInv_batch(uint32* values, const int32 count, const uint32* mod, const uECC_Curve* curve);
     static bool EccPoint_isZero(const uint32* point, const uECC_Curve* curve);
     static void apply_z(uint32* X1, uint32* Y1, const uint32* const Z, const uECC_Curve* curve);
     static void XYcZ_initial_double(
@@ -238,6 +348,7 @@ private:
         const uECC_Curve* curve);
     static void XYcZ_add(uint32* X1, uint32* Y1, uint32* X2, uint32* Y2, const uECC_Curve* curve);
     static void XYcZ_addC(uint32* X1, uint32* Y1, uint32* X2, uint32* Y2, const uECC_Curve* curve);
+    static void EccPoint_add_mixed(uint32* X1, uint32* Y1, uint32* Z1, const uint32* point, const uECC_Curve* curve);
     static int32 EccPoint_mult(
         uint32* result,
         const uint32* point,
@@ -246,6 +357,29 @@ private:
         const int32 num_bits,
         const uECC_Curve* curve);
     static bool regularize_k(const uint32* const k, uint32* k0, uint32* k1, const uECC_Curve* curve);
+    static void uECC_build_base_table(uECC_BaseTable& table, const uECC_Curve* curve);
+    static const uECC_BaseTable& uECC_base_table();
+    static int32 EccPoint_mult_base(uint32* result, const uint32* scalar, const uECC_Curve* curve);
+    static void scalar_mul_shift_384(uint32* result, const uint32* left, const uint32* right);
+    static void scalar_split_lambda(uint32* k1, uint32* k2, const uint32* k, const uECC_Curve* curve);
+    static int32 wnaf_encode(int32* wnaf, const uint32* scalar, const int32 window_bits);
+    static void EccPoint_odd_multiples_co_z(
+        uint32* table,
+        uint32* z_values,
+        const uint32* point,
+        const int32 count,
+        const uECC_Curve* curve);
+    static void EccPoint_odd_multiples(uint32* table, const uint32* point, const int32 count, const uECC_Curve* curve);
+    static void EccPoint_apply_endomorphism(uint32* result, const uint32* point, const uECC_Curve* curve);
+    static const uECC_WnafTable& uECC_wnaf_table();
+    static void EccPoint_mult_add_glv(
+        uint32* X,
+        uint32* Y,
+        uint32* Z,
+        const uint32* u1,
+        const uint32* u2,
+        const uint32* point_table,
+        const uECC_Curve* curve);
     static bool EccPoint_compute_public_key(uint32* result, const uint32* private_key, const uECC_Curve* curve);
     static void uECC_vli_nativeToBytes(uint8* bytes, const int32 num_bytes, const uint32* native);
     static void uECC_vli_bytesToNative(uint32* native, const uint8* bytes, const int32 num_bytes);
@@ -292,6 +426,18 @@ private:
         const uint32 hash_size,
         const uint8* signature,
         const uECC_Curve* curve);
+    static bool uECC_verify_x(const uint32* X, const uint32* Z, const uint32* r, const uECC_Curve* curve);
+    static void uECC_verify_batch(
+        const FTSBC_Secp256k1SignatureToVerify* items,
+        const int32 count,
+        uint8* results,
+        const uECC_Curve* curve);
+    static bool uECC_recover(
+        const uint8* message_hash,
+        const uint32 hash_size,
+        const uint8* signature,
+        uint8* public_key,
+        const uECC_Curve* curve);
 
     static uECC_HashContext GetHashContextSha256(TArray<uint8>& Buffer);
     static uECC_HashContext GetHashContextSha512(TArray<uint8>& Buffer);
@@ -128,6 +128,24 @@ public:
         const TArray<uint8>& Hash,
         const TArray<uint8>& Signature);
 
+    /**
+     * Recovers the public key that created the signature of a signed hash with secp256k1 (ecrecover).
+     *
+     * @param Hash The signed hash.
+     * @param Signature The signature (65 bytes), the last byte is the recovery id (0, 1, 27 or 28).
+     * @param PublicKey The recovered public key.
+     * @returns False on failure.
+     */
+    UFUNCTION(
+        BlueprintCallable,
+        DisplayName="Recover Public Key (secp256k1)",
+        Category="3Studio|Cryptography|Encryption|ECDSA",
+        Meta=(Keywords="ecrecover signature"))
+    static UPARAM(DisplayName="bSuccess") bool Secp256k1_RecoverPublicKey(
+        const TArray<uint8>& Hash,
+        const TArray<uint8>& Signature,
+        TArray<uint8>& PublicKey);
+
     /**
      * Compresses the public key.
      *
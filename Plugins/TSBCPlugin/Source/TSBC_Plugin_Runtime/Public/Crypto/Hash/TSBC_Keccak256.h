@@ -80,6 +80,36 @@ public:
      */
     FString KeccakFromBytes(const TArray<uint8>& Bytes);
 
+    /**
+     * Generates a KECCAK-256 hash from a byte array without converting it to hex.
+     *
+     * @param Bytes The data to hash.
+     * @param OutHash Receives the hash. Must have room for 32 bytes (or the digest size of the selected variant).
+     */
+    void HashToBytes(const TArrayView<const uint8> Bytes, uint8* OutHash);
+
+    /**
+     * Adds data to the hash that is being computed. Data can be added in as many pieces as needed,
+     * hashing the concatenation without copying it into one buffer first.
+     *
+     * @param Bytes The data to add.
+     */
+    void Update(const TArrayView<const uint8> Bytes);
+
+    /**
+     * Adds text to the hash that is being computed, as single byte characters like KeccakFromString does.
+     *
+     * @param Text The text to add.
+     */
+    void UpdateAnsi(const FString& Text);
+
+    /**
+     * Finishes the hash of all data added by Update() and resets the instance, so it can be reused.
+     *
+     * @param OutHash Receives the hash. Must have room for 32 bytes (or the digest size of the selected variant).
+     */
+    void Final(uint8* OutHash);
+
 private:
     /**
      * Process a full block.
@@ -106,6 +136,13 @@ private:
      */
     FString GetHash();
 
+    /**
+     * Writes the latest hash as raw bytes.
+     *
+     * @param OutHash Receives the digest. Must have room for the digest size of the selected variant.
+     */
+    void GetHash(uint8* OutHash);
+
     /**
      * Resets buffer and calculated hash.
      */
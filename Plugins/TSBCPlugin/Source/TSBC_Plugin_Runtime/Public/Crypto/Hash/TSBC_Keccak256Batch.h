@@ -0,0 +1,86 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Throughput measured by CTSBC_Keccak256Batch::Benchmark().
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_Keccak256BenchmarkResult
+{
+    /**
+     * Instruction set used by the batch implementation.
+     */
+    const TCHAR* InstructionSet = TEXT("");
+
+    /**
+     * Number of messages hashed in parallel by the batch implementation.
+     */
+    int32 NumLanes = 0;
+
+    int32 NumMessages = 0;
+
+    int32 MessageSize = 0;
+
+    double BatchMegabytesPerSecond = 0.0;
+
+    double BatchHashesPerSecond = 0.0;
+
+    double ScalarMegabytesPerSecond = 0.0;
+
+    double ScalarHashesPerSecond = 0.0;
+
+    /**
+     * True if both implementations produced the same hashes.
+     */
+    bool bHashesMatch = false;
+};
+
+/**
+ * Hashes many independent messages with KECCAK-256 at once.
+ *
+ * The Keccak-f[1600] permutation runs on several messages in parallel, one message per SIMD lane: 8 lanes with
+ * AVX-512, 4 with AVX2, 2 with SSE2 or NEON. The instruction set is chosen when the plug-in is compiled, based on
+ * what the target platform is built for; without vector intrinsics the permutation runs on one message at a time.
+ *
+ * Messages may differ in length. A lane whose message is finished picks up the next one, so all lanes stay busy
+ * until the last messages. This suits large numbers of short inputs, e.g. function selectors, event topics,
+ * address checksums or Merkle tree leaves.
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_Keccak256Batch
+{
+public:
+    /**
+     * Size of one hash in bytes.
+     */
+    static constexpr int32 HashSize = 32;
+
+    /**
+     * Hashes every message.
+     *
+     * @param Messages The messages to hash.
+     * @param OutHashes Receives the hashes in the order of the messages. Must have room for HashSize bytes per message.
+     */
+    static void Hash(const TArrayView<const TArrayView<const uint8>> Messages, uint8* OutHashes);
+
+    /**
+     * @returns Number of messages hashed in parallel.
+     */
+    static int32 GetNumLanes();
+
+    /**
+     * @returns Name of the instruction set the batch implementation was compiled for.
+     */
+    static const TCHAR* GetInstructionSet();
+
+    /**
+     * Measures the throughput of the batch implementation against hashing the same messages one by one.
+     * Also available as console command: TSBC.Keccak256Benchmark [NumMessages] [MessageSize]
+     *
+     * @param NumMessages Number of messages to hash, clamped to 1 to 10000000. Reduced further if all messages
+     *                    together would exceed 1 GiB.
+     * @param MessageSize Size of each message in bytes, clamped to 0 to 1 MiB.
+     * @returns The measured throughput.
+     */
+    static FTSBC_Keccak256BenchmarkResult Benchmark(const int32 NumMessages, const int32 MessageSize);
+};
\ No newline at end of file
@@ -0,0 +1,156 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * A KECCAK-256 hash as 32 raw bytes.
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_Keccak256Hash
+{
+    uint8 Bytes[32] = {};
+
+    /**
+     * @returns The hash as lowercase hex string with "0x" prefix, e.g. for passing it to a contract call.
+     */
+    FString ToHexString() const;
+
+    /**
+     * Parses a hash from a hex string of 64 digits, with or without "0x" prefix.
+     *
+     * @param HexString The hex string.
+     * @param OutHash The hash.
+     * @returns True if the string holds exactly 32 bytes.
+     */
+    static bool FromHexString(const FString& HexString, FTSBC_Keccak256Hash& OutHash);
+
+    bool operator==(const FTSBC_Keccak256Hash& Other) const
+    {
+        return FMemory::Memcmp(Bytes, Other.Bytes, sizeof(Bytes)) == 0;
+    }
+
+    bool operator!=(const FTSBC_Keccak256Hash& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+/**
+ * A Merkle tree over KECCAK-256 hashes, compatible with OpenZeppelin's MerkleProof library.
+ *
+ * Every inner node is the hash of its two children in sorted order, i.e. keccak256(min(a, b) ++ max(a, b)), so a
+ * proof is only the list of sibling hashes and does not need to say which side each sibling is on. A node without
+ * sibling, the last one of a level with an odd number of nodes, moves up to the next level unchanged and adds
+ * nothing to the proof.
+ *
+ * All levels are kept in one array, leaves first and root last, so a proof is read with one lookup per level.
+ * Leaves and inner nodes are hashed with CTSBC_Keccak256Batch, spread over the task graph workers for large trees.
+ *
+ * The leaves are used as given. A common choice is keccak256(abi.encodePacked(Account, Amount)), which
+ * BuildFromLeafData() computes from the packed bytes. OpenZeppelin's StandardMerkleTree instead hashes the
+ * abi.encode()d values twice and sorts the leaves; callers wanting that layout pass such leaves to BuildFromLeaves().
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_KeccakMerkleTree
+{
+public:
+    /**
+     * Builds the tree from leaves that are already hashed.
+     *
+     * @param Leaves The leaf hashes, in the order that defines the leaf indices.
+     */
+    void BuildFromLeaves(const TArrayView<const FTSBC_Keccak256Hash> Leaves);
+
+    /**
+     * Builds the tree from the keccak256 hashes of the given data.
+     *
+     * @param LeafData The data of each leaf, e.g. abi.encodePacked(Account, Amount).
+     */
+    void BuildFromLeafData(const TArrayView<const TArrayView<const uint8>> LeafData);
+
+    /**
+     * Removes all nodes.
+     */
+    void Reset();
+
+    /**
+     * @returns Number of leaves.
+     */
+    int32 GetNumLeaves() const;
+
+    /**
+     * @returns The leaf at the given index.
+     */
+    const FTSBC_Keccak256Hash& GetLeaf(const int32 LeafIndex) const;
+
+    /**
+     * @returns The root hash, all zeros if the tree is empty.
+     */
+    FTSBC_Keccak256Hash GetRoot() const;
+
+    /**
+     * Collects the sibling hashes from the leaf up to the root, as expected by MerkleProof.verify().
+     *
+     * @param LeafIndex Index of the leaf.
+     * @param OutProof The sibling hashes.
+     * @returns True if the leaf index is valid.
+     */
+    bool GetProof(const int32 LeafIndex, TArray<FTSBC_Keccak256Hash>& OutProof) const;
+
+    /**
+     * Same as GetProof(), with the hashes as hex strings.
+     */
+    bool GetProofAsHex(const int32 LeafIndex, TArray<FString>& OutProof) const;
+
+    /**
+     * Checks a proof the same way as MerkleProof.verify() does on-chain.
+     *
+     * @param Proof The sibling hashes from the leaf up to the root.
+     * @param Root The expected root hash.
+     * @param Leaf The leaf hash.
+     * @returns True if the proof leads from the leaf to the root.
+     */
+    static bool VerifyProof(
+        const TArrayView<const FTSBC_Keccak256Hash> Proof,
+        const FTSBC_Keccak256Hash& Root,
+        const FTSBC_Keccak256Hash& Leaf);
+
+    /**
+     * @returns keccak256 of both hashes in sorted order.
+     */
+    static FTSBC_Keccak256Hash HashPair(const FTSBC_Keccak256Hash& A, const FTSBC_Keccak256Hash& B);
+
+    /**
+     * Writes the tree to a binary file. Only the leaves and the root are stored; inner nodes are rebuilt on load.
+     *
+     * @param Filename Path of the file.
+     * @returns True if the file was written.
+     */
+    bool SaveToFile(const FString& Filename) const;
+
+    /**
+     * Reads a tree written by SaveToFile() and checks that the rebuilt root matches the stored one.
+     * The tree is left empty if the file cannot be used.
+     *
+     * @param Filename Path of the file.
+     * @param OutErrorMessage Reason why the file could not be used, if any.
+     * @returns True if the tree was loaded.
+     */
+    bool LoadFromFile(const FString& Filename, FString& OutErrorMessage);
+
+private:
+    /**
+     * Hashes the levels above the leaves, which must be in place at the start of Nodes.
+     */
+    void BuildLevels(const int32 NumLeaves);
+
+private:
+    /**
+     * All levels, one after another: the leaves first, the root last.
+     */
+    TArray<FTSBC_Keccak256Hash> Nodes;
+
+    /**
+     * Index of the first node of each level in Nodes, followed by the total number of nodes.
+     */
+    TArray<int32> LevelOffsets;
+};
\ No newline at end of file
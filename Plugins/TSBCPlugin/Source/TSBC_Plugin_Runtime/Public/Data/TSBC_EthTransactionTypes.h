@@ -2,22 +2,108 @@
 
 #pragma once
 #include "CoreMinimal.h"
+#include "Data/TSBC_Types.h"
 #include "Math/TSBC_uint256.h"
 
 #include "TSBC_EthTransactionTypes.generated.h"
 
 /**
- * The type of the transaction
+ * An address and the storage slots of it that a transaction plans to access (EIP-2930), in binary form.
  */
-UENUM(BlueprintType)
-enum class ETSBC_EthTransactionType : uint8
+USTRUCT(BlueprintType)
+struct FTSBC_EthAccessListEntryBinary
+{
+    GENERATED_BODY()
+
+    /**
+     * The 20 byte address.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<uint8> Address;
+
+    /**
+     * The storage keys, each encoded as full 32 byte value.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<FTSBC_uint256> StorageKeys;
+};
+
+/**
+ * Transaction parameters in binary form. Signing from this representation needs no string conversions.
+ *
+ * GasPrice is used by legacy and access list transactions, MaxPriorityFeePerGas and MaxFeePerGas by dynamic fee
+ * transactions.
+ */
+USTRUCT(BlueprintType)
+struct FTSBC_EthTransactionBinary
 {
-    // @formatter:off
-    Legacy     = 0x00   UMETA(DisplayName = "Legacy Transaction"),
-    AccessList = 0x01   UMETA(DisplayName = "Access List Type"),
-    DynamicFee = 0x02   UMETA(DisplayName = "Dynamic Fee"),
-    MAX                 UMETA(Hidden)
-    // @formatter:on
+    GENERATED_BODY()
+
+    /**
+     * The nonce.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 Nonce = 0;
+
+    /**
+     * The gas price used for each gas unit.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 GasPrice = 0;
+
+    /**
+     * Gas limit provided for the transaction to execute.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 GasLimit = 0;
+
+    /**
+     * The 20 byte address the transaction is directed to. Empty for contract creation.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<uint8> ToAddress;
+
+    /**
+     * The amount of Ether (in Wei) to send with this transaction.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 Value = 0;
+
+    /**
+     * The hash of the invoked method signature and encoded parameters (ABI).
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<uint8> Data;
+
+    /**
+     * The Blockchain ID.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 ChainId = 0;
+
+    /**
+     * The transaction envelope. Legacy transactions are signed according to EIP-155.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    ETSBC_EthTransactionType Type = ETSBC_EthTransactionType::Legacy;
+
+    /**
+     * Maximum fee per gas unit paid to the block producer. Only used by dynamic fee transactions.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 MaxPriorityFeePerGas = 0;
+
+    /**
+     * Maximum total fee per gas unit, including the base fee. Only used by dynamic fee transactions.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FTSBC_uint256 MaxFeePerGas = 0;
+
+    /**
+     * Addresses and storage keys the transaction plans to access. Not used by legacy transactions.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<FTSBC_EthAccessListEntryBinary> AccessList;
 };
 
 /**
@@ -19,6 +19,27 @@ struct FTSBC_BlockchainConfig
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
     FString RpcUrl = "";
 
+    /**
+     * Further RPC URLs of this Blockchain, e.g. of other providers.
+     * Once the config is registered with "Register RPC Endpoints", requests sent to RpcUrl are routed to the
+     * healthiest of all URLs and fail over to the others on timeouts, rate limiting (429) and server errors.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<FString> FallbackRpcUrls;
+
+    /**
+     * Time in seconds a request may take on one RPC URL before the next one is tried. 0 disables the timeout.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain", Meta=(ClampMin=0, Units="s"))
+    float RpcRequestTimeout = 10.0f;
+
+    /**
+     * If true, read-only requests like eth_call and eth_getBalance are also sent to a second RPC URL if the first
+     * one did not respond within its usual (95th percentile) latency. The first response is used.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    bool bHedgeReadOnlyRequests = false;
+
     /**
      * The network name of this Blockchain, e.g. "Ethereum MainNet", "Ethereum Testnet (Rinkeby)", etc.
      */
@@ -110,6 +131,45 @@ struct FTSBC_JsonRpcResponse
     FString Body = "";
 };
 
+/**
+ * Counters of the JSON-RPC response cache.
+ */
+USTRUCT(BlueprintType)
+struct FTSBC_JsonRpcCacheStats
+{
+    GENERATED_BODY()
+
+    /**
+     * Number of requests answered from the cache.
+     */
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="3Studio|JSON-RPC")
+    int64 NumHits = 0;
+
+    /**
+     * Number of cacheable requests that were sent to the node.
+     */
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="3Studio|JSON-RPC")
+    int64 NumMisses = 0;
+
+    /**
+     * Number of responses removed to stay within the byte budget.
+     */
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="3Studio|JSON-RPC")
+    int64 NumEvictions = 0;
+
+    /**
+     * Number of cached responses.
+     */
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="3Studio|JSON-RPC")
+    int32 NumEntries = 0;
+
+    /**
+     * Approximate memory used by the cached responses.
+     */
+    UPROPERTY(BlueprintReadOnly, EditAnywhere, Category="3Studio|JSON-RPC")
+    int64 NumBytes = 0;
+};
+
 /**
  * Supported Ethereum networks.
  */
@@ -169,6 +229,41 @@ enum class ETSBC_EthBlockIdentifier : uint8
     // @formatter:on
 };
 
+/**
+ * The type of the transaction
+ */
+UENUM(BlueprintType)
+enum class ETSBC_EthTransactionType : uint8
+{
+    // @formatter:off
+    Legacy     = 0x00   UMETA(DisplayName = "Legacy Transaction"),
+    AccessList = 0x01   UMETA(DisplayName = "Access List Type"),
+    DynamicFee = 0x02   UMETA(DisplayName = "Dynamic Fee"),
+    MAX                 UMETA(Hidden)
+    // @formatter:on
+};
+
+/**
+ * An address and the storage slots of it that a transaction plans to access (EIP-2930).
+ */
+USTRUCT(BlueprintType)
+struct FTSBC_EthAccessListEntry
+{
+    GENERATED_BODY()
+
+    /**
+     * The address in hex notation.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FString Address = "";
+
+    /**
+     * The 32 byte storage keys in hex notation.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<FString> StorageKeys;
+};
+
 /**
  * Holds information about a transaction that can be sent to an Ethereum Blockchain.
  *
@@ -220,6 +315,30 @@ struct FTSBC_EthTransaction
      */
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
     FString ChainId = "";
+
+    /**
+     * The transaction envelope. Legacy transactions are signed according to EIP-155.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    ETSBC_EthTransactionType Type = ETSBC_EthTransactionType::Legacy;
+
+    /**
+     * Maximum fee per gas unit paid to the block producer. Only used by dynamic fee transactions.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FString MaxPriorityFeePerGas = "";
+
+    /**
+     * Maximum total fee per gas unit, including the base fee. Only used by dynamic fee transactions.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    FString MaxFeePerGas = "";
+
+    /**
+     * Addresses and storage keys the transaction plans to access. Not used by legacy transactions.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="3Studio|Blockchain")
+    TArray<FTSBC_EthAccessListEntry> AccessList;
 };
 
 UENUM(BlueprintType)
@@ -0,0 +1,448 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "Data/TSBC_ContractAbiTypes.h"
+#include "Data/TSBC_Types.h"
+#include "Math/TSBC_uint256.h"
+
+class CTSBC_Keccak256;
+
+/**
+ * Solidity type of a parameter, without its array dimension.
+ */
+enum class ETSBC_AbiTypeKind : uint8
+{
+    Address,
+    Uint,
+    Bool,
+    FixedBytes,
+    Bytes,
+    String,
+    Tuple
+};
+
+/**
+ * Layout of a parameter or tuple component, resolved once when the ABI is compiled.
+ */
+struct FTSBC_AbiTypePlan
+{
+    ETSBC_AbiTypeKind Kind = ETSBC_AbiTypeKind::Uint;
+
+    /**
+     * N of "bytesN", 0 for other types.
+     */
+    int32 FixedBytesLength = 0;
+
+    /**
+     * INDEX_NONE if the type is not an array, 0 for a dynamic array "T[]" and N for a static array "T[N]".
+     */
+    int32 ArrayLength = INDEX_NONE;
+
+    /**
+     * True if the value is stored in the tail and referenced by an offset in the head.
+     */
+    bool bDynamic = false;
+
+    /**
+     * Number of 32 byte words the value takes in the head.
+     */
+    int32 HeadWords = 1;
+
+    /**
+     * Components of a tuple, as range of CTSBC_CompiledContractAbi's type plans.
+     */
+    int32 FirstComponent = 0;
+    int32 NumComponents = 0;
+
+    /**
+     * @returns True if an element of the type is stored in the tail.
+     */
+    bool IsElementDynamic() const
+    {
+        return Kind == ETSBC_AbiTypeKind::Bytes || Kind == ETSBC_AbiTypeKind::String;
+    }
+};
+
+/**
+ * A decoded value which is not a tuple or an array, referencing the encoded data it was decoded from.
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_AbiValueView
+{
+    ETSBC_AbiTypeKind Kind = ETSBC_AbiTypeKind::Uint;
+
+    /**
+     * The 32 byte word of "uint" and "bool", the 20 bytes of "address", the N bytes of "bytesN" and the content of
+     * "bytes" and "string".
+     */
+    TArrayView<const uint8> Bytes;
+
+    FTSBC_uint256 GetUint() const;
+
+    bool GetBool() const;
+
+    /**
+     * @returns The value in the notation of CTSBC_ContractAbiDecoding.
+     */
+    FString ToString() const;
+};
+
+/**
+ * A function of a compiled Contract ABI.
+ */
+struct FTSBC_CompiledAbiFunction
+{
+    FString Name;
+
+    /**
+     * Canonical signature the selector is hashed from, e.g. "transfer(address,uint256)".
+     */
+    FString Signature;
+
+    /**
+     * First 4 bytes of the KECCAK-256 hash of the signature.
+     */
+    uint8 Selector[4] = {0, 0, 0, 0};
+
+    /**
+     * The selector in hex, prefixed with "0x".
+     */
+    FString SelectorHex;
+
+    /**
+     * Parameters, as ranges of CTSBC_CompiledContractAbi's type plans.
+     */
+    int32 FirstInput = 0;
+    int32 NumInputs = 0;
+    int32 FirstOutput = 0;
+    int32 NumOutputs = 0;
+
+    /**
+     * Number of value lists of the arguments and of the return values. A tuple takes one value list per component.
+     */
+    int32 NumInputValueLists = 0;
+    int32 NumOutputValueLists = 0;
+
+    /**
+     * Empty if the parameters can be encoded and decoded, otherwise the reason why not.
+     */
+    FString UnsupportedReason;
+};
+
+/**
+ * An event of a compiled Contract ABI.
+ */
+struct FTSBC_CompiledAbiEvent
+{
+    FString Name;
+
+    /**
+     * Canonical signature topic 0 is hashed from, e.g. "Transfer(address,address,uint256)".
+     */
+    FString Signature;
+
+    /**
+     * KECCAK-256 hash of the signature, prefixed with "0x". Anonymous events do not emit it.
+     */
+    FString Topic0;
+
+    bool bAnonymous = false;
+
+    /**
+     * All parameters in declaration order, as range of CTSBC_CompiledContractAbi's type plans. Indexed parameters
+     * that are not stored in a topic as they are have a "bytes32" plan.
+     */
+    int32 FirstInput = 0;
+    int32 NumInputs = 0;
+
+    /**
+     * True for each parameter stored in a topic.
+     */
+    TArray<bool> IndexedInputs;
+
+    int32 NumIndexedInputs = 0;
+
+    /**
+     * The parameters stored in the data, as range of CTSBC_CompiledContractAbi's type plans.
+     */
+    int32 FirstDataInput = 0;
+    int32 NumDataInputs = 0;
+
+    /**
+     * Number of value lists of the decoded parameters. A tuple in the data takes one value list per component.
+     */
+    int32 NumValueLists = 0;
+
+    /**
+     * Empty if logs can be decoded, otherwise the reason why not. Only the parameters in the data can make an event
+     * unsupported.
+     */
+    FString UnsupportedReason;
+};
+
+/**
+ * Contract ABI compiled for encoding and decoding many calls.
+ *
+ * Compiling resolves the selector and a flat type plan of every function once, so encoding a call or decoding its
+ * return data neither searches the ABI nor parses type strings. Calls are encoded into one buffer, sized up front,
+ * with values written as big-endian words; hex is only produced for the returned string. Return data is converted
+ * from hex once and decoded by walking words at byte offsets, into views of the data or strings made from them.
+ * A compiled ABI is not modified afterwards and can be shared between threads.
+ *
+ * Values are passed like for CTSBC_ContractAbiEncoding and CTSBC_ContractAbiDecoding:
+ * - One value list per parameter, holding the elements of an array or the single value otherwise.
+ * - One value list per component of a tuple.
+ * - "uint" as decimal or hex prefixed with "0x", "bool" as "True" or "False", "address", "bytes" and "bytesN"
+ *   as hex prefixed with "0x", "string" as text. Decoded values use the same notation, with "uint" in decimal.
+ *
+ * Event logs are decoded into value lists in the order the parameters are declared. Indexed parameters are taken
+ * from the topics, the others are decoded from the data. Indexed strings, bytes, arrays and tuples are only stored as
+ * their hash, which is returned as "bytes32", as are indexed values of types that are not supported otherwise.
+ *
+ * Features:
+ * - Lookup by function name and by selector
+ * - Lookup of events by name and by topic 0
+ * - Supported types:
+ *   - Address, Uint, Bool, BytesN, Bytes, String
+ *   - Static and dynamic arrays of the above
+ *   - Tuple of the above, at any position
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_CompiledContractAbi
+{
+public:
+    /**
+     * Compiles all functions of a Contract ABI. Functions with unsupported types are kept, so they can be found by
+     * selector, but cannot be encoded or decoded.
+     *
+     * @param ContractAbi The Contract ABI.
+     * @returns The compiled Contract ABI.
+     */
+    static TSharedRef<const CTSBC_CompiledContractAbi> Compile(const FTSBC_ContractAbi& ContractAbi);
+
+    /**
+     * @param FunctionName Name of the function. For overloaded functions, the first one in the ABI is found.
+     * @returns The function, or nullptr if the ABI has no function of that name.
+     */
+    const FTSBC_CompiledAbiFunction* FindFunction(const FString& FunctionName) const;
+
+    /**
+     * @param Selector The first 4 bytes of call data.
+     * @returns The function, or nullptr if the ABI has no function with that selector.
+     */
+    const FTSBC_CompiledAbiFunction* FindFunctionBySelector(const uint8* Selector) const;
+
+    /**
+     * Encodes a call of a function.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Function A function of this ABI.
+     * @param Arguments Function arguments to encode.
+     * @param FunctionSelectorAndEncodedArguments The "Function Selector" with encoded arguments, prefixed with "0x".
+     * @returns True if the operation is successful.
+     */
+    bool EncodeFunctionCall(
+        FString& ErrorMessage,
+        const FTSBC_CompiledAbiFunction& Function,
+        const TArray<FTSBC_SolidityValueList>& Arguments,
+        FString& FunctionSelectorAndEncodedArguments) const;
+
+    /**
+     * Encodes a call of a function as bytes, e.g. for signing a transaction.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Function A function of this ABI.
+     * @param Arguments Function arguments to encode.
+     * @param CallData The "Function Selector" with encoded arguments.
+     * @returns True if the operation is successful.
+     */
+    bool EncodeFunctionCall(
+        FString& ErrorMessage,
+        const FTSBC_CompiledAbiFunction& Function,
+        const TArray<FTSBC_SolidityValueList>& Arguments,
+        TArray<uint8>& CallData) const;
+
+    /**
+     * Decodes the return data of a function call.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Function A function of this ABI.
+     * @param DataToDecode The return data, prefixed with "0x".
+     * @param DecodedValues The decoded return values.
+     * @returns True if the operation is successful.
+     */
+    bool DecodeFunctionResult(
+        FString& ErrorMessage,
+        const FTSBC_CompiledAbiFunction& Function,
+        const FString& DataToDecode,
+        TArray<FTSBC_SolidityValueList>& DecodedValues) const;
+
+    /**
+     * Decodes the return data of a function call without converting the values to strings.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Function A function of this ABI.
+     * @param Data The return data.
+     * @param DecodedValues The decoded return values, one array per value list. They reference Data, which must be
+     *                      kept alive while they are used.
+     * @returns True if the operation is successful.
+     */
+    bool DecodeFunctionResult(
+        FString& ErrorMessage,
+        const FTSBC_CompiledAbiFunction& Function,
+        const TArrayView<const uint8> Data,
+        TArray<TArray<FTSBC_AbiValueView>>& DecodedValues) const;
+
+    /**
+     * @param EventName Name of the event. For overloaded events, the first one in the ABI is found.
+     * @returns The event, or nullptr if the ABI has no event of that name.
+     */
+    const FTSBC_CompiledAbiEvent* FindEvent(const FString& EventName) const;
+
+    /**
+     * @param Topic0 The first topic of a log, in hex prefixed with "0x".
+     * @returns The event, or nullptr if the ABI has no event with that topic. Anonymous events are never found.
+     */
+    const FTSBC_CompiledAbiEvent* FindEventByTopic(const FString& Topic0) const;
+
+    /**
+     * Decodes the parameters of an event log.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Event An event of this ABI.
+     * @param Log The log, e.g. returned by "eth_getLogs".
+     * @param DecodedValues The decoded parameters.
+     * @returns True if the operation is successful.
+     */
+    bool DecodeEventLog(
+        FString& ErrorMessage,
+        const FTSBC_CompiledAbiEvent& Event,
+        const FTSBC_EthLog& Log,
+        TArray<FTSBC_SolidityValueList>& DecodedValues) const;
+
+    /**
+     * Decodes the parameters of an event log, finding the event by the log's first topic.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Log The log, e.g. returned by "eth_getLogs".
+     * @param Event The event of the log, nullptr if the ABI has none matching its first topic.
+     * @param DecodedValues The decoded parameters.
+     * @returns True if the operation is successful.
+     */
+    bool DecodeEventLog(
+        FString& ErrorMessage,
+        const FTSBC_EthLog& Log,
+        const FTSBC_CompiledAbiEvent*& Event,
+        TArray<FTSBC_SolidityValueList>& DecodedValues) const;
+
+    /**
+     * Decodes the parameters of an event log without converting the values to strings. Passing the same buffer for
+     * many logs avoids allocating it for each one.
+     *
+     * @param ErrorMessage Contains an error message in case the operation fails.
+     * @param Event An event of this ABI.
+     * @param Log The log, e.g. returned by "eth_getLogs".
+     * @param Buffer Receives the topics and data as bytes.
+     * @param DecodedValues The decoded parameters, one array per value list. They reference Buffer, which must be
+     *                      kept alive and unchanged while they are used.
+     * @returns True if the operation is successful.
+     */
+    bool DecodeEventLog(
+        FString& ErrorMessage,
+        const FTSBC_CompiledAbiEvent& Event,
+        const FTSBC_EthLog& Log,
+        TArray<uint8>& Buffer,
+        TArray<TArray<FTSBC_AbiValueView>>& DecodedValues) const;
+
+    const TArray<FTSBC_CompiledAbiFunction>& GetFunctions() const
+    {
+        return Functions;
+    }
+
+    const TArray<FTSBC_CompiledAbiEvent>& GetEvents() const
+    {
+        return Events;
+    }
+
+private:
+    /**
+     * Adds the type plans of parameters, with the components of tuples after them.
+     *
+     * @returns The index of the first parameter's plan.
+     */
+    int32 CompileParameters(
+        const TArray<FTSBC_SolidityFunctionSignature>& Parameters,
+        FString& CanonicalTypes,
+        int32& NumValueLists,
+        FString& UnsupportedReason);
+
+    void CompileEvent(const FTSBC_ContractAbiEvent& AbiEvent, CTSBC_Keccak256& Hasher);
+
+    /**
+     * Resolves a type string like "uint256[3]" into the plan at the given index.
+     *
+     * @returns False if the type is not supported.
+     */
+    bool CompileType(const FString& Type, const int32 PlanIndex);
+
+    /**
+     * Computes the number of bytes the encoding of a tuple takes, and checks the number of values.
+     */
+    bool MeasureTuple(
+        FString& ErrorMessage,
+        const int32 FirstPlan,
+        const int32 NumPlans,
+        const TArray<FTSBC_SolidityValueList>& Arguments,
+        int32& ArgumentIndex,
+        int32& NumBytes) const;
+
+    /**
+     * Writes the encoding of a tuple whose values have been checked by MeasureTuple.
+     *
+     * @param Destination Zeroed memory of the size returned by MeasureTuple. Offsets are relative to it.
+     * @param NumBytes Number of bytes written.
+     */
+    bool WriteTuple(
+        FString& ErrorMessage,
+        const int32 FirstPlan,
+        const int32 NumPlans,
+        const TArray<FTSBC_SolidityValueList>& Arguments,
+        int32& ArgumentIndex,
+        uint8* Destination,
+        int32& NumBytes) const;
+
+    /**
+     * Decodes the values of a tuple, checking every offset and length against the bounds of the data.
+     *
+     * @param Start Index of the tuple's first byte, to which offsets are relative.
+     */
+    bool DecodeTuple(
+        FString& ErrorMessage,
+        const int32 FirstPlan,
+        const int32 NumPlans,
+        const TArrayView<const uint8> Data,
+        const int32 Start,
+        TArray<TArray<FTSBC_AbiValueView>>& DecodedValues) const;
+
+private:
+    TArray<FTSBC_CompiledAbiFunction> Functions;
+
+    /**
+     * Type plans of all parameters and tuple components.
+     */
+    TArray<FTSBC_AbiTypePlan> Plans;
+
+    TMap<FString, int32> FunctionsByName;
+
+    /**
+     * Selector as big-endian uint32.
+     */
+    TMap<uint32, int32> FunctionsBySelector;
+
+    TArray<FTSBC_CompiledAbiEvent> Events;
+
+    TMap<FString, int32> EventsByName;
+
+    /**
+     * Topic 0 in hex, compared ignoring case.
+     */
+    TMap<FString, int32> EventsByTopic;
+};
\ No newline at end of file
@@ -8,8 +8,10 @@
  * Supported features:
  * - Encode an item (string)
  * - Encode a list of items (array)
- * 
- * Decoding of RLP-encoded data is not supported for now.
+ * - Encode a list of byte strings without hex conversion
+ * - Encode nested lists, integers and byte strings into a caller-provided buffer, see CTSBC_RLPWriter
+ *
+ * Decoding of RLP-encoded data is done by CTSBC_RLPReader.
  */
 class TSBC_PLUGIN_RUNTIME_API UTSBC_RLP
 {
@@ -30,6 +32,48 @@ public:
      */
     static TArray<uint8> Encode(const TArray<FString>& InHexArray);
 
+    /**
+     * RLP-encodes a list of byte strings.
+     * The encoded size is computed up front, so the result is written into a single allocation.
+     *
+     * @param Items The byte strings to encode as list elements.
+     * @returns An array of bytes containing the RLP-encoded list.
+     */
+    static TArray<uint8> EncodeList(const TArrayView<const TArrayView<const uint8>> Items);
+
+    // Building blocks for writers that size their output up front, e.g. for nested lists
+
+    /**
+     * @param NumBytes Length of the payload.
+     * @returns Number of bytes needed for the header of a string or list with the given payload length.
+     */
+    static int32 GetHeaderSize(const int32 NumBytes);
+
+    /**
+     * @param Item The byte string.
+     * @returns Number of bytes needed to encode the byte string including its header.
+     */
+    static int32 GetEncodedItemSize(const TArrayView<const uint8> Item);
+
+    /**
+     * Writes the header of a string (Offset 0x80) or list (Offset 0xC0).
+     *
+     * @param Dest Destination with room for GetHeaderSize(NumBytes) bytes.
+     * @param NumBytes Length of the payload.
+     * @param Offset 0x80 for strings, 0xC0 for lists.
+     * @returns Pointer behind the written header.
+     */
+    static uint8* WriteHeader(uint8* Dest, const int32 NumBytes, const uint8 Offset);
+
+    /**
+     * Writes a byte string including its header.
+     *
+     * @param Dest Destination with room for GetEncodedItemSize(Item) bytes.
+     * @param Item The byte string.
+     * @returns Pointer behind the written item.
+     */
+    static uint8* WriteItem(uint8* Dest, const TArrayView<const uint8> Item);
+
 private:
     static uint32 BytesNeeded(int32 Number);
 };
\ No newline at end of file
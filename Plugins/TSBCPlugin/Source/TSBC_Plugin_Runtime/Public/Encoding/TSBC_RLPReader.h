@@ -0,0 +1,162 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Math/TSBC_uint256.h"
+
+/**
+ * A single RLP item found by CTSBC_RLPReader. It refers to the reader's buffer, nothing is copied.
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_RLPItem
+{
+    /**
+     * True if the item is a list, false if it is a byte string.
+     */
+    bool bIsList = false;
+
+    /**
+     * Offset of the item's first byte, relative to the buffer the outermost reader was created with.
+     */
+    int32 Offset = 0;
+
+    /**
+     * Number of bytes taken by the header. Zero for a single byte below 0x80, which is its own encoding.
+     */
+    int32 HeaderSize = 0;
+
+    /**
+     * The payload: the bytes of a string, or the encoded elements of a list.
+     */
+    TArrayView<const uint8> Payload;
+
+    /**
+     * @returns Number of bytes the item takes in the buffer, including its header.
+     */
+    int32 GetEncodedSize() const
+    {
+        return HeaderSize + Payload.Num();
+    }
+
+    /**
+     * Interprets the string as canonical big-endian integer, i.e. without leading zero bytes.
+     *
+     * @param OutValue The integer.
+     * @returns True if the item is a string holding a canonical integer of up to 32 bytes.
+     */
+    bool ToUint256(FTSBC_uint256& OutValue) const;
+
+    /**
+     * Interprets the string as canonical big-endian integer, i.e. without leading zero bytes.
+     *
+     * @param OutValue The integer.
+     * @returns True if the item is a string holding a canonical integer of up to 8 bytes.
+     */
+    bool ToUint64(uint64& OutValue) const;
+};
+
+/**
+ * Walks RLP-encoded data item by item without copying.
+ *
+ * A reader iterates over a sequence of items, e.g. the top level of a buffer or the elements of one list.
+ * Lists are not descended into unless requested with EnterList(), so skipping over a list only costs parsing
+ * its header. Every header is checked for canonical form: the shortest length encoding must be used, long
+ * lengths must not have leading zero bytes, and no item may extend beyond its enclosing list or buffer.
+ *
+ * Example: reading the nonce of a legacy transaction
+ *
+ *     CTSBC_RLPReader Reader(RawTransaction);
+ *     FTSBC_RLPItem Transaction, Nonce;
+ *     if(Reader.Next(Transaction) && Transaction.bIsList)
+ *     {
+ *         CTSBC_RLPReader Fields = Reader.EnterList(Transaction);
+ *         if(Fields.Next(Nonce) && Nonce.ToUint64(NonceValue)) ...
+ *     }
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_RLPReader
+{
+public:
+    /**
+     * @param Data The RLP-encoded data. Must stay valid while the reader and the items it returns are used.
+     */
+    explicit CTSBC_RLPReader(const TArrayView<const uint8> Data);
+
+    /**
+     * Reads the next item.
+     *
+     * @param OutItem The item.
+     * @returns True if an item was read. False at the end of the data or if the data is malformed; see HasError().
+     */
+    bool Next(FTSBC_RLPItem& OutItem);
+
+    /**
+     * Creates a reader over the elements of a list read by this reader or by another reader of the same buffer.
+     *
+     * @param List A list item.
+     * @returns The reader over the list's elements.
+     */
+    CTSBC_RLPReader EnterList(const FTSBC_RLPItem& List) const;
+
+    /**
+     * @returns True if all items have been read.
+     */
+    bool IsAtEnd() const;
+
+    /**
+     * @returns True if malformed data was encountered.
+     */
+    bool HasError() const;
+
+    /**
+     * @returns A description of the malformed data, empty if there was no error.
+     */
+    const FString& GetErrorMessage() const;
+
+    /**
+     * Reads exactly one item that takes up the whole buffer, e.g. a raw transaction or block header.
+     * Only the item's own header is checked; nested lists are checked while they are read, or up front by Validate().
+     *
+     * @param Data The RLP-encoded data.
+     * @param OutItem The item.
+     * @param OutErrorMessage Description of the malformed data, if any.
+     * @returns True if the data is exactly one item.
+     */
+    static bool ReadSingle(const TArrayView<const uint8> Data, FTSBC_RLPItem& OutItem, FString& OutErrorMessage);
+
+    /**
+     * Checks that the data is a sequence of items in canonical form, descending into all nested lists.
+     *
+     * @param Data The RLP-encoded data.
+     * @param OutErrorMessage Description of the malformed data, if any.
+     * @returns True if the data is well-formed.
+     */
+    static bool Validate(const TArrayView<const uint8> Data, FString& OutErrorMessage);
+
+private:
+    CTSBC_RLPReader(const uint8* InBase, const int32 InPosition, const int32 InEnd);
+
+    /**
+     * Stops reading and records the error.
+     *
+     * @param Message Description of the malformed data.
+     * @returns Always false, for convenience.
+     */
+    bool Fail(const TCHAR* Message);
+
+private:
+    /**
+     * Start of the outermost buffer; all offsets are relative to it.
+     */
+    const uint8* Base;
+
+    /**
+     * Offset of the next item to read.
+     */
+    int32 Position;
+
+    /**
+     * Offset behind the last byte this reader may read.
+     */
+    int32 End;
+
+    FString ErrorMessage;
+};
\ No newline at end of file
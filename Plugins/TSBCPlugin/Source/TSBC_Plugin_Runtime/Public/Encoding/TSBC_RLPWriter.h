@@ -0,0 +1,183 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Math/TSBC_uint256.h"
+
+/**
+ * Builds RLP-encoded data in two passes.
+ *
+ * The first pass records the structure: byte strings, integers and arbitrarily nested lists. Sizes of lists are
+ * accumulated while they are built, so the exact encoded size is known once all lists are closed. The second pass
+ * writes everything into a single preallocated buffer or a caller-provided view, front to back, without moving data.
+ *
+ * Byte strings are referenced, not copied. The memory they point to must stay valid until the output is written.
+ * Integers are stored by the writer in their minimal big-endian form.
+ *
+ * Example: [[0x01, "abc"], 1024]
+ *
+ *     CTSBC_RLPWriter Writer;
+ *     Writer.BeginList();
+ *     Writer.BeginList();
+ *     Writer.AddUint64(1);
+ *     Writer.AddBytes(Abc);
+ *     Writer.EndList();
+ *     Writer.AddUint64(1024);
+ *     Writer.EndList();
+ *     const TArray<uint8> Encoded = Writer.ToBytes();
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_RLPWriter
+{
+private:
+    /**
+     * Kind of a recorded element.
+     */
+    enum class ENodeType : uint8
+    {
+        Bytes,
+        Integer,
+        List,
+    };
+
+    /**
+     * A recorded element.
+     */
+    struct FNode
+    {
+        ENodeType Type;
+
+        /**
+         * Bytes: the referenced data. Integer: unused.
+         */
+        const uint8* Data;
+
+        /**
+         * Bytes and Integer: number of payload bytes. List: number of payload bytes of all direct children.
+         */
+        int32 NumBytes;
+
+        /**
+         * Integer: offset into IntegerStorage. List: index of the node following the last child.
+         */
+        int32 Index;
+    };
+
+public:
+    CTSBC_RLPWriter();
+
+    /**
+     * Appends a byte string. The data is referenced until the output is written.
+     *
+     * @param Bytes The byte string.
+     */
+    void AddBytes(const TArrayView<const uint8> Bytes);
+
+    /**
+     * Appends an unsigned integer in its minimal big-endian form. Zero is encoded as the empty string.
+     *
+     * @param Value The integer.
+     */
+    void AddUint64(const uint64 Value);
+
+    /**
+     * Appends an unsigned integer in its minimal big-endian form. Zero is encoded as the empty string.
+     *
+     * @param Value The integer.
+     */
+    void AddUint256(const FTSBC_uint256& Value);
+
+    /**
+     * Appends a 256 bit value as a byte string of exactly 32 bytes, e.g. a hash or storage key.
+     *
+     * @param Value The value.
+     */
+    void AddFixedUint256(const FTSBC_uint256& Value);
+
+    /**
+     * Opens a nested list. All elements appended until the matching EndList() become its elements.
+     */
+    void BeginList();
+
+    /**
+     * Closes the innermost open list.
+     */
+    void EndList();
+
+    /**
+     * @returns True if every opened list has been closed.
+     */
+    bool IsComplete() const;
+
+    /**
+     * @returns The exact number of bytes the encoded data needs. Only meaningful once all lists are closed.
+     */
+    int32 GetEncodedSize() const;
+
+    /**
+     * Writes the encoded data into a caller-provided buffer.
+     *
+     * @param Buffer The destination. Must have room for at least GetEncodedSize() bytes.
+     * @returns The number of bytes written, or -1 if lists are still open or the buffer is too small.
+     */
+    int32 WriteTo(const TArrayView<uint8> Buffer) const;
+
+    /**
+     * Appends the encoded data to an array, growing it once by the exact size.
+     *
+     * @param Out The array to append to.
+     * @returns True if the data was written, false if lists are still open.
+     */
+    bool AppendTo(TArray<uint8>& Out) const;
+
+    /**
+     * @returns The encoded data. Empty if lists are still open.
+     */
+    TArray<uint8> ToBytes() const;
+
+    /**
+     * Discards all recorded elements, keeping allocated memory for reuse.
+     */
+    void Reset();
+
+private:
+    /**
+     * Accounts the encoded size of a new element to the innermost open list or to the top level.
+     *
+     * @param NumElementBytes Encoded size of the element including its header.
+     */
+    void AddToParent(const int32 NumElementBytes);
+
+    /**
+     * Appends an integer whose minimal big-endian bytes are given.
+     *
+     * @param Bytes The significant bytes.
+     * @param NumBytes Number of significant bytes.
+     */
+    void AddInteger(const uint8* Bytes, const int32 NumBytes);
+
+    /**
+     * @returns The payload of a Bytes or Integer node.
+     */
+    TArrayView<const uint8> GetPayload(const FNode& Node) const;
+
+private:
+    /**
+     * Recorded elements in the order they appear in the output.
+     */
+    TArray<FNode, TInlineAllocator<32>> Nodes;
+
+    /**
+     * Minimal big-endian bytes of all integers.
+     */
+    TArray<uint8, TInlineAllocator<256>> IntegerStorage;
+
+    /**
+     * Node indices of the lists that are still open, innermost last.
+     */
+    TArray<int32, TInlineAllocator<8>> OpenLists;
+
+    /**
+     * Encoded size of all top-level elements.
+     */
+    int32 NumEncodedBytes;
+};
\ No newline at end of file
@@ -0,0 +1,89 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Data/TSBC_Types.h"
+
+#include "TSBC_EthGetLogsAsyncTask.generated.h"
+
+/**
+ * Fetches logs over a block range with "eth_getLogs" requests using an AsyncTask. See CTSBC_EthGetLogs.
+ */
+UCLASS()
+class TSBC_PLUGIN_RUNTIME_API UTSBC_EthGetLogsAsyncTask : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
+        FTSBC_K2_EthGetLogsBatchAsyncTask_Delegate,
+        const int64,
+        FromBlock,
+        const int64,
+        ToBlock,
+        const TArray<FTSBC_EthLog>&,
+        Logs);
+
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+        FTSBC_K2_EthGetLogsCompletedAsyncTask_Delegate,
+        const bool,
+        bSuccess,
+        const FTSBC_JsonRpcResponse&,
+        Response);
+
+public:
+    /**
+     * Called with the logs of each part of the block range, in block order.
+     */
+    UPROPERTY(BlueprintAssignable, Category="3Studio|Blockchain|Ethereum|Methods")
+    FTSBC_K2_EthGetLogsBatchAsyncTask_Delegate OnLogs;
+
+    UPROPERTY(BlueprintAssignable, Category="3Studio|Blockchain|Ethereum|Methods")
+    FTSBC_K2_EthGetLogsCompletedAsyncTask_Delegate OnCompleted;
+
+private:
+    UPROPERTY()
+    FString _URL;
+
+    UPROPERTY()
+    int64 _FromBlock;
+
+    UPROPERTY()
+    int64 _ToBlock;
+
+    UPROPERTY()
+    TArray<FString> _Addresses;
+
+    UPROPERTY()
+    TArray<FString> _Topics;
+
+    UPROPERTY()
+    int32 _MaxConcurrentRequests;
+
+public:
+    /**
+     * Fetches all logs between two blocks matching the filter. Large ranges are split into parts that are fetched
+     * concurrently, and made smaller if the node reports too many results.
+     *
+     * @param URL The URL to send the requests to.
+     * @param FromBlock The first block of the range.
+     * @param ToBlock The last block of the range.
+     * @param Addresses [Optional] Contract addresses the logs must originate from.
+     * @param Topics [Optional] Topics the logs must have, by position. An empty string matches any topic.
+     * @param MaxConcurrentRequests Number of requests sent at the same time.
+     */
+    UFUNCTION(
+        BlueprintCallable,
+        DisplayName="eth_getLogs [Async]",
+        Category="3Studio|Blockchain|Ethereum|Methods",
+        Meta=(BlueprintInternalUseOnly="true", AutoCreateRefTerm="Addresses,Topics"))
+    static UTSBC_EthGetLogsAsyncTask* K2_EthGetLogsAsync(
+        const FString& URL,
+        const int64 FromBlock,
+        const int64 ToBlock,
+        const TArray<FString>& Addresses,
+        const TArray<FString>& Topics,
+        const int32 MaxConcurrentRequests = 4);
+
+    virtual void Activate() override;
+};
\ No newline at end of file
@@ -26,6 +26,10 @@ public:
      * @param ToAddress The address the transaction is directed to.
      * @param Data The hash of the invoked method signature and encoded parameters (ABI).
      * @param BlockIdentifier The block number to use. (Default: "latest")
+     *
+     * NOTE: If eth_call aggregation is enabled in the plug-in's user settings, a call without a from address is
+     *       sent through CTSBC_Multicall3 together with other calls. Its response is then built from the aggregated
+     *       response, and bSuccess is also false if the call reverted.
      */
     static void EthCall(
         FTSBC_EthCall_Delegate ResponseDelegate,
@@ -0,0 +1,204 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "Data/TSBC_Types.h"
+
+class FJsonObject;
+
+/**
+ * Fetches logs over a block range by sending "eth_getLogs" requests for chunks of the range.
+ *
+ * - Several chunks are fetched at the same time, up to MaxConcurrentRequests.
+ * - A chunk the node rejects for returning too many results, or for spanning too many blocks, is split in half,
+ *   and subsequent chunks are made smaller. After successful chunks, the chunk size grows again.
+ * - Other failures are retried a few times before the whole range fails.
+ * - Split and retried chunks are sent again after a delay that doubles with each consecutive failure. No new chunks
+ *   are started in the meantime, so a rate limited node is not flooded.
+ * - The logs of each chunk are passed on in block order, as soon as all chunks before it are done.
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_EthGetLogs : public TSharedFromThis<CTSBC_EthGetLogs>
+{
+public:
+    DECLARE_DELEGATE_ThreeParams(
+        FTSBC_EthGetLogsBatch_Delegate,
+        const int64 /* FromBlock */,
+        const int64 /* ToBlock */,
+        const TArray<FTSBC_EthLog>& /* Logs */);
+
+    DECLARE_DELEGATE_TwoParams(
+        FTSBC_EthGetLogsCompleted_Delegate,
+        const bool /* bSuccess */,
+        const FTSBC_JsonRpcResponse& /* Response of the failed request, if any */);
+
+    struct FTSBC_EthGetLogsOptions
+    {
+        /**
+         * Number of blocks of the first chunk.
+         */
+        int64 InitialChunkSize = 2000;
+
+        /**
+         * Chunks never grow beyond this number of blocks. Many nodes reject larger ranges.
+         */
+        int64 MaxChunkSize = 10000;
+
+        int32 MaxConcurrentRequests = 4;
+
+        /**
+         * Number of times a chunk is sent again after a failure other than too many results.
+         */
+        int32 MaxRetries = 3;
+
+        /**
+         * Seconds to wait before sending a chunk again after the first failure.
+         */
+        float InitialRetryDelay = 0.5f;
+
+        /**
+         * The delay doubles with each consecutive failure, up to this number of seconds.
+         */
+        float MaxRetryDelay = 8.0f;
+    };
+
+    /**
+     * Fetches all logs between two blocks matching the filter.
+     *
+     * @param BatchDelegate Called with the logs of each chunk, in block order. Chunks without logs are passed on too,
+     *                      so the caller can track the progress.
+     * @param CompletedDelegate Called once all chunks have been passed on, or a chunk failed.
+     * @param URL The URL to send the requests to.
+     * @param FromBlock The first block of the range.
+     * @param ToBlock The last block of the range.
+     * @param Addresses [Optional] Contract addresses the logs must originate from.
+     * @param Topics [Optional] Topics the logs must have, by position. An empty array matches any topic at its
+     *               position, several topics match any of them.
+     * @param Options Chunking and concurrency.
+     * @returns The running fetch, which can be cancelled. It is kept alive by its requests, so it does not need to
+     *          be stored.
+     */
+    static TSharedRef<CTSBC_EthGetLogs> EthGetLogs(
+        FTSBC_EthGetLogsBatch_Delegate BatchDelegate,
+        FTSBC_EthGetLogsCompleted_Delegate CompletedDelegate,
+        const FString& URL,
+        const int64 FromBlock,
+        const int64 ToBlock,
+        const TArray<FString>& Addresses,
+        const TArray<TArray<FString>>& Topics,
+        const FTSBC_EthGetLogsOptions& Options = FTSBC_EthGetLogsOptions());
+
+    /**
+     * Stops sending requests and passing on logs. The completed delegate is not called.
+     */
+    void Cancel();
+
+    /**
+     * @returns The last block whose logs have been passed on, FromBlock - 1 if none.
+     */
+    int64 GetLastPassedOnBlock() const;
+
+    CTSBC_EthGetLogs(
+        FTSBC_EthGetLogsBatch_Delegate InBatchDelegate,
+        FTSBC_EthGetLogsCompleted_Delegate InCompletedDelegate,
+        const FString& InURL,
+        const int64 FromBlock,
+        const int64 InToBlock,
+        const TArray<FString>& Addresses,
+        const TArray<TArray<FString>>& Topics,
+        const FTSBC_EthGetLogsOptions& InOptions);
+
+private:
+    enum class EChunkState : uint8
+    {
+        Pending,
+
+        /**
+         * Failed or split, and waiting for the retry delay to elapse before becoming pending again.
+         */
+        Waiting,
+        InFlight,
+        Done
+    };
+
+    struct FChunk
+    {
+        int64 FromBlock = 0;
+
+        int64 ToBlock = 0;
+
+        EChunkState State = EChunkState::Pending;
+
+        int32 NumRetries = 0;
+
+        TArray<FTSBC_EthLog> Logs;
+    };
+
+    /**
+     * Sends pending chunks and new chunks until the concurrency limit is reached, and completes once all chunks
+     * are done.
+     */
+    void Pump();
+
+    void SendChunk(FChunk& Chunk);
+
+    void OnChunkResponse(const int64 FromBlock, const FTSBC_JsonRpcResponse& Response);
+
+    /**
+     * Makes the chunks in the block range wait for the retry delay, which grows with the consecutive failures.
+     */
+    void ScheduleRetry(const int64 FromBlock, const int64 InToBlock);
+
+    /**
+     * Makes the waiting chunks in the block range pending again and sends them.
+     */
+    void OnRetryDelayElapsed(const int64 FromBlock, const int64 InToBlock);
+
+    /**
+     * Passes on the logs of the done chunks at the front.
+     */
+    void PassOnDoneChunks();
+
+    void Complete(const bool bSuccess, const FTSBC_JsonRpcResponse& Response);
+
+    /**
+     * @returns True if the node rejected the request because of the size of its result or its block range.
+     */
+    static bool IsRangeTooLargeError(const TSharedPtr<FJsonObject>& ResponseObject);
+
+private:
+    FTSBC_EthGetLogsBatch_Delegate BatchDelegate;
+
+    FTSBC_EthGetLogsCompleted_Delegate CompletedDelegate;
+
+    FString URL;
+
+    /**
+     * The filter fields following the block range, e.g. ",\"address\":[...],\"topics\":[...]", or empty.
+     */
+    FString FilterFields;
+
+    FTSBC_EthGetLogsOptions Options;
+
+    /**
+     * Chunks not passed on yet, in block order.
+     */
+    TArray<FChunk> Chunks;
+
+    int64 NextBlock;
+
+    int64 ToBlock;
+
+    int64 ChunkSize;
+
+    int32 NumInFlight = 0;
+
+    int32 NumWaiting = 0;
+
+    /**
+     * Number of failed or split chunks since the last successful one.
+     */
+    int32 NumConsecutiveFailures = 0;
+
+    int64 LastPassedOnBlock;
+
+    bool bFinished = false;
+};
\ No newline at end of file
@@ -33,6 +33,20 @@ public:
         const FString& Hash
     );
 
+    /**
+     * Parses an array of log objects, as found in receipts and in the result of "eth_getLogs".
+     *
+     * @param Object The JSON object containing the array.
+     * @param FieldName The name of the array field.
+     * @param OutValue The parsed logs.
+     * @param bAllowNull If false, a missing field is logged as error.
+     */
+    static void ParseResponseField(
+        const TSharedPtr<FJsonObject>& Object,
+        const FString& FieldName,
+        TArray<FTSBC_EthLog>& OutValue,
+        const bool bAllowNull);
+
 private:
     static void ProcessResponse(
         const FTSBC_JsonRpcResponse& Response,
@@ -81,10 +95,4 @@ private:
         TArray<FString>& OutValue,
         const bool bAllowNull);
 
-    static void ParseResponseField(
-        const TSharedPtr<FJsonObject>& Object,
-        const FString& FieldName,
-        TArray<FTSBC_EthLog>& OutValue,
-        const bool bAllowNull);
-
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "Data/TSBC_ContractAbiTypes.h"
+#include "Data/TSBC_Types.h"
+#include "Encoding/TSBC_CompiledContractAbi.h"
+#include "JsonRpc/Eth/TSBC_EthCall.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "Containers/Ticker.h"
+// =============================================================================
+
+/**
+ * Aggregates read-only contract calls into "eth_call" requests of Multicall3's "aggregate3" function.
+ *
+ * Calls are held back for the configured window and then sent as one "eth_call" per URL and block, with up to the
+ * configured number of calls each. Multicall3 executes every call and returns its success flag and return data,
+ * which are passed to each call's own delegate. A lone call is sent as a plain "eth_call".
+ *
+ * NOTE: The calls are executed by the Multicall3 contract, so "msg.sender" is its address. This makes no difference
+ *       for view functions like "balanceOf", "allowance" or "ownerOf".
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_Multicall3
+{
+public:
+    DECLARE_DELEGATE_ThreeParams(
+        FTSBC_Multicall3Function_Delegate,
+        const bool /* bSuccess */,
+        const FString& /* ErrorMessage */,
+        const TArray<FTSBC_SolidityValueList>& /* DecodedValues */);
+
+    /**
+     * Queues a call of a function of an Ethereum Smart Contract for reading values.
+     *
+     * @param ResponseDelegate Delegate to handle the response. bSuccess is false if the request failed, which is
+     *                         also reflected by Response.bSuccess, or if the call reverted. Response is the call's
+     *                         own response, with its ID and either its return data as "result" or an "execution
+     *                         reverted" error. ResponseData is the call's return data, or its revert data.
+     * @param URL The URL to send the request to.
+     * @param ID The ID of the call's response.
+     * @param ToAddress The address of the contract.
+     * @param Data The hash of the invoked method signature and encoded parameters (ABI).
+     * @param BlockIdentifier The block number to use. (Default: "latest")
+     */
+    static void EthCall(
+        CTSBC_EthCall::FTSBC_EthCall_Delegate ResponseDelegate,
+        const FString& URL,
+        const FString& ID,
+        const FString& ToAddress,
+        const FString& Data,
+        const ETSBC_EthBlockIdentifier BlockIdentifier = ETSBC_EthBlockIdentifier::Latest);
+
+    /**
+     * Encodes a call of a contract function with CTSBC_ContractAbiEncoding, queues it like EthCall and decodes the
+     * return data with CTSBC_ContractAbiDecoding.
+     *
+     * @param ResponseDelegate Delegate to handle the decoded return values. Is called right away if the arguments
+     *                         could not be encoded.
+     * @param URL The URL to send the request to.
+     * @param ToAddress The address of the contract.
+     * @param ContractAbi The Contract ABI.
+     * @param FunctionName The function to call.
+     * @param Arguments Function arguments to encode.
+     * @param BlockIdentifier The block number to use. (Default: "latest")
+     */
+    static void CallFunction(
+        FTSBC_Multicall3Function_Delegate ResponseDelegate,
+        const FString& URL,
+        const FString& ToAddress,
+        const FTSBC_ContractAbi& ContractAbi,
+        const FString& FunctionName,
+        const TArray<FTSBC_SolidityValueList>& Arguments,
+        const ETSBC_EthBlockIdentifier BlockIdentifier = ETSBC_EthBlockIdentifier::Latest);
+
+    /**
+     * Encodes a call of a function of a compiled Contract ABI, queues it like EthCall and decodes the return data.
+     * Use this for repeated calls, the ABI is not searched or parsed again.
+     *
+     * @param ResponseDelegate Delegate to handle the decoded return values. Is called right away if the function
+     *                         was not found or the arguments could not be encoded.
+     * @param URL The URL to send the request to.
+     * @param ToAddress The address of the contract.
+     * @param CompiledAbi The compiled Contract ABI.
+     * @param FunctionName The function to call.
+     * @param Arguments Function arguments to encode.
+     * @param BlockIdentifier The block number to use. (Default: "latest")
+     */
+    static void CallFunction(
+        FTSBC_Multicall3Function_Delegate ResponseDelegate,
+        const FString& URL,
+        const FString& ToAddress,
+        const TSharedRef<const CTSBC_CompiledContractAbi>& CompiledAbi,
+        const FString& FunctionName,
+        const TArray<FTSBC_SolidityValueList>& Arguments,
+        const ETSBC_EthBlockIdentifier BlockIdentifier = ETSBC_EthBlockIdentifier::Latest);
+
+    /**
+     * Sends all queued calls right away.
+     */
+    static void Flush();
+
+    /**
+     * Drops all queued calls without calling their delegates.
+     * Called when the module shuts down.
+     */
+    static void Shutdown();
+
+private:
+    struct FTSBC_Multicall3Call
+    {
+        CTSBC_EthCall::FTSBC_EthCall_Delegate ResponseDelegate;
+
+        FString ID;
+
+        FString ToAddress;
+
+        FString Data;
+    };
+
+    /**
+     * Calls queued for the same URL and block.
+     */
+    struct FTSBC_Multicall3Batch
+    {
+        FString URL;
+
+        FString BlockIdentifier;
+
+        TArray<FTSBC_Multicall3Call> Calls;
+    };
+
+    /**
+     * Sends the calls as one "aggregate3" call, or as a plain "eth_call" if there is only one.
+     */
+    static void SendBatch(FTSBC_Multicall3Batch&& Batch);
+
+    /**
+     * Ticker callback sending all queued calls.
+     */
+    static bool FlushTick(float DeltaTime);
+
+private:
+    /**
+     * Queued calls, per URL and block.
+     */
+    static TMap<FString, FTSBC_Multicall3Batch> PendingBatches;
+
+    /**
+     * Handle of the scheduled flush, invalid if none is scheduled.
+     */
+    static FTSTicker::FDelegateHandle FlushHandle;
+
+    static FCriticalSection PendingBatchesLock;
+};
\ No newline at end of file
@@ -0,0 +1,164 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "Data/TSBC_Types.h"
+
+class FJsonObject;
+
+/**
+ * In-memory cache of JSON-RPC responses for read-only methods whose result only depends on the block.
+ *
+ * Responses are keyed by URL, method and params, which include the block tag. How long a response stays valid
+ * depends on the block it refers to:
+ *
+ * - "latest", "safe" and "finalized": until eth_blockNumber, sent by anyone through CTSBC_SendJsonRpcRequest,
+ *   returns a newer block than the one known when the response was stored, or the configured max age passes.
+ * - "earliest", a block hash, or a block number at least the finality depth below the latest known block:
+ *   permanently, since the state of a final block does not change.
+ * - eth_getTransactionReceipt: permanently once the receipt's block is final, otherwise like "latest".
+ * - "pending" is never cached.
+ *
+ * The least recently used responses are evicted once the byte budget is exceeded. Stale responses are removed
+ * when they are looked up.
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_JsonRpcCache
+{
+public:
+    static CTSBC_JsonRpcCache& Get();
+
+    /**
+     * @param Method Name of a JSON-RPC method.
+     * @returns True if responses of the method may be cached.
+     */
+    static bool IsCacheableMethod(const FString& Method);
+
+    /**
+     * Looks up the response to a request.
+     *
+     * @param URL JSON-RPC URL the request is sent to.
+     * @param ID The request's ID, which is put into the response body.
+     * @param Method The name of the method to be invoked.
+     * @param Params Parameters (in JSON format) of the request.
+     * @param OutResponse The cached response.
+     * @returns True if a valid response was found.
+     */
+    bool Find(
+        const FString& URL,
+        const FString& ID,
+        const FString& Method,
+        const FString& Params,
+        FTSBC_JsonRpcResponse& OutResponse);
+
+    /**
+     * Stores the response to a request if it is cacheable, i.e. a successful response with a result.
+     * Responses to eth_blockNumber are not stored but advance the latest known block of the URL.
+     *
+     * @param URL JSON-RPC URL the request was sent to.
+     * @param Method The name of the invoked method.
+     * @param Params Parameters (in JSON format) of the request.
+     * @param Response The response.
+     */
+    void Store(const FString& URL, const FString& Method, const FString& Params, const FTSBC_JsonRpcResponse& Response);
+
+    /**
+     * Removes all responses. The counters are kept.
+     */
+    void Empty();
+
+    /**
+     * @returns The counters.
+     */
+    FTSBC_JsonRpcCacheStats GetStats() const;
+
+private:
+    struct FEntry
+    {
+        FString Key;
+
+        /**
+         * The response body without its "id" field, which is added for each request.
+         */
+        FString BodyWithoutId;
+
+        int32 StatusCode = 0;
+
+        TArray<FString> Headers;
+
+        /**
+         * Latest known block of the URL when the response was stored.
+         */
+        uint64 BlockNumber = 0;
+
+        /**
+         * Platform time when the response was stored.
+         */
+        double StoreTime = 0.0;
+
+        /**
+         * True if the response refers to a final block and does not expire.
+         */
+        bool bPermanent = false;
+
+        int64 NumBytes = 0;
+
+        /**
+         * Neighbours in the recency list, INDEX_NONE at its ends.
+         */
+        int32 MoreRecent = INDEX_NONE;
+        int32 LessRecent = INDEX_NONE;
+    };
+
+    /**
+     * How long a response may be cached.
+     */
+    enum class ELifetime : uint8
+    {
+        None,
+        Block,
+        Permanent
+    };
+
+    /**
+     * @returns How long a response for the block given in the params may be cached.
+     */
+    ELifetime GetBlockTagLifetime(const FString& URL, const FString& Method, const FString& Params) const;
+
+    /**
+     * @returns How long a receipt in the response body may be cached.
+     */
+    ELifetime GetReceiptLifetime(const FString& URL, const TSharedPtr<FJsonObject>& ResponseObject) const;
+
+    /**
+     * @returns True if the block is at least the finality depth below the latest known block of the URL.
+     */
+    bool IsFinal(const FString& URL, const uint64 BlockNumber) const;
+
+    void LinkAsMostRecent(const int32 Index);
+
+    void Unlink(const int32 Index);
+
+    void RemoveEntry(const int32 Index);
+
+private:
+    /**
+     * Entries in no particular order; removed ones are reused.
+     */
+    TArray<FEntry> Entries;
+
+    TArray<int32> FreeIndices;
+
+    TMap<FString, int32> IndexByKey;
+
+    int32 MostRecent = INDEX_NONE;
+
+    int32 LeastRecent = INDEX_NONE;
+
+    /**
+     * Latest block returned by eth_blockNumber, per URL.
+     */
+    TMap<FString, uint64> LatestBlocks;
+
+    FTSBC_JsonRpcCacheStats Stats;
+
+    mutable FCriticalSection Lock;
+};
\ No newline at end of file
@@ -0,0 +1,235 @@
+// Copyright 2022 3S Game Studio OU. All Rights Reserved.
+
+#pragma once
+#include "Data/TSBC_Types.h"
+
+// =============================================================================
+// These includes are needed to prevent plugin build failures.
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+// =============================================================================
+
+/**
+ * Health of one RPC URL, as seen by CTSBC_RpcEndpointPool.
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_RpcEndpointStats
+{
+    FString URL;
+
+    /**
+     * Moving average of the latency of successful requests, in seconds.
+     */
+    double AverageLatency = 0.0;
+
+    /**
+     * 95th percentile of the latency of the recent successful requests, in seconds.
+     */
+    double P95Latency = 0.0;
+
+    /**
+     * Moving average of the share of failed requests, between 0 and 1.
+     */
+    double ErrorRate = 0.0;
+
+    int32 NumRequests = 0;
+
+    int32 NumFailures = 0;
+
+    /**
+     * True if the URL is skipped for a while after failing, e.g. because it is rate limited.
+     */
+    bool bCoolingDown = false;
+};
+
+/**
+ * Distributes JSON-RPC requests over several RPC URLs of the same blockchain.
+ *
+ * A pool is registered for a FTSBC_BlockchainConfig. From then on, every request that CTSBC_SendJsonRpcRequest
+ * sends to the config's RpcUrl, including all CTSBC_Eth* calls, goes through the pool:
+ *
+ * - The pool keeps a moving average of the latency and error rate of every URL and sends each request to the
+ *   URL with the lowest latency, weighted by its error rate.
+ * - A request that times out, is rate limited (429) or fails with a server error (5xx) is retried on the next
+ *   best URL that has not been tried for it. The failed URL is skipped for a while, longer after repeated
+ *   failures, or as long as requested by a Retry-After header. Writes only fail over when rate limited, since
+ *   they may have reached the node before any other failure.
+ * - If hedging is enabled, a read-only request that has not been answered within the 95th percentile latency
+ *   of its URL is also sent to the next best URL. The first response is used and the other request cancelled.
+ *
+ * Responses are passed on on the game thread.
+ */
+class TSBC_PLUGIN_RUNTIME_API CTSBC_RpcEndpointPool : public TSharedFromThis<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe>
+{
+public:
+    /**
+     * Creates a pool for the config's RPC URLs and routes requests to its RpcUrl through the pool.
+     * Replaces the pool registered for the same RpcUrl before, if any.
+     *
+     * @param BlockchainConfig The config with RpcUrl and, optionally, FallbackRpcUrls.
+     */
+    static void Register(const FTSBC_BlockchainConfig& BlockchainConfig);
+
+    /**
+     * Stops routing requests to the RPC URL through a pool. Requests already sent are completed.
+     *
+     * @param RpcUrl The RpcUrl of the registered config.
+     */
+    static void Unregister(const FString& RpcUrl);
+
+    /**
+     * @param RpcUrl The URL a request is sent to.
+     * @returns The pool registered for the URL, null if none is.
+     */
+    static TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe> Find(const FString& RpcUrl);
+
+    /**
+     * Unregisters all pools. Called when the module shuts down.
+     */
+    static void Shutdown();
+
+    /**
+     * @param Method Name of a JSON-RPC method.
+     * @returns True if the method does not change any state, so it may be sent to several URLs at once.
+     */
+    static bool IsReadOnlyMethod(const FString& Method);
+
+    explicit CTSBC_RpcEndpointPool(const FTSBC_BlockchainConfig& BlockchainConfig);
+
+    /**
+     * Sends a JSON-RPC request body to the healthiest URL, failing over to the others if needed.
+     *
+     * @param Body The JSON-RPC request, or batch of requests.
+     * @param bReadOnly True if all methods in the body are read-only, which allows hedging and failing over after
+     *                  any failure. Other requests are only sent to another URL when rate limited, since a second
+     *                  node would otherwise see a transaction that may already be known.
+     * @param OnComplete Called with the first successful response, or the last failed one if all URLs failed.
+     */
+    void Send(const FString& Body, const bool bReadOnly, TFunction<void(const FTSBC_JsonRpcResponse&)> OnComplete);
+
+    /**
+     * @returns The current health of every URL, the config's RpcUrl first.
+     */
+    TArray<FTSBC_RpcEndpointStats> GetStats() const;
+
+private:
+    struct FEndpoint
+    {
+        FString URL;
+
+        /**
+         * Latencies of the recent successful requests in seconds, used as ring buffer.
+         */
+        TArray<double> RecentLatencies;
+
+        int32 NextLatencyIndex = 0;
+
+        double AverageLatency = 0.0;
+
+        double ErrorRate = 0.0;
+
+        int32 NumRequests = 0;
+
+        int32 NumFailures = 0;
+
+        int32 NumConsecutiveFailures = 0;
+
+        /**
+         * Platform time until which the URL is skipped.
+         */
+        double CoolDownUntil = 0.0;
+    };
+
+    /**
+     * State of one request across all URLs it is sent to.
+     */
+    struct FRequest
+    {
+        FString Body;
+
+        TFunction<void(const FTSBC_JsonRpcResponse&)> OnComplete;
+
+        /**
+         * One flag per endpoint.
+         */
+        TBitArray<> bTried;
+
+        TArray<FHttpRequestPtr> InFlight;
+
+        FTSTicker::FDelegateHandle HedgeHandle;
+
+        /**
+         * Response of the last failed attempt, passed on if no URL succeeds.
+         */
+        FTSBC_JsonRpcResponse LastFailure;
+
+        /**
+         * True if the request may be sent to another endpoint after any failure, not only when rate limited.
+         */
+        bool bReadOnly = false;
+
+        /**
+         * True if the request may be sent to a second endpoint while the first one is still busy.
+         */
+        bool bHedge = false;
+
+        bool bCompleted = false;
+    };
+
+    /**
+     * @returns Index of the healthiest endpoint not tried by the request yet, INDEX_NONE if all have been tried.
+     */
+    int32 SelectEndpoint(const FRequest& Request) const;
+
+    /**
+     * Sends the request to one endpoint and, if enabled, schedules the hedged attempt.
+     */
+    void StartAttempt(const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request, const int32 EndpointIndex);
+
+    /**
+     * Sends the request to one endpoint.
+     */
+    void SendAttempt(const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request, const int32 EndpointIndex);
+
+    /**
+     * Sends the request to a second endpoint once the first one takes longer than usual.
+     */
+    void ScheduleHedge(const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request, const int32 EndpointIndex);
+
+    void OnAttemptComplete(
+        const TSharedRef<FRequest, ESPMode::ThreadSafe>& Request,
+        const int32 EndpointIndex,
+        const FHttpRequestPtr HttpRequest,
+        const FHttpResponsePtr HttpResponse,
+        const bool bWasSuccessful,
+        const double Latency);
+
+    /**
+     * Passes the response on and cancels all attempts still in flight.
+     */
+    static void Complete(FRequest& Request, const FTSBC_JsonRpcResponse& Response);
+
+    void RecordSuccess(const int32 EndpointIndex, const double Latency);
+
+    void RecordFailure(const int32 EndpointIndex, const double RetryAfter);
+
+    /**
+     * @returns 95th percentile of the recent latencies of the endpoint, 0 if there are too few.
+     */
+    double GetP95Latency(const FEndpoint& Endpoint) const;
+
+private:
+    TArray<FEndpoint> Endpoints;
+
+    float RequestTimeout;
+
+    bool bHedgeReadOnlyRequests;
+
+    /**
+     * Guards the endpoint statistics, which are updated on the game thread but may be read from any thread.
+     */
+    mutable FCriticalSection EndpointsLock;
+
+    static TMap<FString, TSharedPtr<CTSBC_RpcEndpointPool, ESPMode::ThreadSafe>> Pools;
+
+    static FCriticalSection PoolsLock;
+};
\ No newline at end of file
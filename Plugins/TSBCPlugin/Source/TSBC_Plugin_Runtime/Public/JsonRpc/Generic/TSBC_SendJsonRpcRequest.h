@@ -8,6 +8,7 @@
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Containers/Ticker.h"
 // =============================================================================
 
 class TSBC_PLUGIN_RUNTIME_API CTSBC_SendJsonRpcRequest
@@ -17,6 +18,32 @@ public:
         FTSBC_JsonRpcResponse_Delegate,
         FTSBC_JsonRpcResponse);
 
+    /**
+     * A single method invocation within a batch request.
+     */
+    struct FTSBC_JsonRpcBatchEntry
+    {
+        /**
+         * Delegate to handle the response of this invocation.
+         */
+        FTSBC_JsonRpcResponse_Delegate ResponseDelegate;
+
+        /**
+         * The identifier to correlate the context between two objects.
+         */
+        FString ID;
+
+        /**
+         * The name of the method to be invoked.
+         */
+        FString Method;
+
+        /**
+         * [Optional] Parameters (in JSON format) to be used during the invocation of the method.
+         */
+        FString Params;
+    };
+
     /**
      * Sends a JSON-RPC request to the specified URL in order to invoke a method.
      * Optionally, parameters can be specified (in JSON format) that will be used during the invocation of the method.
@@ -28,6 +55,14 @@ public:
      * @param ID The identifier to correlate the context between two objects.
      * @param Method The name of the method to be invoked.
      * @param Params [Optional] Parameters (in JSON format) to be used during the invocation of the method.
+     *
+     * NOTE: If request coalescing is enabled in the plug-in's user settings, the request is held back for the
+     *       configured window and sent together with all other requests to the same URL as one batch request.
+     *       The response delegate receives the same response it would have received for a single request.
+     *
+     * NOTE: If request deduplication is enabled, a read-only request that is identical to one still in flight,
+     *       i.e. has the same URL, method and params, is not sent again. Its delegate receives the response of the
+     *       request in flight, with the ID replaced by its own.
      */
     static void SendJsonRpcRequest(
         FTSBC_JsonRpcResponse_Delegate ResponseDelegate,
@@ -35,4 +70,83 @@ public:
         const FString& ID,
         const FString& Method,
         const FString& Params);
+
+    /**
+     * Sends several JSON-RPC requests to the specified URL as one batch request, i.e. one HTTP POST with a JSON
+     * array body. The responses are matched to the entries and passed to each entry's own delegate, with the
+     * body containing only that entry's response object. If the batch could not be sent successfully, every
+     * delegate is called with the failed response.
+     *
+     * @param URL JSON-RPC URL the request is sent to.
+     * @param Entries The method invocations. IDs do not need to be unique within the batch.
+     */
+    static void SendJsonRpcBatchRequest(const FString& URL, TArray<FTSBC_JsonRpcBatchEntry> Entries);
+
+    /**
+     * Sends all requests held back for coalescing right away.
+     */
+    static void FlushCoalescedRequests();
+
+    /**
+     * Drops all requests held back for coalescing, and all requests waiting for an identical one in flight,
+     * without calling their delegates.
+     * Called when the module shuts down.
+     */
+    static void Shutdown();
+
+private:
+    /**
+     * A request waiting for the response of an identical request in flight.
+     */
+    struct FTSBC_InFlightWaiter
+    {
+        FTSBC_JsonRpcResponse_Delegate ResponseDelegate;
+
+        FString ID;
+    };
+
+    /**
+     * Registers a request with the identical requests in flight.
+     *
+     * @returns True if an identical request is already in flight, so the request must not be sent.
+     */
+    static bool JoinInFlightRequest(
+        const FString& Key,
+        const FTSBC_JsonRpcResponse_Delegate& ResponseDelegate,
+        const FString& ID);
+
+    /**
+     * Passes the response of a request in flight to all requests waiting for it.
+     */
+    static void CompleteInFlightRequest(const FString& Key, const FTSBC_JsonRpcResponse& Response);
+
+    /**
+     * Adds a request to the batch of its URL and schedules sending it.
+     */
+    static void CoalesceRequest(const FString& URL, FTSBC_JsonRpcBatchEntry&& Entry);
+
+    /**
+     * Ticker callback sending all held back requests.
+     */
+    static bool FlushCoalescedRequestsTick(float DeltaTime);
+
+private:
+    /**
+     * Requests held back for coalescing, per URL.
+     */
+    static TMap<FString, TArray<FTSBC_JsonRpcBatchEntry>> CoalescedRequests;
+
+    /**
+     * Handle of the scheduled flush, invalid if none is scheduled.
+     */
+    static FTSTicker::FDelegateHandle FlushHandle;
+
+    static FCriticalSection CoalescedRequestsLock;
+
+    /**
+     * Requests waiting for a response, per URL, method and params. The first one was sent, the others wait for it.
+     */
+    static TMap<FString, TArray<FTSBC_InFlightWaiter>> InFlightRequests;
+
+    static FCriticalSection InFlightRequestsLock;
 };
\ No newline at end of file
@@ -3,6 +3,28 @@
 #pragma once
 #include "Data/TSBC_Types.h"
 
+/**
+ * Latency measured by CTSBC_BaseConverter::Benchmark().
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_BaseConverterBenchmarkResult
+{
+    int32 NumConversions = 0;
+
+    /**
+     * Size of each converted value in bytes.
+     */
+    int32 NumBytes = 0;
+
+    double Hex2DecMicroseconds = 0.0;
+
+    double Dec2HexMicroseconds = 0.0;
+
+    /**
+     * True if converting every value to decimal and back reproduced it.
+     */
+    bool bRoundTripsMatch = false;
+};
+
 /**
  * Converts unsigned integral numbers of arbitrary length from a source base to
  * a target base.
@@ -16,6 +38,11 @@ public:
     static const TCHAR* CHARSET_BASE_HEX;
 
 private:
+    /**
+     * Arbitrary-precision unsigned integer as little-endian 32 bit limbs. Values up to 512 bits stay on the stack.
+     */
+    using FLimbs = TArray<uint32, TInlineAllocator<16>>;
+
     FString _SourceCharset;
     FString _TargetCharset;
 
@@ -194,23 +221,45 @@ public:
      */
     bool ToDecimal(const FString& Value, uint32& OutDecimal) const;
 
+    /**
+     * Measures the latency of converting random values from hex to decimal and back.
+     * Also available as console command: TSBC.BaseConverterBenchmark [NumConversions], which reports 32, 64 and 256
+     * byte values.
+     *
+     * @param NumConversions Number of values to convert, clamped to 1 to 1000000.
+     * @param NumBytes Size of each value in bytes, clamped to 1 to 4096.
+     * @returns The measured time per conversion.
+     */
+    static FTSBC_BaseConverterBenchmarkResult Benchmark(const int32 NumConversions, const int32 NumBytes);
+
 private:
     /**
-     * Divides Value by TargetNumberBase and returns the quotient and remainder.
+     * Gets the largest power of the number base that fits into a single limb.
+     *
+     * @param NumberBase The number base, e.g. 10 or 16.
+     * @param OutChunkBase The number base raised to the power of the returned number of digits.
+     * @returns Number of digits per chunk, or 0 if the number base is invalid.
+     */
+    static int32 GetChunkSize(const uint32 NumberBase, uint32& OutChunkBase);
+
+    /**
+     * Parses the given string Value into binary limbs using the provided base charset.
+     *
+     * @param SourceBaseCharset The base charset to use for the conversion.
+     * @param Value The value to parse. An empty value is zero.
+     * @param OutLimbs The parsed value.
+     * @returns True, if all characters are part of the base charset.
+     */
+    static bool ParseLimbs(const FString& SourceBaseCharset, const FString& Value, FLimbs& OutLimbs);
+
+    /**
+     * Divides the limbs in place by Divisor and trims leading zero limbs.
      *
-     * @param BaseCharset The base charset to use for OutQuotient and OutRemainder.
-     * @param TargetNumberBase Target number base that will be used as denominator for the division.
-     * @param Value The value that will be used as numerator for the division.
-     * @param OutQuotient The quotient in base digits.
-     * @param OutRemainder The remainder of Value divided by TargetNumberBase.
-     * @returns True, if division was successful.
+     * @param Limbs The value that will be used as numerator for the division. Receives the quotient.
+     * @param Divisor The denominator of the division. Must not be zero.
+     * @returns The remainder of the division.
      */
-    static bool Divide(
-        const FString& BaseCharset,
-        uint32 TargetNumberBase,
-        FString Value,
-        FString& OutQuotient,
-        uint32& OutRemainder);
+    static uint32 DivideLimbs(FLimbs& Limbs, const uint32 Divisor);
 
     /**
      * Tries to convert the given string Value to a decimal value using the
@@ -8,6 +8,36 @@
 
 using uint256_t = uint32[8];
 
+/**
+ * Time per operation of both uint256 arithmetic backends, measured by FTSBC_uint256::Benchmark().
+ */
+struct TSBC_PLUGIN_RUNTIME_API FTSBC_uint256BenchmarkResult
+{
+    int32 NumOperations = 0;
+
+    /**
+     * True if the 64 bit limb backend is compiled in. Otherwise, its timings stay 0.
+     */
+    bool bHas64BitLimbs = false;
+
+    double Multiply32BitNanoseconds = 0.0;
+
+    double Multiply64BitNanoseconds = 0.0;
+
+    double Divide32BitNanoseconds = 0.0;
+
+    double Divide64BitNanoseconds = 0.0;
+
+    double ParseDec32BitNanoseconds = 0.0;
+
+    double ParseDec64BitNanoseconds = 0.0;
+
+    /**
+     * True if both backends produced the same results.
+     */
+    bool bResultsMatch = false;
+};
+
 /**
  * Implements a new uint256 data type; Unsigned Integer with 256 bit precision.
  *
@@ -51,6 +81,8 @@ struct TSBC_PLUGIN_RUNTIME_API FTSBC_uint256
 public:
     static constexpr uint32 NUM_BYTES = sizeof(uint256_t);
     static constexpr uint32 NUM_WORDS = NUM_BYTES / sizeof(uint32);
+    static constexpr int32 MAX_HEX_DIGITS = 2 * NUM_BYTES;
+    static constexpr int32 MAX_DEC_DIGITS = 78;
     static const uint256_t MIN_VALUE;
     static const uint256_t MAX_VALUE;
 
@@ -185,6 +217,35 @@ public:
         const int32 MinFracDigits = 0,
         const int32 MaxFracDigits = 30) const;
 
+    /**
+     * Writes the value in hexadecimal notation (prefixed with "0x") into a caller-supplied buffer without allocating.
+     * The output matches ToHexString.
+     *
+     * @param Buffer Destination for the null-terminated characters. Needs room for up to MAX_HEX_DIGITS + 3 characters.
+     * @param BufferSize Number of characters that fit into the buffer, including the null terminator.
+     * @param bZeroPadded When true, a leading zero may be added to ensure two digit hex codes per byte.
+     * @returns Number of characters written without the null terminator or 0, if the buffer is too small.
+     */
+    int32 ToHexChars(TCHAR* Buffer, const int32 BufferSize, const bool bZeroPadded = true) const;
+
+    /**
+     * Writes the value in decimal notation into a caller-supplied buffer without allocating.
+     *
+     * @param Buffer Destination for the null-terminated digits. Needs room for up to MAX_DEC_DIGITS + 1 characters.
+     * @param BufferSize Number of characters that fit into the buffer, including the null terminator.
+     * @returns Number of digits written without the null terminator or 0, if the buffer is too small.
+     */
+    int32 ToDecChars(TCHAR* Buffer, const int32 BufferSize) const;
+
+    /**
+     * Writes the value as big-endian bytes into a caller-supplied buffer without allocating.
+     *
+     * @param Bytes Destination for NUM_BYTES bytes.
+     * @returns Number of significant bytes, i.e. without leading zero bytes. The minimal big-endian representation
+     *          starts at Bytes + NUM_BYTES minus the returned value. Zero has no significant bytes.
+     */
+    int32 ToBytes(uint8* Bytes) const;
+
     /**
      * @returns The result of the Base argument raised to the power of the Exponent argument.
      */
@@ -231,6 +292,36 @@ public:
      */
     static bool ParseFromDecString(const FString& DecAsString, FTSBC_uint256& DecAsUint256);
 
+    /**
+     * Tries to parse the input characters without allocating. The value can be optionally prefixed with "0x".
+     *
+     * @param Chars The input value in hex representation. Does not need to be null-terminated.
+     * @param NumChars Number of characters to parse.
+     * @param DecAsUint256 The parsed input value as big integer.
+     * @returns True, if the input could be parsed and fits into 256 bits.
+     */
+    static bool ParseFromHexChars(const TCHAR* Chars, int32 NumChars, FTSBC_uint256& DecAsUint256);
+
+    /**
+     * Tries to parse the input characters without allocating.
+     *
+     * @param Chars The input value in decimal representation. Does not need to be null-terminated.
+     * @param NumChars Number of characters to parse.
+     * @param DecAsUint256 The parsed input value as big integer.
+     * @returns True, if the input could be parsed and fits into 256 bits.
+     */
+    static bool ParseFromDecChars(const TCHAR* Chars, int32 NumChars, FTSBC_uint256& DecAsUint256);
+
+    /**
+     * Reads a big-endian byte sequence without allocating. Leading zero bytes are allowed.
+     *
+     * @param Bytes The input bytes in big-endian order.
+     * @param NumBytes Number of bytes to read.
+     * @param DecAsUint256 The parsed input value as big integer.
+     * @returns True, if the value fits into 256 bits.
+     */
+    static bool ParseFromBytes(const uint8* Bytes, int32 NumBytes, FTSBC_uint256& DecAsUint256);
+
     /**
      * Executes a division operation that returns the quotient as well as the remainder.
      *
@@ -245,6 +336,15 @@ public:
         FTSBC_uint256& Quotient,
         FTSBC_uint256& Remainder);
 
+    /**
+     * Measures multiplication, division and decimal parsing on the 32 bit word and the 64 bit limb backend.
+     * Also available as console command: TSBC.Uint256Benchmark [NumOperations]
+     *
+     * @param NumOperations Number of random operands per operation, clamped to 1 to 1000000.
+     * @returns The measured time per operation.
+     */
+    static FTSBC_uint256BenchmarkResult Benchmark(const int32 NumOperations);
+
     /**
      * Sets a new value.
      *
@@ -292,12 +392,32 @@ private:
 
     static void RightShiftOne(uint32* Vli, const uint32 NumWords);
 
+    static uint32 DivideByWord(uint32* Vli, const uint32 Divisor, const uint32 NumWords);
+
+    static bool MultiplyAddWord(uint32* Vli, const uint32 Factor, const uint32 Addend, const uint32 NumWords);
+
+    /**
+     * Parses validated decimal digits with the 32 bit word backend.
+     *
+     * @returns False, if the value does not fit into 256 bits.
+     */
+    static bool ParseDecDigitsWords(uint32* Words, const TCHAR* Chars, const int32 NumChars);
+
+    static void TrimWhitespace(const TCHAR*& Chars, int32& NumChars);
+
+    static bool HasHexPrefix(const TCHAR* Chars, const int32 NumChars);
+
     static bool Add(uint32* Result, const uint32* Left, const uint32* Right, const uint32 NumWords);
 
     static bool Subtract(uint32* Result, const uint32* Left, const uint32* Right, const uint32 NumWords);
 
     static void Multiply(uint32* Result, const uint32* Left, const uint32* Right, const uint32 NumWords);
 
+    /**
+     * Multiplies with the 32 bit word backend, regardless of TSBC_UINT256_USE_64BIT_LIMBS.
+     */
+    static void MultiplyWords(uint32* Result, const uint32* Left, const uint32* Right, const uint32 NumWords);
+
     static bool Divide(
         uint32* Quotient,
         uint32* Remainder,
@@ -305,6 +425,16 @@ private:
         const uint32* Divisor,
         const uint32 NumWords);
 
+    /**
+     * Divides with the 32 bit word backend, regardless of TSBC_UINT256_USE_64BIT_LIMBS.
+     */
+    static bool DivideWords(
+        uint32* Quotient,
+        uint32* Remainder,
+        const uint32* Dividend,
+        const uint32* Divisor,
+        const uint32 NumWords);
+
     static void ModAdd(
         uint32* Result,
         const uint32* Left,
@@ -328,6 +458,11 @@ private:
         const uint32* Mod,
         const uint32 NumWords);
 
+    /**
+     * Multiplies two full width values; the product is reduced modulo MAX_VALUE.
+     */
+    static void MultiplyWrapping(uint32* Result, const uint32* Left, const uint32* Right);
+
     static void ModInverseUpdate(uint32* Uv, const uint32* Mod, const uint32 NumWords);
 
     static void ModInverse(uint32* Result, const uint32* Input, const uint32* Mod, const uint32 NumWords);
@@ -360,7 +495,7 @@ private:
         }
 
         DebugValueHex = ToHexString();
-        CTSBC_BaseConverter::Hex2DecConverter().Convert(DebugValueHex, DebugValueDec);
+        DebugValueDec = ToDecString();
     }
 #endif
 };
\ No newline at end of file
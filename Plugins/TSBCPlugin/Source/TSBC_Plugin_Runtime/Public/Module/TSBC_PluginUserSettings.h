@@ -27,6 +27,110 @@ public:
         Meta=(ToolTip="This setting is only considered while running in-editor."))
     bool bDebugUint256Values;
 
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="Signing Worker Count",
+        Meta=(ClampMin=0, ToolTip="Number of threads signing transactions asynchronously. 0 selects a count based on the available cores. Takes effect after restarting."))
+    int32 SigningWorkerCount;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="Coalesce JSON-RPC Requests",
+        Meta=(ToolTip="Sends JSON-RPC requests issued within the coalescing window as one batch request per URL. The node must support batch requests."))
+    bool bJsonRpcCoalescingEnabled;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="JSON-RPC Coalescing Window",
+        Meta=(ClampMin=0, Units="s", EditCondition="bJsonRpcCoalescingEnabled", ToolTip="Time requests are held back to be batched. 0 sends them on the next tick, i.e. batches the requests issued within the same frame."))
+    float JsonRpcCoalescingWindow;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="JSON-RPC Max Batch Size",
+        Meta=(ClampMin=1, EditCondition="bJsonRpcCoalescingEnabled", ToolTip="A batch is sent right away once it holds this many requests. Nodes usually limit the size of batch requests."))
+    int32 JsonRpcMaxBatchSize;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="Cache JSON-RPC Responses",
+        Meta=(ToolTip="Answers repeated read-only requests like eth_call, eth_getBalance, eth_getTransactionCount and eth_getTransactionReceipt from memory."))
+    bool bJsonRpcCacheEnabled;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="JSON-RPC Cache Size",
+        Meta=(ClampMin=1, Units="MB", EditCondition="bJsonRpcCacheEnabled", ToolTip="Memory budget of the cache. The least recently used responses are removed when it is exceeded."))
+    int32 JsonRpcCacheSizeMB;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="JSON-RPC Cache Max Age",
+        Meta=(ClampMin=0, Units="s", EditCondition="bJsonRpcCacheEnabled", ToolTip="Responses for the latest block are dropped when eth_blockNumber returns a newer block, or after this time at the latest. Should not exceed the block time of the chain."))
+    float JsonRpcCacheMaxAge;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="JSON-RPC Cache Finality Depth",
+        Meta=(ClampMin=0, EditCondition="bJsonRpcCacheEnabled", ToolTip="Number of blocks after which a block is considered final. Responses for final blocks, e.g. receipts and calls at a block number, are kept until evicted."))
+    int32 JsonRpcCacheFinalityDepth;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="Deduplicate JSON-RPC Requests",
+        Meta=(ToolTip="Read-only requests that are identical to one still waiting for its response (same URL, method and params) are not sent again, but receive its response. That response may be older than one of their own would be, and its body is re-serialized with their ID."))
+    bool bJsonRpcDeduplicationEnabled;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="Aggregate eth_call Requests",
+        Meta=(ToolTip="eth_call requests without a from address are held back and sent together as one call of Multicall3's aggregate3 function. Each caller receives its own response with its ID and return data, but bSuccess is then false if the call reverted rather than only if the request failed."))
+    bool bEthCallAggregationEnabled;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="Multicall3 Address",
+        Meta=(ToolTip="Address of the Multicall3 contract, which is the same on most chains."))
+    FString Multicall3Address;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="eth_call Aggregation Window",
+        Meta=(ClampMin=0, Units="s", ToolTip="How long calls are held back to be aggregated. 0 sends them on the next tick."))
+    float EthCallAggregationWindow;
+
+    UPROPERTY(
+        Config,
+        EditAnywhere,
+        Category="Performance",
+        DisplayName="eth_call Aggregation Max Calls",
+        Meta=(ClampMin=1, ToolTip="Calls are sent right away once this many are held back. Nodes limit the gas of a single eth_call."))
+    int32 EthCallAggregationMaxCalls;
+
 public:
     UTSBC_PluginUserSettings();
 